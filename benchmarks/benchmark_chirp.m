@@ -0,0 +1,110 @@
+% DESCRIPTION:
+%     This benchmark script compares the execution time of dtt1D for
+%     transform lengths whose logical length has a large prime factor,
+%     using FFTW directly ('strided' strategy) and Bluestein's algorithm
+%     ('chirp' strategy). The lengths are primes, where the logical length
+%     of the DCT-II is 2N, and smooth lengths close to each prime are
+%     included for reference. Each test array contains a fixed total
+%     number of elements, split into columns of the given length, and the
+%     transform is taken along the first dimension. The plans are created
+%     before timing, and both strategies use a single thread.
+%
+%     The results can be used to check the threshold used by the 'auto'
+%     strategy on a given machine (DTT_CHIRP_MIN_FACTOR in dttChirp.h,
+%     which can be changed at compile time using, e.g.,
+%     -DDTT_CHIRP_MIN_FACTOR=500).
+%
+% ABOUT:
+%     author      - Bradley Treeby
+%     date        - 16 October 2026
+%     last update - 16 October 2026
+%
+% See also dtt1D, dttOptions, benchmark_small
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+%
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+clearvars;
+
+% =========================================================================
+% DEFINE SETTINGS
+% =========================================================================
+
+% DTT type (DCT-II)
+dtt_type = 2;
+
+% transform lengths to test (primes, and smooth lengths for reference)
+transform_lengths = [127, 128, 509, 512, 1021, 1024, 4093, 4096, 16381, 16384, 65521, 65536];
+
+% total number of elements in each test array
+num_elements = 2^22;
+
+% number of repeats for each timing
+num_repeats = 10;
+
+% =========================================================================
+% RUN BENCHMARK
+% =========================================================================
+
+% preallocate output
+fftw_time  = zeros(size(transform_lengths));
+chirp_time = zeros(size(transform_lengths));
+
+for length_ind = 1:length(transform_lengths)
+
+    % create test array
+    N = transform_lengths(length_ind);
+    x = rand(N, floor(num_elements / N));
+
+    % time both strategies, creating and caching the plan first
+    run_time = zeros(1, num_repeats);
+    for strategy = {'strided', 'chirp'}
+        X = dtt1D(x, dtt_type, 1, 'Strategy', strategy{1}, 'Threads', 1); %#ok<NASGU>
+        for rep_ind = 1:num_repeats
+            tic;
+            X = dtt1D(x, dtt_type, 1, 'Strategy', strategy{1}, 'Threads', 1); %#ok<NASGU>
+            run_time(rep_ind) = toc;
+        end
+        if strcmp(strategy{1}, 'strided')
+            fftw_time(length_ind) = median(run_time);
+        else
+            chirp_time(length_ind) = median(run_time);
+        end
+    end
+
+    % check the two strategies give the same result
+    err = max(abs(dtt1D(x, dtt_type, 1, 'Strategy', 'strided') - ...
+        dtt1D(x, dtt_type, 1, 'Strategy', 'chirp')), [], 'all') / max(abs(x), [], 'all');
+    if err > 1e-10
+        warning(['Strategies differ by ' num2str(err) ' for N = ' num2str(N) '.']);
+    end
+
+    clear x X;
+
+end
+
+% =========================================================================
+% DISPLAY RESULTS
+% =========================================================================
+
+% display execution times and speed-up of the chirp path, and the largest
+% prime factor of the logical length
+fprintf('%8s%12s%16s%16s%12s\n', 'N', 'factor', 'fftw', 'chirp', 'speed-up');
+for length_ind = 1:length(transform_lengths)
+    fprintf('%8d%12d%13.2f ms%13.2f ms%11.2fx\n', ...
+        transform_lengths(length_ind), ...
+        max(factor(2 * transform_lengths(length_ind))), ...
+        1e3 * fftw_time(length_ind), ...
+        1e3 * chirp_time(length_ind), ...
+        fftw_time(length_ind) / chirp_time(length_ind));
+end
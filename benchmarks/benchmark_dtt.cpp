@@ -0,0 +1,587 @@
+/**************************************************************************
+ * Native benchmark for the DTT library.
+ *
+ * Sweeps the transforms computed by the C API (see dtt.h) over the number
+ * of transformed dimensions (1D, 2D, and 3D), transform sizes, DTT types,
+ * memory layout, precision, planner rigor, and number of threads, and
+ * writes one row per test in CSV or JSON format.
+ *
+ * The sizes for each dimension are grouped into classes:
+ *
+ *     pow2     powers of two
+ *     prime    primes close to the powers of two
+ *     smooth   composites of 2, 3, and 5
+ *     pow2+1   the sizes where DCT-I is a real DFT of a power of two
+ *              (length 2(N-1))
+ *     pow2-1   the sizes where DST-I is a real DFT of a power of two
+ *              (length 2(N+1))
+ *
+ * Each test array contains approximately the same number of elements, so
+ * 1D and 2D transforms are batched over an extra dimension. The layout is
+ * contiguous when the transformed dimensions are the fastest varying, and
+ * strided when they are the slowest varying (the batch dimension is
+ * first). 3D transforms are only run with the contiguous layout.
+ *
+ * For each test, the first call (which creates and caches the plan) is
+ * timed separately, and the transform is then repeated until the minimum
+ * time has elapsed. The output gives the median and minimum time per
+ * call, the floating point operations counted by fftw_flops for an FFTW
+ * plan of the same transform (add + mul + 2 fma, created after the
+ * library so the planner re-uses its wisdom), the corresponding GFLOP/s,
+ * and the bandwidth assuming each element is read and written once. For
+ * short transforms computed by the kernels in dttSmall.h, the flop count
+ * is still that of the FFTW plan, so the GFLOP/s is nominal.
+ *
+ * Usage:
+ *
+ *     benchmark_dtt [--format csv|json] [--output FILE] [--quick]
+ *                   [--dims 1,2,3] [--kinds 1,...,8] [--classes NAMES]
+ *                   [--layouts contiguous,strided] [--precision double,single]
+ *                   [--planner estimate,measure,patient,exhaustive]
+ *                   [--threads 1,2,...] [--elements N] [--min-time SECONDS]
+ *
+ * By default, every dimension, DTT type, size class, layout, and
+ * precision is tested using the estimate and measure planners, one
+ * thread and the number of hardware threads, 2^20 elements per array,
+ * and a minimum time of 0.1 seconds per test. --quick restricts the
+ * sweep to the smallest size in each class, 2^16 elements, and 0.02
+ * seconds per test.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "fftw3.h"
+#include "dtt.h"
+
+//--------------------------------------------
+// SETTINGS
+//--------------------------------------------
+
+struct Settings {
+    bool json;                          // write JSON instead of CSV
+    std::string output;                 // output file (empty for stdout)
+    std::vector<int> dims;              // number of transformed dimensions
+    std::vector<int> kinds;             // DTT types
+    std::vector<std::string> classes;   // size classes
+    std::vector<std::string> layouts;   // memory layouts
+    std::vector<std::string> precisions;
+    std::vector<std::string> planners;
+    std::vector<int> threads;
+    double elements;                    // approximate number of elements in each array
+    double min_time;                    // minimum time per test in seconds
+    bool quick;                         // only test the smallest size in each class
+};
+
+//split a comma separated list
+static std::vector<std::string> split(const std::string &list){
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')){
+        if (!item.empty()){
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+static std::vector<int> splitInt(const std::string &list){
+    std::vector<std::string> items = split(list);
+    std::vector<int> values;
+    for (size_t i = 0; i < items.size(); i++){
+        values.push_back(std::atoi(items[i].c_str()));
+    }
+    return values;
+}
+
+static void usage(){
+    std::fprintf(stderr,
+        "usage: benchmark_dtt [--format csv|json] [--output FILE] [--quick]\n"
+        "                     [--dims 1,2,3] [--kinds 1,...,8] [--classes pow2,prime,smooth,pow2+1,pow2-1]\n"
+        "                     [--layouts contiguous,strided] [--precision double,single]\n"
+        "                     [--planner estimate,measure,patient,exhaustive]\n"
+        "                     [--threads 1,2,...] [--elements N] [--min-time SECONDS]\n");
+}
+
+//parse the command line, returns false if the arguments are not valid
+static bool getSettings(int argc, char **argv, Settings &settings){
+
+    //defaults
+    int hardware_threads = (int) std::thread::hardware_concurrency();
+    settings.json = false;
+    settings.dims = splitInt("1,2,3");
+    settings.kinds = splitInt("1,2,3,4,5,6,7,8");
+    settings.classes = split("pow2,prime,smooth,pow2+1,pow2-1");
+    settings.layouts = split("contiguous,strided");
+    settings.precisions = split("double,single");
+    settings.planners = split("estimate,measure");
+    settings.threads.push_back(1);
+    if (hardware_threads > 1){
+        settings.threads.push_back(hardware_threads);
+    }
+    settings.elements = 1 << 20;
+    settings.min_time = 0.1;
+    settings.quick = false;
+
+    //options given as name/value pairs
+    bool elements_set = false, min_time_set = false;
+    for (int i = 1; i < argc; i++){
+        std::string name = argv[i];
+        if (name == "--quick"){
+            settings.quick = true;
+            continue;
+        }
+        if (i + 1 >= argc){
+            return false;
+        }
+        std::string value = argv[++i];
+        if (name == "--format"){
+            if (value != "csv" && value != "json") return false;
+            settings.json = (value == "json");
+        } else if (name == "--output"){
+            settings.output = value;
+        } else if (name == "--dims"){
+            settings.dims = splitInt(value);
+        } else if (name == "--kinds"){
+            settings.kinds = splitInt(value);
+        } else if (name == "--classes"){
+            settings.classes = split(value);
+        } else if (name == "--layouts"){
+            settings.layouts = split(value);
+        } else if (name == "--precision"){
+            settings.precisions = split(value);
+        } else if (name == "--planner"){
+            settings.planners = split(value);
+        } else if (name == "--threads"){
+            settings.threads = splitInt(value);
+        } else if (name == "--elements"){
+            settings.elements = std::atof(value.c_str());
+            elements_set = true;
+        } else if (name == "--min-time"){
+            settings.min_time = std::atof(value.c_str());
+            min_time_set = true;
+        } else {
+            return false;
+        }
+    }
+    if (settings.quick){
+        if (!elements_set) settings.elements = 1 << 16;
+        if (!min_time_set) settings.min_time = 0.02;
+    }
+
+    //check the values
+    for (size_t i = 0; i < settings.dims.size(); i++){
+        if (settings.dims[i] < 1 || settings.dims[i] > 3) return false;
+    }
+    for (size_t i = 0; i < settings.kinds.size(); i++){
+        if (settings.kinds[i] < 1 || settings.kinds[i] > 8) return false;
+    }
+    for (size_t i = 0; i < settings.threads.size(); i++){
+        if (settings.threads[i] < 1) return false;
+    }
+    for (size_t i = 0; i < settings.layouts.size(); i++){
+        if (settings.layouts[i] != "contiguous" && settings.layouts[i] != "strided") return false;
+    }
+    for (size_t i = 0; i < settings.precisions.size(); i++){
+        if (settings.precisions[i] != "double" && settings.precisions[i] != "single") return false;
+    }
+    for (size_t i = 0; i < settings.planners.size(); i++){
+        const std::string &p = settings.planners[i];
+        if (p != "estimate" && p != "measure" && p != "patient" && p != "exhaustive") return false;
+    }
+    return settings.elements >= 1 && settings.min_time >= 0;
+
+}
+
+//--------------------------------------------
+// TEST SIZES
+//--------------------------------------------
+
+//transform sizes for each class and number of transformed dimensions
+//(smallest first), returns an empty list if the class is not known
+static std::vector<ptrdiff_t> classSizes(const std::string &name, int numdims){
+    static const ptrdiff_t pow2[3][4]   = {{64, 256, 1024, 16384}, {32, 128, 512, 1024}, {16, 32, 64, 128}};
+    static const ptrdiff_t prime[3][4]  = {{61, 257, 1021, 16381}, {31, 127, 509, 1021}, {17, 31, 67, 127}};
+    static const ptrdiff_t smooth[3][4] = {{60, 240, 1000, 15000}, {30, 120, 480, 1000}, {15, 30, 60, 120}};
+    std::vector<ptrdiff_t> sizes;
+    for (int i = 0; i < 4; i++){
+        ptrdiff_t n = pow2[numdims - 1][i];
+        if (name == "pow2")        sizes.push_back(n);
+        else if (name == "prime")  sizes.push_back(prime[numdims - 1][i]);
+        else if (name == "smooth") sizes.push_back(smooth[numdims - 1][i]);
+        else if (name == "pow2+1") sizes.push_back(n + 1);
+        else if (name == "pow2-1") sizes.push_back(n - 1);
+    }
+    return sizes;
+}
+
+//description of a single test
+struct Test {
+    int numdims;                    // number of transformed dimensions
+    std::string size_class;
+    std::string layout;
+    ptrdiff_t n;                    // size of each transformed dimension
+    ptrdiff_t batch;                // number of transforms
+    std::vector<ptrdiff_t> shape;   // array size, fastest varying first
+    std::vector<int> types;         // DTT type for each dimension (0 if not transformed)
+    int dim;                        // transform dimension for 1D transforms (counting from zero)
+};
+
+//describe the array and the transformed dimensions for a test
+static Test describeTest(int numdims, const std::string &size_class, const std::string &layout,
+        ptrdiff_t n, int dtt_type, double elements){
+    Test t;
+    t.numdims = numdims;
+    t.size_class = size_class;
+    t.layout = layout;
+    t.n = n;
+    ptrdiff_t transform_size = 1;
+    for (int i = 0; i < numdims; i++){
+        transform_size *= n;
+    }
+    t.batch = (numdims < 3) ? std::max<ptrdiff_t>(1, (ptrdiff_t) (elements / transform_size)) : 1;
+    bool strided = (layout == "strided");
+    if (strided && t.batch > 1){
+        t.shape.push_back(t.batch);
+        t.types.push_back(0);
+    }
+    for (int i = 0; i < numdims; i++){
+        t.shape.push_back(n);
+        t.types.push_back(dtt_type);
+    }
+    if (!strided && t.batch > 1){
+        t.shape.push_back(t.batch);
+        t.types.push_back(0);
+    }
+    t.dim = (strided && t.batch > 1) ? 1 : 0;
+    return t;
+}
+
+//--------------------------------------------
+// TIMING
+//--------------------------------------------
+
+//C API for each precision
+static int transform(const Test &t, const double *in, double *out, const dtt_options *opts){
+    if (t.numdims == 1){
+        return dtt_transform_dim(in, out, (int) t.shape.size(), &t.shape[0], t.dim, t.types[t.dim], opts);
+    }
+    return dtt_transform(in, out, (int) t.shape.size(), &t.shape[0], &t.types[0], opts);
+}
+
+static int transform(const Test &t, const float *in, float *out, const dtt_options *opts){
+    if (t.numdims == 1){
+        return dtt_transform_dim_f(in, out, (int) t.shape.size(), &t.shape[0], t.dim, t.types[t.dim], opts);
+    }
+    return dtt_transform_f(in, out, (int) t.shape.size(), &t.shape[0], &t.types[0], opts);
+}
+
+//FFTW interface for each precision, used to count the floating point
+//operations
+struct FlopsDouble {
+    typedef double real;
+    static double flops(int rank, const fftw_iodim64 *dims, int howmany_rank, const fftw_iodim64 *howmany,
+            const fftw_r2r_kind *kinds, unsigned flags, ptrdiff_t numel){
+        double *in = (double *) fftw_malloc(numel * sizeof(double));
+        double *out = (double *) fftw_malloc(numel * sizeof(double));
+        double add = 0, mul = 0, fma = 0;
+        fftw_plan plan = fftw_plan_guru64_r2r(rank, dims, howmany_rank, howmany, in, out, kinds, flags);
+        if (plan != NULL){
+            fftw_flops(plan, &add, &mul, &fma);
+            fftw_destroy_plan(plan);
+        }
+        fftw_free(in);
+        fftw_free(out);
+        return add + mul + 2 * fma;
+    }
+};
+
+struct FlopsSingle {
+    typedef float real;
+    static double flops(int rank, const fftw_iodim64 *dims, int howmany_rank, const fftw_iodim64 *howmany,
+            const fftw_r2r_kind *kinds, unsigned flags, ptrdiff_t numel){
+        float *in = (float *) fftwf_malloc(numel * sizeof(float));
+        float *out = (float *) fftwf_malloc(numel * sizeof(float));
+        double add = 0, mul = 0, fma = 0;
+        fftwf_plan plan = fftwf_plan_guru64_r2r(rank, dims, howmany_rank, howmany, in, out, kinds, flags);
+        if (plan != NULL){
+            fftwf_flops(plan, &add, &mul, &fma);
+            fftwf_destroy_plan(plan);
+        }
+        fftwf_free(in);
+        fftwf_free(out);
+        return add + mul + 2 * fma;
+    }
+};
+
+//FFTW planner flag for each planner name
+static unsigned plannerFlag(const std::string &planner){
+    if (planner == "measure") return FFTW_MEASURE;
+    if (planner == "patient") return FFTW_PATIENT;
+    if (planner == "exhaustive") return FFTW_EXHAUSTIVE;
+    return FFTW_ESTIMATE;
+}
+
+static int plannerOption(const std::string &planner){
+    if (planner == "measure") return DTT_PLANNER_MEASURE;
+    if (planner == "patient") return DTT_PLANNER_PATIENT;
+    if (planner == "exhaustive") return DTT_PLANNER_EXHAUSTIVE;
+    return DTT_PLANNER_ESTIMATE;
+}
+
+//FFTW kind for each DTT type
+static fftw_r2r_kind fftwKind(int dtt_type){
+    static const fftw_r2r_kind kinds[8] = {FFTW_REDFT00, FFTW_REDFT10, FFTW_REDFT01, FFTW_REDFT11,
+        FFTW_RODFT00, FFTW_RODFT10, FFTW_RODFT01, FFTW_RODFT11};
+    return kinds[dtt_type - 1];
+}
+
+//count the floating point operations using an FFTW plan of the same
+//transform, listed from the slowest to the fastest varying dimension as
+//in fftw_plan_r2r
+template <typename Flops>
+static double countFlops(const Test &t, unsigned flags, ptrdiff_t numel){
+    std::vector<fftw_iodim64> dims, howmany;
+    std::vector<fftw_r2r_kind> kinds;
+    ptrdiff_t stride = numel;
+    for (int i = (int) t.shape.size() - 1; i >= 0; i--){
+        stride /= t.shape[i];
+        fftw_iodim64 d;
+        d.n = t.shape[i];
+        d.is = d.os = stride;
+        if (t.types[i] > 0){
+            dims.push_back(d);
+            kinds.push_back(fftwKind(t.types[i]));
+        } else {
+            howmany.push_back(d);
+        }
+    }
+    return Flops::flops((int) dims.size(), &dims[0], (int) howmany.size(), howmany.empty() ? NULL : &howmany[0],
+            &kinds[0], flags, numel);
+}
+
+//results of a single test
+struct Result {
+    double plan_time;       // time of the first call, including planning
+    double median_time;     // median time per call
+    double min_time;        // minimum time per call
+    int repeats;            // number of timed calls
+    double flops;           // floating point operations per call
+    double bytes;           // bytes read and written per call
+    bool success;
+};
+
+static double seconds(std::chrono::steady_clock::time_point start){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//time a single test
+template <typename Flops>
+static Result run(const Test &t, const std::string &planner, int threads, double min_time){
+    typedef typename Flops::real T;
+    Result r;
+    r.success = false;
+    r.plan_time = r.median_time = r.min_time = 0;
+    r.repeats = 0;
+
+    //create test arrays
+    ptrdiff_t numel = 1;
+    for (size_t i = 0; i < t.shape.size(); i++){
+        numel *= t.shape[i];
+    }
+    T *in = (T *) fftw_malloc(numel * sizeof(T));
+    T *out = (T *) fftw_malloc(numel * sizeof(T));
+    if (in == NULL || out == NULL){
+        if (in != NULL) fftw_free(in);
+        if (out != NULL) fftw_free(out);
+        return r;
+    }
+    std::srand(1);
+    for (ptrdiff_t i = 0; i < numel; i++){
+        in[i] = (T) std::rand() / RAND_MAX;
+    }
+
+    dtt_options opts;
+    dtt_default_options(&opts);
+    opts.planner = plannerOption(planner);
+    opts.threads = threads;
+
+    //first call, which creates the plan
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (transform(t, in, out, &opts) != DTT_SUCCESS){
+        fftw_free(in);
+        fftw_free(out);
+        return r;
+    }
+    r.plan_time = seconds(start);
+
+    //repeat until the minimum time has elapsed (at least 3 calls)
+    std::vector<double> times;
+    std::chrono::steady_clock::time_point total = std::chrono::steady_clock::now();
+    while (times.size() < 3 || seconds(total) < min_time){
+        start = std::chrono::steady_clock::now();
+        transform(t, in, out, &opts);
+        times.push_back(seconds(start));
+    }
+    std::sort(times.begin(), times.end());
+    r.repeats = (int) times.size();
+    r.min_time = times.front();
+    r.median_time = times[times.size() / 2];
+    r.flops = countFlops<Flops>(t, plannerFlag(planner), numel);
+    r.bytes = 2.0 * numel * sizeof(T);
+    r.success = true;
+
+    fftw_free(in);
+    fftw_free(out);
+    return r;
+}
+
+//--------------------------------------------
+// OUTPUT
+//--------------------------------------------
+
+static std::string shapeString(const std::vector<ptrdiff_t> &shape){
+    std::stringstream s;
+    for (size_t i = 0; i < shape.size(); i++){
+        s << (i > 0 ? "x" : "") << shape[i];
+    }
+    return s.str();
+}
+
+static void writeHeader(FILE *file, bool json){
+    if (json){
+        std::fprintf(file, "[\n");
+    } else {
+        std::fprintf(file, "dims,layout,class,n,batch,shape,dtt_type,precision,planner,threads,"
+                "plan_ms,median_ms,min_ms,repeats,flops,gflops,bandwidth_gbs\n");
+    }
+}
+
+static void writeResult(FILE *file, bool json, bool first, const Test &t, int dtt_type, const std::string &precision,
+        const std::string &planner, int threads, const Result &r){
+    double gflops = r.flops / r.median_time * 1e-9;
+    double bandwidth = r.bytes / r.median_time * 1e-9;
+    std::string shape = shapeString(t.shape);
+    if (json){
+        std::fprintf(file, "%s  {\"dims\": %d, \"layout\": \"%s\", \"class\": \"%s\", \"n\": %td, \"batch\": %td, "
+                "\"shape\": \"%s\", \"dtt_type\": %d, \"precision\": \"%s\", \"planner\": \"%s\", \"threads\": %d, "
+                "\"plan_ms\": %.6g, \"median_ms\": %.6g, \"min_ms\": %.6g, \"repeats\": %d, \"flops\": %.6g, "
+                "\"gflops\": %.6g, \"bandwidth_gbs\": %.6g}",
+                first ? "" : ",\n", t.numdims, t.layout.c_str(), t.size_class.c_str(), t.n, t.batch,
+                shape.c_str(), dtt_type, precision.c_str(), planner.c_str(), threads,
+                1e3 * r.plan_time, 1e3 * r.median_time, 1e3 * r.min_time, r.repeats, r.flops, gflops, bandwidth);
+    } else {
+        std::fprintf(file, "%d,%s,%s,%td,%td,%s,%d,%s,%s,%d,%.6g,%.6g,%.6g,%d,%.6g,%.6g,%.6g\n",
+                t.numdims, t.layout.c_str(), t.size_class.c_str(), t.n, t.batch,
+                shape.c_str(), dtt_type, precision.c_str(), planner.c_str(), threads,
+                1e3 * r.plan_time, 1e3 * r.median_time, 1e3 * r.min_time, r.repeats, r.flops, gflops, bandwidth);
+    }
+    std::fflush(file);
+}
+
+static void writeFooter(FILE *file, bool json){
+    if (json){
+        std::fprintf(file, "\n]\n");
+    }
+}
+
+//--------------------------------------------
+// MAIN
+//--------------------------------------------
+
+int main(int argc, char **argv){
+
+    Settings settings;
+    if (!getSettings(argc, argv, settings)){
+        usage();
+        return 1;
+    }
+
+    FILE *file = stdout;
+    if (!settings.output.empty()){
+        file = std::fopen(settings.output.c_str(), "w");
+        if (file == NULL){
+            std::fprintf(stderr, "Could not open %s for writing.\n", settings.output.c_str());
+            return 1;
+        }
+    }
+
+    //run each test, where the plans for each test are released before
+    //the next so the cache doesn't grow over the sweep
+    writeHeader(file, settings.json);
+    bool first = true;
+    for (size_t d = 0; d < settings.dims.size(); d++){
+        int numdims = settings.dims[d];
+        for (size_t c = 0; c < settings.classes.size(); c++){
+            std::vector<ptrdiff_t> sizes = classSizes(settings.classes[c], numdims);
+            if (sizes.empty()){
+                std::fprintf(stderr, "Unknown size class %s.\n", settings.classes[c].c_str());
+                continue;
+            }
+            if (settings.quick){
+                sizes.resize(1);
+            }
+            for (size_t s = 0; s < sizes.size(); s++){
+                for (size_t l = 0; l < settings.layouts.size(); l++){
+                    if (numdims == 3 && settings.layouts[l] == "strided"){
+                        continue;
+                    }
+                    for (size_t k = 0; k < settings.kinds.size(); k++){
+                        Test t = describeTest(numdims, settings.classes[c], settings.layouts[l], sizes[s], settings.kinds[k], settings.elements);
+                        for (size_t p = 0; p < settings.precisions.size(); p++){
+                            for (size_t pl = 0; pl < settings.planners.size(); pl++){
+                                for (size_t th = 0; th < settings.threads.size(); th++){
+                                    const std::string &precision = settings.precisions[p];
+                                    const std::string &planner = settings.planners[pl];
+                                    int threads = settings.threads[th];
+                                    Result r = (precision == "single")
+                                        ? run<FlopsSingle>(t, planner, threads, settings.min_time)
+                                        : run<FlopsDouble>(t, planner, threads, settings.min_time);
+                                    dtt_cleanup();
+                                    if (!r.success){
+                                        std::fprintf(stderr, "Transform of %s failed.\n", shapeString(t.shape).c_str());
+                                        continue;
+                                    }
+                                    writeResult(file, settings.json, first, t, settings.kinds[k], precision, planner, threads, r);
+                                    first = false;
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    writeFooter(file, settings.json);
+
+    if (file != stdout){
+        std::fclose(file);
+    }
+    return 0;
+
+}
@@ -0,0 +1,109 @@
+% DESCRIPTION:
+%     This benchmark script compares the execution time of dtt1D for
+%     tall-skinny arrays (a short transform length and a large number of
+%     columns) using FFTW directly ('strided' strategy) and a single matrix
+%     product with the transform matrix ('gemm' strategy). Each test array
+%     contains a fixed total number of elements, split into columns of the
+%     given length, and the transform is taken along the first dimension.
+%     The plans are created before timing, and both strategies use the
+%     same number of threads. The throughput of the matrix product is
+%     also given in GFLOP/s (each transform of length N costs 2N^2
+%     flops).
+%
+%     The 'auto' strategy uses the matrix product for lengths from 33 to
+%     56 with at least 4096 columns. The results can be used to find the
+%     largest length where it is faster than FFTW on a given machine,
+%     which can then be set at compile time using, e.g.,
+%     -DDTT_GEMM_MAX_N=48 (see dttGemm.h).
+%
+% ABOUT:
+%     author      - Bradley Treeby
+%     date        - 16 October 2026
+%     last update - 16 October 2026
+%
+% See also dtt1D, dttOptions, benchmark_small
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+%
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+clearvars;
+
+% =========================================================================
+% DEFINE SETTINGS
+% =========================================================================
+
+% DTT type (DCT-II)
+dtt_type = 2;
+
+% transform lengths to test
+transform_lengths = [4, 8, 16, 24, 32, 48, 64, 96, 128];
+
+% total number of elements in each test array
+num_elements = 2^24;
+
+% number of threads used by both strategies
+num_threads = maxNumCompThreads;
+
+% number of repeats for each timing
+num_repeats = 10;
+
+% =========================================================================
+% RUN BENCHMARK
+% =========================================================================
+
+% preallocate output
+fftw_time = zeros(size(transform_lengths));
+gemm_time = zeros(size(transform_lengths));
+
+for length_ind = 1:length(transform_lengths)
+
+    % create test array
+    N = transform_lengths(length_ind);
+    x = rand(N, floor(num_elements / N));
+
+    % time both strategies, creating and caching the plan first
+    run_time = zeros(1, num_repeats);
+    for strategy = {'strided', 'gemm'}
+        X = dtt1D(x, dtt_type, 1, 'Strategy', strategy{1}, 'Threads', num_threads); %#ok<NASGU>
+        for rep_ind = 1:num_repeats
+            tic;
+            X = dtt1D(x, dtt_type, 1, 'Strategy', strategy{1}, 'Threads', num_threads); %#ok<NASGU>
+            run_time(rep_ind) = toc;
+        end
+        if strcmp(strategy{1}, 'strided')
+            fftw_time(length_ind) = median(run_time);
+        else
+            gemm_time(length_ind) = median(run_time);
+        end
+    end
+
+    clear x X;
+
+end
+
+% =========================================================================
+% DISPLAY RESULTS
+% =========================================================================
+
+% display execution times, speed-up, and throughput of the matrix product
+fprintf('Using %d threads\n', num_threads);
+fprintf('%8s%16s%16s%12s%12s\n', 'N', 'fftw', 'gemm', 'speed-up', 'GFLOP/s');
+for length_ind = 1:length(transform_lengths)
+    N = transform_lengths(length_ind);
+    fprintf('%8d%13.2f ms%13.2f ms%11.2fx%12.2f\n', ...
+        N, ...
+        1e3 * fftw_time(length_ind), ...
+        1e3 * gemm_time(length_ind), ...
+        fftw_time(length_ind) / gemm_time(length_ind), ...
+        2 * N * N * floor(num_elements / N) / gemm_time(length_ind) / 1e9);
+end
@@ -0,0 +1,369 @@
+/**************************************************************************
+ * MPI scaling benchmark for the DTT library.
+ *
+ * Times the distributed 3D transform computed by dtt_mpi_transform (see
+ * dttMpi.h) for one array size, and writes one CSV row from rank 0 with
+ * the number of ranks and threads, the time of the first call (which
+ * creates and caches the plans), the median and minimum time per call,
+ * and the throughput in elements per second. The benchmark is run for
+ * each number of ranks by benchmarks/run_mpi_scaling.sh, which also
+ * computes the speed-up and parallel efficiency relative to one rank.
+ *
+ * With --check, the distributed array is gathered on rank 0 and compared
+ * with the transform of the whole array computed by dtt_transform, and
+ * the maximum error relative to the largest value is written in the
+ * error column (otherwise the column is empty). This is only practical
+ * for arrays that fit in the memory of one rank.
+ *
+ * Usage:
+ *
+ *     mpirun -np 4 benchmark_mpi [--dims NX,NY,NZ] [--types TX,TY,TZ]
+ *                                [--precision double|single] [--threads N]
+ *                                [--min-time SECONDS] [--output FILE]
+ *                                [--check] [--no-header]
+ *
+ * By default, a 256^3 array is transformed using the DCT-II along each
+ * dimension in double precision, using the default number of threads
+ * (the hardware threads divided between the ranks on each node), and a
+ * minimum time of 1 second.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <mpi.h>
+#include "dtt.h"
+#include "dttMpi.h"
+
+//--------------------------------------------
+// SETTINGS
+//--------------------------------------------
+
+struct Settings {
+    ptrdiff_t dims[3];          // array size
+    int types[3];               // DTT type for each dimension (0 if not transformed)
+    bool single;                // single precision
+    int threads;                // threads per rank (0 for the default)
+    double min_time;            // minimum time in seconds
+    std::string output;         // output file (empty for stdout)
+    bool check;                 // compare with the serial transform
+    bool header;                // write the CSV header
+};
+
+//split a comma separated list of three integers
+static bool splitThree(const std::string &list, long long values[3]){
+    std::stringstream stream(list);
+    std::string item;
+    int count = 0;
+    while (std::getline(stream, item, ',')){
+        if (count == 3){
+            return false;
+        }
+        values[count++] = std::atoll(item.c_str());
+    }
+    return count == 3;
+}
+
+static void usage(){
+    std::fprintf(stderr,
+        "usage: mpirun -np RANKS benchmark_mpi [--dims NX,NY,NZ] [--types TX,TY,TZ]\n"
+        "                                      [--precision double|single] [--threads N]\n"
+        "                                      [--min-time SECONDS] [--output FILE]\n"
+        "                                      [--check] [--no-header]\n");
+}
+
+//parse the command line, returns false if the arguments are not valid
+static bool getSettings(int argc, char **argv, Settings &settings){
+
+    //defaults
+    for (int i = 0; i < 3; i++){
+        settings.dims[i] = 256;
+        settings.types[i] = 2;
+    }
+    settings.single = false;
+    settings.threads = 0;
+    settings.min_time = 1;
+    settings.check = false;
+    settings.header = true;
+
+    //options given as name/value pairs
+    for (int i = 1; i < argc; i++){
+        std::string name = argv[i];
+        if (name == "--check"){
+            settings.check = true;
+            continue;
+        } else if (name == "--no-header"){
+            settings.header = false;
+            continue;
+        }
+        if (i + 1 >= argc){
+            return false;
+        }
+        std::string value = argv[++i];
+        long long values[3];
+        if (name == "--dims"){
+            if (!splitThree(value, values)) return false;
+            for (int j = 0; j < 3; j++){
+                if (values[j] < 1) return false;
+                settings.dims[j] = (ptrdiff_t) values[j];
+            }
+        } else if (name == "--types"){
+            if (!splitThree(value, values)) return false;
+            for (int j = 0; j < 3; j++){
+                if (values[j] < 0 || values[j] > 8) return false;
+                settings.types[j] = (int) values[j];
+            }
+        } else if (name == "--precision"){
+            if (value != "double" && value != "single") return false;
+            settings.single = (value == "single");
+        } else if (name == "--threads"){
+            settings.threads = std::atoi(value.c_str());
+            if (settings.threads < 0) return false;
+        } else if (name == "--min-time"){
+            settings.min_time = std::atof(value.c_str());
+            if (settings.min_time < 0) return false;
+        } else if (name == "--output"){
+            settings.output = value;
+        } else {
+            return false;
+        }
+    }
+    return true;
+
+}
+
+//--------------------------------------------
+// TIMING
+//--------------------------------------------
+
+//C API for each precision
+static int transformMpi(const double *in, double *out, const Settings &s, const dtt_options *opts){
+    return dtt_mpi_transform(in, out, s.dims, s.types, opts, MPI_COMM_WORLD);
+}
+
+static int transformMpi(const float *in, float *out, const Settings &s, const dtt_options *opts){
+    return dtt_mpi_transform_f(in, out, s.dims, s.types, opts, MPI_COMM_WORLD);
+}
+
+static int transformSerial(const double *in, double *out, const Settings &s){
+    return dtt_transform(in, out, 3, s.dims, s.types, NULL);
+}
+
+static int transformSerial(const float *in, float *out, const Settings &s){
+    return dtt_transform_f(in, out, 3, s.dims, s.types, NULL);
+}
+
+static MPI_Datatype mpiType(double){
+    return MPI_DOUBLE;
+}
+
+static MPI_Datatype mpiType(float){
+    return MPI_FLOAT;
+}
+
+//test value for each element of the global array, so the array can be
+//recreated on rank 0 for the check
+template <typename T>
+static T testValue(ptrdiff_t index){
+    return (T) ((index * 7919) % 1000) / 1000 - (T) 0.5;
+}
+
+//results of the benchmark
+struct Result {
+    double plan_time;       // time of the first call, including planning
+    double median_time;     // median time per call
+    double min_time;        // minimum time per call
+    int repeats;            // number of timed calls
+    double error;           // maximum relative error (negative if not checked)
+    bool success;
+};
+
+//time a single call on every rank, where the time of the call is the
+//time of the slowest rank
+template <typename T>
+static double timeCall(const T *in, T *out, const Settings &s, const dtt_options *opts, bool &success){
+    MPI_Barrier(MPI_COMM_WORLD);
+    double start = MPI_Wtime();
+    success = (transformMpi(in, out, s, opts) == DTT_SUCCESS);
+    double local = MPI_Wtime() - start, time;
+    MPI_Allreduce(&local, &time, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    return time;
+}
+
+//compare the distributed result with the serial transform on rank 0
+template <typename T>
+static double checkResult(const T *out, const Settings &s, ptrdiff_t local_numel){
+    int size, rank;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    ptrdiff_t plane = s.dims[0] * s.dims[1], numel = plane * s.dims[2];
+
+    //gather the slabs in order, counted in xy-planes
+    int local_planes = (int) (local_numel / plane);
+    std::vector<int> counts(size), offsets(size);
+    MPI_Gather(&local_planes, 1, MPI_INT, &counts[0], 1, MPI_INT, 0, MPI_COMM_WORLD);
+    MPI_Datatype plane_type;
+    MPI_Type_contiguous((int) plane, mpiType(T()), &plane_type);
+    MPI_Type_commit(&plane_type);
+    std::vector<T> result(rank == 0 ? numel : 0);
+    for (int r = 1; r < size; r++){
+        offsets[r] = offsets[r - 1] + counts[r - 1];
+    }
+    MPI_Gatherv(const_cast<T *>(out), local_planes, plane_type, rank == 0 ? &result[0] : NULL,
+            &counts[0], &offsets[0], plane_type, 0, MPI_COMM_WORLD);
+    MPI_Type_free(&plane_type);
+    if (rank != 0){
+        return 0;
+    }
+
+    //serial transform of the whole array
+    std::vector<T> x(numel), expected(numel);
+    for (ptrdiff_t i = 0; i < numel; i++){
+        x[i] = testValue<T>(i);
+    }
+    if (transformSerial(&x[0], &expected[0], s) != DTT_SUCCESS){
+        return INFINITY;
+    }
+    double error = 0, scale = 0;
+    for (ptrdiff_t i = 0; i < numel; i++){
+        error = std::max(error, std::fabs((double) result[i] - expected[i]));
+        scale = std::max(scale, std::fabs((double) expected[i]));
+    }
+    return scale > 0 ? error / scale : error;
+}
+
+//run the benchmark
+template <typename T>
+static Result run(const Settings &s){
+    Result r;
+    r.success = false;
+    r.plan_time = r.median_time = r.min_time = 0;
+    r.repeats = 0;
+    r.error = -1;
+
+    //create the local slab
+    ptrdiff_t local_nz, local_z_start;
+    if (dtt_mpi_local_size(s.dims, MPI_COMM_WORLD, &local_nz, &local_z_start) != DTT_SUCCESS){
+        return r;
+    }
+    ptrdiff_t plane = s.dims[0] * s.dims[1], local_numel = plane * local_nz;
+    std::vector<T> in(local_numel), out(local_numel);
+    for (ptrdiff_t i = 0; i < local_numel; i++){
+        in[i] = testValue<T>(local_z_start * plane + i);
+    }
+    T *in_ptr = in.empty() ? NULL : &in[0];
+    T *out_ptr = out.empty() ? NULL : &out[0];
+
+    dtt_options opts;
+    dtt_default_options(&opts);
+    opts.threads = s.threads;
+
+    //first call, which creates the plans
+    bool success;
+    r.plan_time = timeCall(in_ptr, out_ptr, s, &opts, success);
+    if (!success){
+        return r;
+    }
+    if (s.check){
+        r.error = checkResult(out_ptr, s, local_numel);
+    }
+
+    //repeat until the minimum time has elapsed (at least 3 calls), where
+    //every rank sees the same times so stops after the same call
+    std::vector<double> times;
+    double total = 0;
+    while (times.size() < 3 || total < s.min_time){
+        times.push_back(timeCall(in_ptr, out_ptr, s, &opts, success));
+        total += times.back();
+    }
+    std::sort(times.begin(), times.end());
+    r.repeats = (int) times.size();
+    r.min_time = times.front();
+    r.median_time = times[times.size() / 2];
+    r.success = true;
+    return r;
+}
+
+//--------------------------------------------
+// MAIN
+//--------------------------------------------
+
+int main(int argc, char **argv){
+
+    MPI_Init(&argc, &argv);
+    int size, rank;
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+    Settings settings;
+    if (!getSettings(argc, argv, settings)){
+        if (rank == 0){
+            usage();
+        }
+        MPI_Finalize();
+        return 1;
+    }
+
+    Result r = settings.single ? run<float>(settings) : run<double>(settings);
+    dtt_cleanup();
+
+    //write the result from rank 0
+    int status = 0;
+    if (rank == 0){
+        FILE *file = stdout;
+        if (!settings.output.empty()){
+            file = std::fopen(settings.output.c_str(), "a");
+        }
+        if (file == NULL){
+            std::fprintf(stderr, "Could not open %s for writing.\n", settings.output.c_str());
+            status = 1;
+        } else if (!r.success){
+            std::fprintf(stderr, "Transform of %tdx%tdx%td failed.\n", settings.dims[0], settings.dims[1], settings.dims[2]);
+            status = 1;
+        } else {
+            if (settings.header){
+                std::fprintf(file, "ranks,threads,shape,dtt_types,precision,plan_ms,median_ms,min_ms,repeats,"
+                        "melements_per_s,error\n");
+            }
+            double numel = (double) settings.dims[0] * settings.dims[1] * settings.dims[2];
+            std::fprintf(file, "%d,%d,%tdx%tdx%td,%d%d%d,%s,%.6g,%.6g,%.6g,%d,%.6g,",
+                    size, settings.threads, settings.dims[0], settings.dims[1], settings.dims[2],
+                    settings.types[0], settings.types[1], settings.types[2], settings.single ? "single" : "double",
+                    1e3 * r.plan_time, 1e3 * r.median_time, 1e3 * r.min_time, r.repeats, numel / r.median_time * 1e-6);
+            if (r.error >= 0){
+                std::fprintf(file, "%.3g", r.error);
+            }
+            std::fprintf(file, "\n");
+        }
+        if (file != NULL && file != stdout){
+            std::fclose(file);
+        }
+    }
+
+    MPI_Finalize();
+    return status;
+
+}
@@ -0,0 +1,123 @@
+% DESCRIPTION:
+%     This benchmark script measures the cost of allocating the output
+%     array in dtt3D. The output is allocated without being zero-filled,
+%     so the only memory traffic is the transform itself. For each array
+%     size, the script times:
+%
+%         1. dtt3D, which allocates an uninitialised output array
+%         2. dtt3D with 'InPlace' set to true, which doesn't allocate an
+%            output array (lower bound)
+%         3. allocating and filling an array of the same size using ones,
+%            which is equivalent to the extra write pass over memory that
+%            was previously needed to zero-fill the output (zeros isn't
+%            used, as MATLAB can allocate zeroed memory lazily)
+%
+%     The saving from skipping the zero-fill is given as the time for (3)
+%     relative to the total time for (1) and (3). The plan is created
+%     before timing, so only the execution of the cached plan is
+%     measured.
+%
+%     Note, the largest size requires approximately 2 GB of memory for
+%     the input and output arrays.
+%
+% ABOUT:
+%     author      - Bradley Treeby
+%     date        - 16 October 2026
+%     last update - 16 October 2026
+%
+% See also dtt3D, benchmark_threads
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+%
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+clearvars;
+
+% =========================================================================
+% DEFINE SETTINGS
+% =========================================================================
+
+% DTT type (DCT-II)
+dtt_type = 2;
+
+% 3D array sizes to test
+test_sizes = [128, 256, 512];
+
+% number of repeats for each timing
+num_repeats = 5;
+
+% =========================================================================
+% RUN BENCHMARK
+% =========================================================================
+
+% preallocate output
+alloc_time    = zeros(size(test_sizes));
+in_place_time = zeros(size(test_sizes));
+fill_time     = zeros(size(test_sizes));
+
+for size_ind = 1:length(test_sizes)
+
+    % create test array
+    N = test_sizes(size_ind);
+    x = rand(N, N, N);
+
+    % create and cache the plans for both cases
+    X = dtt3D(x, dtt_type); %#ok<NASGU>
+    dtt3D(x, dtt_type, 'InPlace', true);
+    clear X;
+
+    % time execution with an uninitialised output
+    run_time = zeros(1, num_repeats);
+    for rep_ind = 1:num_repeats
+        tic;
+        X = dtt3D(x, dtt_type); %#ok<NASGU>
+        run_time(rep_ind) = toc;
+        clear X;
+    end
+    alloc_time(size_ind) = median(run_time);
+
+    % time execution in place (the values in x are overwritten, which
+    % doesn't change the execution time)
+    for rep_ind = 1:num_repeats
+        tic;
+        dtt3D(x, dtt_type, 'InPlace', true);
+        run_time(rep_ind) = toc;
+    end
+    in_place_time(size_ind) = median(run_time);
+
+    % time filling an array of the same size
+    for rep_ind = 1:num_repeats
+        tic;
+        X = ones(N, N, N); %#ok<NASGU>
+        run_time(rep_ind) = toc;
+        clear X;
+    end
+    fill_time(size_ind) = median(run_time);
+
+    clear x;
+
+end
+
+% =========================================================================
+% DISPLAY RESULTS
+% =========================================================================
+
+% display execution times and the saving from skipping the zero-fill
+fprintf('%10s%16s%16s%16s%12s\n', 'size', 'uninit output', 'in place', 'zero-fill', 'saving');
+for size_ind = 1:length(test_sizes)
+    fprintf('%10s%13.2f ms%13.2f ms%13.2f ms%11.1f%%\n', ...
+        sprintf('%d^3', test_sizes(size_ind)), ...
+        1e3 * alloc_time(size_ind), ...
+        1e3 * in_place_time(size_ind), ...
+        1e3 * fill_time(size_ind), ...
+        100 * fill_time(size_ind) / (alloc_time(size_ind) + fill_time(size_ind)));
+end
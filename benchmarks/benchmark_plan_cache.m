@@ -0,0 +1,112 @@
+% DESCRIPTION:
+%     This benchmark script measures the per-step cost of the four dtt1D
+%     calls used in each time step of example_wave_eq_pstd_2D_neumann,
+%     and compares the cost of the first call for each array size and
+%     transform type (which creates and caches the FFTW plan) with the
+%     cost of subsequent calls (which re-use the cached plan).
+%
+%     The cost of re-loading the mex file after it is cleared is measured
+%     separately using a 2-point transform (for which planning is
+%     negligible), and subtracted from the cost of the first call to give
+%     an estimate of the planning cost that is removed from each step.
+%       
+% ABOUT:
+%     author      - Bradley Treeby
+%     date        - 16 October 2026
+%     last update - 16 October 2026
+%
+% See also dtt1D, example_wave_eq_pstd_2D_neumann
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+% 
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+% 
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+clearvars;
+
+% =========================================================================
+% DEFINE LITERALS
+% =========================================================================
+
+% transform types used by dtt1D
+DCT1 = 1;    % WSWS
+DST2 = 6;    % HAHA
+DST3 = 7;    % WAWS
+
+% grid sizes to test
+Nx_list = [64, 128, 256, 512, 1024];
+
+% number of time steps used to compute the cached cost
+Nt = 100;
+
+% number of repeats used to compute the cost of the first call
+num_repeats = 5;
+
+% =========================================================================
+% RUN BENCHMARK
+% =========================================================================
+
+% preallocate outputs
+reload_time = zeros(1, num_repeats);
+first_step  = zeros(length(Nx_list), num_repeats);
+cached_step = zeros(length(Nx_list), 1);
+
+% cost of re-loading the mex file after it is cleared
+for rep_ind = 1:num_repeats
+    clear dtt1D;
+    tic;
+    dtt1D([1; 2], DCT1, 1);
+    reload_time(rep_ind) = toc;
+end
+
+for size_ind = 1:length(Nx_list)
+    
+    % create test arrays with the same sizes as the 2D Neumann example
+    Nx = Nx_list(size_ind);
+    p  = rand(Nx, Nx);
+    ux = rand(Nx, Nx);
+    
+    % first step after the mex file is cleared, which creates the plans
+    for rep_ind = 1:num_repeats
+        clear dtt1D;
+        tic;
+        dtt1D(p, DCT1, 1);
+        dtt1D(p(2:end, :), DST3, 1);
+        dtt1D(ux, DST2, 1);
+        dtt1D(p, DCT1, 1);
+        first_step(size_ind, rep_ind) = toc;
+    end
+    
+    % subsequent steps which re-use the cached plans
+    tic;
+    for time_ind = 1:Nt
+        dtt1D(p, DCT1, 1);
+        dtt1D(p(2:end, :), DST3, 1);
+        dtt1D(ux, DST2, 1);
+        dtt1D(p, DCT1, 1);
+    end
+    cached_step(size_ind) = toc / Nt;
+    
+end
+
+% =========================================================================
+% DISPLAY RESULTS
+% =========================================================================
+
+% estimate the planning cost removed from each step
+planning_cost = median(first_step, 2) - median(reload_time) - cached_step;
+
+disp('    Nx    first step [ms]    cached step [ms]    planning [ms]');
+for size_ind = 1:length(Nx_list)
+    fprintf('%6d    %15.3f    %16.3f    %13.3f\n', Nx_list(size_ind), ...
+        1e3 * median(first_step(size_ind, :)), 1e3 * cached_step(size_ind), ...
+        1e3 * planning_cost(size_ind));
+end
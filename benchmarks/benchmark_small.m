@@ -0,0 +1,98 @@
+% DESCRIPTION:
+%     This benchmark script compares the execution time of dtt1D for
+%     batches of short transforms using FFTW ('strided' strategy) and the
+%     kernels specialised for each transform length ('small' strategy).
+%     Each test array contains a fixed total number of elements, split
+%     into columns of the given length, and the transform is taken along
+%     the first dimension. The plans are created before timing, and both
+%     strategies use a single thread.
+%
+%     The results can be used to check the threshold used by the 'auto'
+%     strategy on a given machine (DTT_SMALL_MAX_N in dttSmall.h, which
+%     can be changed at compile time using, e.g., -DDTT_SMALL_MAX_N=16).
+%
+% ABOUT:
+%     author      - Bradley Treeby
+%     date        - 16 October 2026
+%     last update - 16 October 2026
+%
+% See also dtt1D, dttOptions, benchmark_transpose
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+%
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+clearvars;
+
+% =========================================================================
+% DEFINE SETTINGS
+% =========================================================================
+
+% DTT type (DCT-II)
+dtt_type = 2;
+
+% transform lengths to test
+transform_lengths = [4, 8, 9, 16, 24, 32, 48, 64];
+
+% total number of elements in each test array
+num_elements = 2^20;
+
+% number of repeats for each timing
+num_repeats = 10;
+
+% =========================================================================
+% RUN BENCHMARK
+% =========================================================================
+
+% preallocate output
+fftw_time  = zeros(size(transform_lengths));
+small_time = zeros(size(transform_lengths));
+
+for length_ind = 1:length(transform_lengths)
+
+    % create test array
+    N = transform_lengths(length_ind);
+    x = rand(N, floor(num_elements / N));
+
+    % time both strategies, creating and caching the plan first
+    run_time = zeros(1, num_repeats);
+    for strategy = {'strided', 'small'}
+        X = dtt1D(x, dtt_type, 1, 'Strategy', strategy{1}, 'Threads', 1); %#ok<NASGU>
+        for rep_ind = 1:num_repeats
+            tic;
+            X = dtt1D(x, dtt_type, 1, 'Strategy', strategy{1}, 'Threads', 1); %#ok<NASGU>
+            run_time(rep_ind) = toc;
+        end
+        if strcmp(strategy{1}, 'strided')
+            fftw_time(length_ind) = median(run_time);
+        else
+            small_time(length_ind) = median(run_time);
+        end
+    end
+
+    clear x X;
+
+end
+
+% =========================================================================
+% DISPLAY RESULTS
+% =========================================================================
+
+% display execution times and speed-up of the small kernels
+fprintf('%8s%16s%16s%12s\n', 'N', 'fftw', 'small', 'speed-up');
+for length_ind = 1:length(transform_lengths)
+    fprintf('%8d%13.2f ms%13.2f ms%11.2fx\n', ...
+        transform_lengths(length_ind), ...
+        1e3 * fftw_time(length_ind), ...
+        1e3 * small_time(length_ind), ...
+        fftw_time(length_ind) / small_time(length_ind));
+end
@@ -0,0 +1,114 @@
+% DESCRIPTION:
+%     This benchmark script measures the scaling of dtt2D and dtt3D with
+%     the number of threads used by FFTW, from a single thread up to
+%     maxNumCompThreads. For each array size, the plan is created before
+%     timing (using the same number of threads), so only the execution of
+%     the cached plan is measured.
+%
+%     Note, the largest 3D size requires approximately 2 GB of memory for
+%     the input and output arrays.
+%       
+% ABOUT:
+%     author      - Bradley Treeby
+%     date        - 16 October 2026
+%     last update - 16 October 2026
+%
+% See also dtt2D, dtt3D, dttOptions
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+% 
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+% 
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+clearvars;
+
+% =========================================================================
+% DEFINE SETTINGS
+% =========================================================================
+
+% DTT type (DCT-II)
+dtt_type = 2;
+
+% 2D and 3D array sizes to test
+sizes_2D = [1024, 2048, 4096];
+sizes_3D = [128, 256, 512];
+
+% number of threads to test (powers of two up to maxNumCompThreads)
+max_threads = maxNumCompThreads;
+thread_list = unique([2.^(0:floor(log2(max_threads))), max_threads]);
+
+% number of repeats for each timing
+num_repeats = 5;
+
+% =========================================================================
+% RUN BENCHMARK
+% =========================================================================
+
+% combine the test cases
+test_sizes = [sizes_2D, sizes_3D];
+test_dims  = [2 * ones(size(sizes_2D)), 3 * ones(size(sizes_3D))];
+
+% preallocate output
+exec_time = zeros(length(test_sizes), length(thread_list));
+
+for size_ind = 1:length(test_sizes)
+    
+    % create test array
+    N = test_sizes(size_ind);
+    if test_dims(size_ind) == 2
+        x = rand(N, N);
+        dtt = @(x, threads) dtt2D(x, dtt_type, 'Threads', threads);
+    else
+        x = rand(N, N, N);
+        dtt = @(x, threads) dtt3D(x, dtt_type, 'Threads', threads);
+    end
+    
+    for thread_ind = 1:length(thread_list)
+        
+        % create and cache the plan
+        threads = thread_list(thread_ind);
+        X = dtt(x, threads); %#ok<NASGU>
+        
+        % time execution
+        run_time = zeros(1, num_repeats);
+        for rep_ind = 1:num_repeats
+            tic;
+            X = dtt(x, threads); %#ok<NASGU>
+            run_time(rep_ind) = toc;
+        end
+        exec_time(size_ind, thread_ind) = median(run_time);
+        
+    end
+    
+    clear x X;
+    
+end
+
+% =========================================================================
+% DISPLAY RESULTS
+% =========================================================================
+
+% display execution times and speed-up relative to a single thread
+fprintf('%10s', 'size');
+fprintf('%12s', strcat(num2str(thread_list.'), ' threads'));
+fprintf('\n');
+for size_ind = 1:length(test_sizes)
+    if test_dims(size_ind) == 2
+        label = sprintf('%d^2', test_sizes(size_ind));
+    else
+        label = sprintf('%d^3', test_sizes(size_ind));
+    end
+    fprintf('%10s', label);
+    fprintf('%9.2f ms', 1e3 * exec_time(size_ind, :));
+    fprintf('\n%10s', 'speed-up');
+    fprintf('%11.2fx', exec_time(size_ind, 1) ./ exec_time(size_ind, :));
+    fprintf('\n');
+end
@@ -0,0 +1,112 @@
+% DESCRIPTION:
+%     This benchmark script compares the two execution strategies used by
+%     dtt1D when the transform is taken along the second dimension of a
+%     2D array, where each transform is strided in memory. The 'strided'
+%     strategy executes a single strided FFTW plan, and the 'transpose'
+%     strategy copies tiles of the array to a contiguous buffer using a
+%     cache-blocked transpose, and executes a contiguous plan for each
+%     tile. The plans are created before timing, so only the execution is
+%     measured, and both strategies use the same number of threads.
+%
+%     The results can be used to check the thresholds used by the 'auto'
+%     strategy on a given machine (DTT_TRANSPOSE_MIN_STRIDE and
+%     DTT_TRANSPOSE_MIN_LENGTH in dttTranspose.h, which can be changed at
+%     compile time using, e.g., -DDTT_TRANSPOSE_MIN_STRIDE=16384). The
+%     defaults are the crossover measured on a single thread, where the
+%     'transpose' strategy was faster for strides of at least 8 kB (1024
+%     rows in double precision) and at least 256 columns. With several
+%     threads, the same thresholds are used when each thread has at least
+%     one full tile of the array, which can be checked by setting
+%     num_threads below.
+%
+% ABOUT:
+%     author      - Bradley Treeby
+%     date        - 16 October 2026
+%     last update - 16 October 2026
+%
+% See also dtt1D, dttOptions, benchmark_threads
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+%
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+clearvars;
+
+% =========================================================================
+% DEFINE SETTINGS
+% =========================================================================
+
+% DTT type (DCT-II)
+dtt_type = 2;
+
+% number of rows (the stride of each transform) and columns (the length
+% of each transform) to test
+num_rows = [256, 1024, 4096, 16384];
+num_cols = [64, 128, 256, 512, 4096];
+
+% number of threads used by both strategies
+num_threads = 1;
+
+% number of repeats for each timing
+num_repeats = 5;
+
+% =========================================================================
+% RUN BENCHMARK
+% =========================================================================
+
+% preallocate output
+strided_time   = zeros(length(num_rows), length(num_cols));
+transpose_time = zeros(length(num_rows), length(num_cols));
+
+for row_ind = 1:length(num_rows)
+    for col_ind = 1:length(num_cols)
+
+        % create test array
+        x = rand(num_rows(row_ind), num_cols(col_ind));
+
+        % time both strategies, creating and caching the plan first
+        run_time = zeros(1, num_repeats);
+        for strategy = {'strided', 'transpose'}
+            X = dtt1D(x, dtt_type, 2, 'Strategy', strategy{1}, 'Threads', num_threads); %#ok<NASGU>
+            for rep_ind = 1:num_repeats
+                tic;
+                X = dtt1D(x, dtt_type, 2, 'Strategy', strategy{1}, 'Threads', num_threads); %#ok<NASGU>
+                run_time(rep_ind) = toc;
+            end
+            if strcmp(strategy{1}, 'strided')
+                strided_time(row_ind, col_ind) = median(run_time);
+            else
+                transpose_time(row_ind, col_ind) = median(run_time);
+            end
+        end
+
+        clear x X;
+
+    end
+end
+
+% =========================================================================
+% DISPLAY RESULTS
+% =========================================================================
+
+% display execution times and speed-up of the transpose strategy
+fprintf('Using %d threads\n', num_threads);
+fprintf('%16s%16s%16s%12s\n', 'size', 'strided', 'transpose', 'speed-up');
+for row_ind = 1:length(num_rows)
+    for col_ind = 1:length(num_cols)
+        fprintf('%16s%13.2f ms%13.2f ms%11.2fx\n', ...
+            sprintf('%d x %d', num_rows(row_ind), num_cols(col_ind)), ...
+            1e3 * strided_time(row_ind, col_ind), ...
+            1e3 * transpose_time(row_ind, col_ind), ...
+            strided_time(row_ind, col_ind) / transpose_time(row_ind, col_ind));
+    end
+end
@@ -0,0 +1,73 @@
+#!/bin/sh
+# Run the MPI scaling benchmark (benchmark_mpi) for an increasing number
+# of ranks on a single machine, and print the speed-up and parallel
+# efficiency relative to one rank.
+#
+# The library and benchmark are built with MPI support using CMake, e.g.,
+#
+#     cmake -S . -B build -DDTT_BUILD_MPI=ON -DDTT_BUILD_BENCHMARKS=ON
+#     cmake --build build
+#     benchmarks/run_mpi_scaling.sh build/benchmark_mpi --dims 256,256,256 --check
+#
+# The first argument is the path to benchmark_mpi, and the remaining
+# arguments are passed to benchmark_mpi. The ranks are set using RANKS
+# (default "1 2 4 8"), the MPI launcher using MPIRUN (default mpirun),
+# and the raw results are written to RESULTS (default
+# mpi_scaling.csv). With Open MPI, --oversubscribe is added so more ranks
+# than cores can be started on one machine for testing. To measure
+# scaling rather than oversubscription, set --threads 1 and keep the
+# largest number of ranks at or below the number of cores.
+#
+# author: Bradley Treeby
+# date: 16 October 2026
+# last update: 16 October 2026
+#
+# Copyright (C) 2026 Bradley Treeby
+#
+# This program is free software: you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by the
+# Free Software Foundation, either version 3 of the License, or (at your
+# option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+# General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License along
+# with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+set -e
+
+if [ $# -lt 1 ]; then
+    echo "usage: run_mpi_scaling.sh path/to/benchmark_mpi [benchmark options]" >&2
+    exit 1
+fi
+BENCHMARK=$1
+shift
+
+RANKS=${RANKS:-"1 2 4 8"}
+MPIRUN=${MPIRUN:-mpirun}
+RESULTS=${RESULTS:-mpi_scaling.csv}
+
+# allow more ranks than cores with Open MPI
+EXTRA=""
+if $MPIRUN --version 2>/dev/null | grep -q "Open MPI"; then
+    EXTRA="--oversubscribe"
+fi
+
+# run the benchmark for each number of ranks, appending to the results
+rm -f "$RESULTS"
+HEADER=""
+for np in $RANKS; do
+    $MPIRUN $EXTRA -np "$np" "$BENCHMARK" --output "$RESULTS" $HEADER "$@"
+    HEADER="--no-header"
+done
+
+# speed-up and efficiency of the median time relative to the first row
+awk -F, '
+    NR == 1 { next }
+    NR == 2 { base = $7; base_ranks = $1 }
+    { printf "%6d ranks  %10.3f ms  speed-up %6.2f  efficiency %5.1f%%  %s\n",
+          $1, $7, base / $7, 100 * base * base_ranks / ($7 * $1), ($11 != "" ? "error " $11 : "") }
+' "$RESULTS"
@@ -1,24 +1,58 @@
-%COMPILEDTTMEX Compile mex-functions for dtt1D, dtt2D, and dtt3D.
+%COMPILEDTTMEX Compile mex-functions for the DTT library.
 %
 % DESCRIPTION:
-%     compileDttMex compiles the mex functions for dtt1D, dtt2D, and dtt3D.
+%     compileDttMex compiles the mex functions for dtt1D, dtt2D, dtt3D,
+%     dtt3DFile, dttAsync, dttND, dttPlan, dttPoissonSolve, dttWisdom,
+%     gradientDtt, and pstd2D. By default, the functions are compiled into a single mex
+%     binary (dttmex), which is called by the .m files for each function
+%     (dtt1D.m, dtt2D.m, etc.). All of the functions then share one plan
+%     cache, one FFTW thread pool, and the same FFTW wisdom. To compile
+%     each function as a separate mex function instead, set unified to
+%     false below. The mex functions should be linked against the shared
+%     FFTW library (as below) so that FFTW wisdom loaded using dttWisdom
+%     is shared by all of the DTT functions.
+%
+%     Separately compiled mex functions (including the precompiled mex
+%     functions for dtt1D, dtt2D, and dtt3D included in the repository)
+%     are called instead of the .m files, and should be deleted after
+%     compiling dttmex. A warning is given for any that are found.
 %
 %     On Windows, the compilation uses a pre-compiled version of FFTW
 %     included in the repository. If re-compiling, .lib files can be
 %     generated from .dll files using a Visual Studio command prompt
 %
 %         lib /machine:x64 /def:libfftw3-3.def
+%
+%     Single precision transforms also require the single precision FFTW
+%     library. On Windows, copy libfftw3f-3.dll and libfftw3f-3.def from
+%     the pre-compiled FFTW download to the repository folder, and
+%     generate the .lib file as above.
 %     
 %     On Linux or macOS, fftw can be downloaded from http://www.fftw.org/.
-%     Compile using the following options:
+%     Compile using the following options (the threads library is used
+%     for multi-threaded transforms):
 %
-%         sudo ./configure --enable-avx CFLAGS="-m64 -fPIC"
+%         sudo ./configure --enable-avx --enable-threads CFLAGS="-m64 -fPIC"
 %         sudo make
 %         sudo make install
+%
+%     and then repeat with --enable-float added to the configure options
+%     to build the single precision library.
 % 
 %     Note, use --enable-sse2 if avx instructions aren't supported on
 %     your processor.
 %
+%     With the 'gemm' strategy, batches of short transforms are computed
+%     as a matrix product using a built-in kernel (see dttGemm.h). To use the BLAS included
+%     with MATLAB instead, add the following options to the mex commands
+%     below:
+%
+%         -DDTT_USE_BLAS -DDTT_BLAS_INT=ptrdiff_t -lmwblas
+%
+%     The mex functions are compiled with -largeArrayDims (the default
+%     since MATLAB R2018a) so that array sizes use 64-bit integers, and
+%     arrays with more than 2^31 elements can be transformed.
+%
 %     It is assumed that a suitable C++ compiler is installed and selected
 %     by calling mex -setup. See: https://www.mathworks.com/support/...
 %     requirements/supported-compilers.html for more details. On linux,
@@ -29,26 +63,60 @@
 % ABOUT:
 %     author        - Bradley Treeby
 %     date          - 28 September 2017
-%     last update   - 19 March 2020
+%     last update   - 16 October 2026
 %
 % Copyright (C) 2017-2020 Bradley Treeby
 %
-% See also dtt1D, dtt2D, dtt3D
+% See also dtt1D, dtt2D, dtt3D, dttAsync, dttmex, dttND, dttPlan,
+% dttPoissonSolve, dttWisdom, gradientDtt, pstd2D
+
+% compile the single dttmex binary (set to false to compile a separate
+% mex function for each function)
+unified = true;
+
+% functions included in dttmex
+names = {'dtt1D', 'dtt2D', 'dtt3D', 'dtt3DFile', 'dttAsync', 'dttND', ...
+    'dttPlan', 'dttPoissonSolve', 'dttWisdom', 'gradientDtt', 'pstd2D'};
 
 % check for windows, mac, or linux
 if ispc
     
-    % use default compiler and link to pre-compiled FFTW library
-    mex -L"./" -llibfftw3-3 dtt1D.cpp
-    mex -L"./" -llibfftw3-3 dtt2D.cpp
-    mex -L"./" -llibfftw3-3 dtt3D.cpp
+    % use default compiler and link to pre-compiled FFTW library (this
+    % includes the threads library)
+    if unified
+        mex -largeArrayDims -DDTT_UNIFIED_MEX -L"./" -llibfftw3-3 -llibfftw3f-3 dttmex.cpp dtt1D.cpp dtt2D.cpp dtt3D.cpp dtt3DFile.cpp dttAsync.cpp dttND.cpp dttPlan.cpp dttPoissonSolve.cpp dttWisdom.cpp gradientDtt.cpp pstd2D.cpp
+    else
+        mex -largeArrayDims -L"./" -llibfftw3-3 -llibfftw3f-3 dtt1D.cpp
+        mex -largeArrayDims -L"./" -llibfftw3-3 -llibfftw3f-3 dtt2D.cpp
+        mex -largeArrayDims -L"./" -llibfftw3-3 -llibfftw3f-3 dtt3D.cpp
+        mex -largeArrayDims -L"./" -llibfftw3-3 -llibfftw3f-3 dtt3DFile.cpp
+        mex -largeArrayDims -L"./" -llibfftw3-3 -llibfftw3f-3 dttAsync.cpp
+        mex -largeArrayDims -L"./" -llibfftw3-3 -llibfftw3f-3 dttND.cpp
+        mex -largeArrayDims -L"./" -llibfftw3-3 -llibfftw3f-3 dttPlan.cpp
+        mex -largeArrayDims -L"./" -llibfftw3-3 -llibfftw3f-3 dttPoissonSolve.cpp
+        mex -largeArrayDims -L"./" -llibfftw3-3 -llibfftw3f-3 dttWisdom.cpp
+        mex -largeArrayDims -L"./" -llibfftw3-3 -llibfftw3f-3 gradientDtt.cpp
+        mex -largeArrayDims -L"./" -llibfftw3-3 -llibfftw3f-3 pstd2D.cpp
+    end
     
 elseif ismac
     
     % use default compiler and link to FFTW installed on local machine
-    mex -I/usr/local/include/ -L/usr/local/lib -lfftw3 -lm dtt1D.cpp
-    mex -I/usr/local/include/ -L/usr/local/lib -lfftw3 -lm dtt2D.cpp
-    mex -I/usr/local/include/ -L/usr/local/lib -lfftw3 -lm dtt3D.cpp
+    if unified
+        mex -largeArrayDims -DDTT_UNIFIED_MEX -I/usr/local/include/ -L/usr/local/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dttmex.cpp dtt1D.cpp dtt2D.cpp dtt3D.cpp dtt3DFile.cpp dttAsync.cpp dttND.cpp dttPlan.cpp dttPoissonSolve.cpp dttWisdom.cpp gradientDtt.cpp pstd2D.cpp
+    else
+        mex -largeArrayDims -I/usr/local/include/ -L/usr/local/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dtt1D.cpp
+        mex -largeArrayDims -I/usr/local/include/ -L/usr/local/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dtt2D.cpp
+        mex -largeArrayDims -I/usr/local/include/ -L/usr/local/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dtt3D.cpp
+        mex -largeArrayDims -I/usr/local/include/ -L/usr/local/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dtt3DFile.cpp
+        mex -largeArrayDims -I/usr/local/include/ -L/usr/local/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dttAsync.cpp
+        mex -largeArrayDims -I/usr/local/include/ -L/usr/local/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dttND.cpp
+        mex -largeArrayDims -I/usr/local/include/ -L/usr/local/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dttPlan.cpp
+        mex -largeArrayDims -I/usr/local/include/ -L/usr/local/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dttPoissonSolve.cpp
+        mex -largeArrayDims -I/usr/local/include/ -L/usr/local/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dttWisdom.cpp
+        mex -largeArrayDims -I/usr/local/include/ -L/usr/local/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread gradientDtt.cpp
+        mex -largeArrayDims -I/usr/local/include/ -L/usr/local/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread pstd2D.cpp
+    end
 
 else
     
@@ -57,8 +125,30 @@ else
     
 %     % specify gcc compiler and dynamically link to FFTW (change the path
 %     % locations in the example below)
-%     mex -v GCC='/usr/bin/gcc-7' -I/usr/local/include/ -L/mnt/Apps/software/FFTW/3.3.8-OpenMPI-4.0.1-GCC-7.3.0-2.30/lib -lfftw3 -lm dtt1D.cpp
-%     mex -v GCC='/usr/bin/gcc-7' -I/usr/local/include/ -L/mnt/Apps/software/FFTW/3.3.8-OpenMPI-4.0.1-GCC-7.3.0-2.30/lib -lfftw3 -lm dtt2D.cpp
-%     mex -v GCC='/usr/bin/gcc-7' -I/usr/local/include/ -L/mnt/Apps/software/FFTW/3.3.8-OpenMPI-4.0.1-GCC-7.3.0-2.30/lib -lfftw3 -lm dtt3D.cpp
+%     if unified
+%         mex -v -largeArrayDims -DDTT_UNIFIED_MEX GCC='/usr/bin/gcc-7' -I/usr/local/include/ -L/mnt/Apps/software/FFTW/3.3.8-OpenMPI-4.0.1-GCC-7.3.0-2.30/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dttmex.cpp dtt1D.cpp dtt2D.cpp dtt3D.cpp dtt3DFile.cpp dttAsync.cpp dttND.cpp dttPlan.cpp dttPoissonSolve.cpp dttWisdom.cpp gradientDtt.cpp pstd2D.cpp
+%     else
+%         mex -v -largeArrayDims GCC='/usr/bin/gcc-7' -I/usr/local/include/ -L/mnt/Apps/software/FFTW/3.3.8-OpenMPI-4.0.1-GCC-7.3.0-2.30/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dtt1D.cpp
+%         mex -v -largeArrayDims GCC='/usr/bin/gcc-7' -I/usr/local/include/ -L/mnt/Apps/software/FFTW/3.3.8-OpenMPI-4.0.1-GCC-7.3.0-2.30/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dtt2D.cpp
+%         mex -v -largeArrayDims GCC='/usr/bin/gcc-7' -I/usr/local/include/ -L/mnt/Apps/software/FFTW/3.3.8-OpenMPI-4.0.1-GCC-7.3.0-2.30/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dtt3D.cpp
+%         mex -v -largeArrayDims GCC='/usr/bin/gcc-7' -I/usr/local/include/ -L/mnt/Apps/software/FFTW/3.3.8-OpenMPI-4.0.1-GCC-7.3.0-2.30/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dtt3DFile.cpp
+%         mex -v -largeArrayDims GCC='/usr/bin/gcc-7' -I/usr/local/include/ -L/mnt/Apps/software/FFTW/3.3.8-OpenMPI-4.0.1-GCC-7.3.0-2.30/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dttAsync.cpp
+%         mex -v -largeArrayDims GCC='/usr/bin/gcc-7' -I/usr/local/include/ -L/mnt/Apps/software/FFTW/3.3.8-OpenMPI-4.0.1-GCC-7.3.0-2.30/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dttND.cpp
+%         mex -v -largeArrayDims GCC='/usr/bin/gcc-7' -I/usr/local/include/ -L/mnt/Apps/software/FFTW/3.3.8-OpenMPI-4.0.1-GCC-7.3.0-2.30/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dttPlan.cpp
+%         mex -v -largeArrayDims GCC='/usr/bin/gcc-7' -I/usr/local/include/ -L/mnt/Apps/software/FFTW/3.3.8-OpenMPI-4.0.1-GCC-7.3.0-2.30/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dttPoissonSolve.cpp
+%         mex -v -largeArrayDims GCC='/usr/bin/gcc-7' -I/usr/local/include/ -L/mnt/Apps/software/FFTW/3.3.8-OpenMPI-4.0.1-GCC-7.3.0-2.30/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread dttWisdom.cpp
+%         mex -v -largeArrayDims GCC='/usr/bin/gcc-7' -I/usr/local/include/ -L/mnt/Apps/software/FFTW/3.3.8-OpenMPI-4.0.1-GCC-7.3.0-2.30/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread gradientDtt.cpp
+%         mex -v -largeArrayDims GCC='/usr/bin/gcc-7' -I/usr/local/include/ -L/mnt/Apps/software/FFTW/3.3.8-OpenMPI-4.0.1-GCC-7.3.0-2.30/lib -lfftw3_threads -lfftw3 -lfftw3f_threads -lfftw3f -lm -lpthread pstd2D.cpp
+%     end
+
+end
 
-end
\ No newline at end of file
+% check for separately compiled mex functions, which are called instead of
+% the .m files that call dttmex
+if unified
+    for ind = 1:length(names)
+        if exist(names{ind}, 'file') == 3
+            warning(['The separately compiled mex function ' names{ind} ' is called instead of dttmex, and should be deleted.']);
+        end
+    end
+end
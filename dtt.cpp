@@ -0,0 +1,235 @@
+/**************************************************************************
+ * C interface to the DTT library (see dtt.h).
+ *
+ * The arguments are checked and converted to the shape descriptors and
+ * options defined in dttCore.h, and the transforms are computed using
+ * dtt::execute (see dttExecute.h), which is also used by the mex
+ * functions.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttCore.h"
+#include "dttExecute.h"
+#include "dttFile.h"
+#include "dtt.h"
+
+//--------------------------------------------
+// ARGUMENTS
+//--------------------------------------------
+
+//convert the C options to the options used by dtt::execute, returns
+//false if the options are not valid
+static bool getOptions(const dtt_options *opts, bool in_place, dtt::Options &options){
+    dtt_options defaults;
+    if (opts == NULL){
+        dtt_default_options(&defaults);
+        opts = &defaults;
+    }
+    options = dtt::defaultOptions();
+    switch (opts->planner) {
+        case DTT_PLANNER_ESTIMATE: options.planner = FFTW_ESTIMATE; break;
+        case DTT_PLANNER_MEASURE: options.planner = FFTW_MEASURE; break;
+        case DTT_PLANNER_PATIENT: options.planner = FFTW_PATIENT; break;
+        case DTT_PLANNER_EXHAUSTIVE: options.planner = FFTW_EXHAUSTIVE; break;
+        default: return false;
+    }
+    if (opts->threads < 0 || opts->strategy < DTT_STRATEGY_AUTO || opts->strategy > DTT_STRATEGY_GEMM){
+        return false;
+    }
+    options.time_limit = (opts->time_limit > 0) ? opts->time_limit : FFTW_NO_TIMELIMIT;
+    options.threads = opts->threads;
+    options.strategy = opts->strategy;
+    options.inverse = (opts->inverse != 0);
+    options.in_place = in_place;
+    return true;
+}
+
+//convert the array size, returns false if any dimension is not positive,
+//or the number of elements (in bytes for double precision) overflows
+//ptrdiff_t
+static bool getSize(int numdims, const ptrdiff_t *dims, std::vector<ptrdiff_t> &sz){
+    if (numdims < 1 || dims == NULL){
+        return false;
+    }
+    sz.assign(dims, dims + numdims);
+    ptrdiff_t numel = (ptrdiff_t) sizeof(double);
+    for (int i = 0; i < numdims; i++){
+        if (sz[i] < 1 || sz[i] > PTRDIFF_MAX / numel){
+            return false;
+        }
+        numel *= sz[i];
+    }
+    return true;
+}
+
+//number of threads used to transform an array with the given number of
+//elements, if not given explicitly this is 1 for small arrays, and
+//otherwise the number of hardware threads (as in dtt::getThreads, which
+//uses maxNumCompThreads)
+static int getThreads(const dtt::Options &options, ptrdiff_t numel){
+    if (options.threads > 0){
+        return options.threads;
+    }
+    if (numel < DTT_MIN_THREADED_SIZE){
+        return 1;
+    }
+    int threads = (int) std::thread::hardware_concurrency();
+    return threads > 1 ? threads : 1;
+}
+
+//compute the transform
+template <typename T>
+static int transform(const dtt::Transform &t, const T *in, T *out, const dtt::Options &options){
+    if (!dtt::execute(t, const_cast<T *>(in), out, options, getThreads(options, t.numel))){
+        return DTT_ERROR_PLAN;
+    }
+    return DTT_SUCCESS;
+}
+
+//transform along a single dimension
+template <typename T>
+static int transformDim(const T *in, T *out, int numdims, const ptrdiff_t *dims, int dim, int dtt_type, const dtt_options *opts){
+    dtt::Options options;
+    std::vector<ptrdiff_t> sz;
+    int kind = dtt::fftwKind(dtt_type);
+    if (in == NULL || out == NULL || dim < 0 || kind < 0 || !getSize(numdims, dims, sz) || !getOptions(opts, in == out, options)){
+        return DTT_ERROR_ARGUMENT;
+    }
+    return transform(dtt::describeAxis(sz, dim, kind), in, out, options);
+}
+
+//transform along every dimension
+template <typename T>
+static int transformAll(const T *in, T *out, int numdims, const ptrdiff_t *dims, const int *dtt_types, const dtt_options *opts){
+    dtt::Options options;
+    std::vector<ptrdiff_t> sz;
+    if (in == NULL || out == NULL || dtt_types == NULL || !getSize(numdims, dims, sz) || !getOptions(opts, in == out, options)){
+        return DTT_ERROR_ARGUMENT;
+    }
+    std::vector<int> kinds(numdims);
+    for (int i = 0; i < numdims; i++){
+        kinds[i] = (dtt_types[i] == 0) ? -1 : dtt::fftwKind(dtt_types[i]);
+        if (dtt_types[i] != 0 && kinds[i] < 0){
+            return DTT_ERROR_ARGUMENT;
+        }
+    }
+    return transform(dtt::describeAxes(sz, kinds), in, out, options);
+}
+
+//transform an array stored in a file
+static int transformFile(const char *in_file, long long in_offset, const char *out_file, long long out_offset,
+        const ptrdiff_t *dims, const int *dtt_types, int precision, size_t memory_limit, const dtt_options *opts){
+    dtt::Options options;
+    std::vector<ptrdiff_t> sz;
+    if (in_file == NULL || out_file == NULL || in_offset < 0 || out_offset < 0 || dtt_types == NULL
+            || (precision != DTT_PRECISION_DOUBLE && precision != DTT_PRECISION_SINGLE)
+            || !getSize(3, dims, sz) || !getOptions(opts, true, options)){
+        return DTT_ERROR_ARGUMENT;
+    }
+    std::vector<int> kinds(3);
+    for (int i = 0; i < 3; i++){
+        kinds[i] = (dtt_types[i] == 0) ? -1 : dtt::fftwKind(dtt_types[i]);
+        if (dtt_types[i] != 0 && kinds[i] < 0){
+            return DTT_ERROR_ARGUMENT;
+        }
+    }
+    if (memory_limit == 0){
+        memory_limit = DTT_FILE_MEMORY_LIMIT;
+    }
+    int threads = getThreads(options, sz[0] * sz[1] * sz[2]);
+    int status;
+    if (precision == DTT_PRECISION_SINGLE){
+        status = dtt::transformFile<float>(in_file, in_offset, out_file, out_offset, &sz[0], kinds, memory_limit, options, threads);
+    } else {
+        status = dtt::transformFile<double>(in_file, in_offset, out_file, out_offset, &sz[0], kinds, memory_limit, options, threads);
+    }
+    switch (status) {
+        case DTT_FILE_SUCCESS: return DTT_SUCCESS;
+        case DTT_FILE_ERROR_LIMIT: return DTT_ERROR_ARGUMENT;
+        case DTT_FILE_ERROR_PLAN: return DTT_ERROR_PLAN;
+        default: return DTT_ERROR_FILE;
+    }
+}
+
+//--------------------------------------------
+// C INTERFACE
+//--------------------------------------------
+
+extern "C" {
+
+void dtt_default_options(dtt_options *opts){
+    if (opts == NULL){
+        return;
+    }
+    opts->planner = DTT_PLANNER_ESTIMATE;
+    opts->time_limit = 0;
+    opts->threads = 0;
+    opts->strategy = DTT_STRATEGY_AUTO;
+    opts->inverse = 0;
+}
+
+int dtt_transform_dim(const double *in, double *out, int numdims, const ptrdiff_t *dims,
+        int dim, int dtt_type, const dtt_options *opts){
+    return transformDim(in, out, numdims, dims, dim, dtt_type, opts);
+}
+
+int dtt_transform_dim_f(const float *in, float *out, int numdims, const ptrdiff_t *dims,
+        int dim, int dtt_type, const dtt_options *opts){
+    return transformDim(in, out, numdims, dims, dim, dtt_type, opts);
+}
+
+int dtt_transform(const double *in, double *out, int numdims, const ptrdiff_t *dims,
+        const int *dtt_types, const dtt_options *opts){
+    return transformAll(in, out, numdims, dims, dtt_types, opts);
+}
+
+int dtt_transform_f(const float *in, float *out, int numdims, const ptrdiff_t *dims,
+        const int *dtt_types, const dtt_options *opts){
+    return transformAll(in, out, numdims, dims, dtt_types, opts);
+}
+
+int dtt_transform_file(const char *in_file, long long in_offset, const char *out_file,
+        long long out_offset, const ptrdiff_t *dims, const int *dtt_types, int precision,
+        size_t memory_limit, const dtt_options *opts){
+    return transformFile(in_file, in_offset, out_file, out_offset, dims, dtt_types, precision, memory_limit, opts);
+}
+
+void dtt_cleanup(void){
+    dtt::clearPlanCache();
+}
+
+const char *dtt_error_message(int status){
+    switch (status) {
+        case DTT_SUCCESS: return "Success.";
+        case DTT_ERROR_ARGUMENT: return "Invalid argument.";
+        case DTT_ERROR_PLAN: return "FFTW plan could not be created.";
+        case DTT_ERROR_FILE: return "File could not be read or written.";
+        case DTT_ERROR_MPI: return "MPI communication failed.";
+        default: return "Unknown status code.";
+    }
+}
+
+} // extern "C"
@@ -0,0 +1,153 @@
+/**************************************************************************
+ * C interface to the DTT library.
+ *
+ * Computes the 8 discrete trigonometric transforms (DCT-I to DCT-IV and
+ * DST-I to DST-IV) of arrays in double or single precision using FFTW,
+ * without any dependency on MATLAB. Arrays are stored in column-major
+ * order (as in MATLAB and Fortran), with the size of each dimension given
+ * from the fastest to the slowest varying dimension. FFTW plans are
+ * cached and re-used across calls (see dttPlanCache.h), and can be
+ * released using dtt_cleanup.
+ *
+ * The transforms are computed by the same code used by the mex functions
+ * (see dttExecute.h), and use the same definitions and scaling as FFTW,
+ * where the DTT types are numbered as in dtt1D:
+ *
+ *     1: DCT-I     2: DCT-II    3: DCT-III   4: DCT-IV
+ *     5: DST-I     6: DST-II    7: DST-III   8: DST-IV
+ *
+ * Example:
+ *
+ *     double x[64 * 32], y[64 * 32];
+ *     ptrdiff_t dims[2] = {64, 32};
+ *     dtt_options opts;
+ *     dtt_default_options(&opts);
+ *     dtt_transform_dim(x, y, 2, dims, 0, 2, &opts);   // DCT-II of each column
+ *     dtt_cleanup();
+ *
+ * The plan cache is shared by all calls, so calls from different threads
+ * must be serialised by the caller (each transform can itself use
+ * multiple threads, set using the threads option).
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_H
+#define DTT_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* symbol visibility for shared library builds */
+#if defined(_WIN32) && defined(DTT_SHARED)
+#  ifdef DTT_BUILDING_LIBRARY
+#    define DTT_API __declspec(dllexport)
+#  else
+#    define DTT_API __declspec(dllimport)
+#  endif
+#else
+#  define DTT_API
+#endif
+
+/* status codes */
+#define DTT_SUCCESS         0   /* transform computed */
+#define DTT_ERROR_ARGUMENT  1   /* invalid argument */
+#define DTT_ERROR_PLAN      2   /* FFTW plan or buffer could not be created */
+#define DTT_ERROR_FILE      3   /* file could not be read or written */
+#define DTT_ERROR_MPI       4   /* MPI communication failed (see dttMpi.h) */
+
+/* precision of arrays stored in files */
+#define DTT_PRECISION_DOUBLE    0
+#define DTT_PRECISION_SINGLE    1
+
+/* planner rigor */
+#define DTT_PLANNER_ESTIMATE    0
+#define DTT_PLANNER_MEASURE     1
+#define DTT_PLANNER_PATIENT     2
+#define DTT_PLANNER_EXHAUSTIVE  3
+
+/* execution strategy for transforms along a single dimension (see
+ * dttOptions.m) */
+#define DTT_STRATEGY_AUTO       0
+#define DTT_STRATEGY_STRIDED    1
+#define DTT_STRATEGY_TRANSPOSE  2
+#define DTT_STRATEGY_SMALL      3
+#define DTT_STRATEGY_CHIRP      4
+#define DTT_STRATEGY_GEMM       5
+
+/* execution options (see dttOptions.m) */
+typedef struct {
+    int planner;        /* planner rigor (DTT_PLANNER_*) */
+    double time_limit;  /* planner time limit in seconds (<= 0 for no limit) */
+    int threads;        /* number of threads (0 to use the number of cores for large arrays) */
+    int strategy;       /* execution strategy (DTT_STRATEGY_*) */
+    int inverse;        /* compute the normalised inverse transform if non-zero */
+} dtt_options;
+
+/* set the options to the default values (estimate planner, no time
+ * limit, default threads, auto strategy, forward transform) */
+DTT_API void dtt_default_options(dtt_options *opts);
+
+/* transform along dimension dim (counting from zero) of an array with
+ * numdims dimensions of size dims[0], ..., dims[numdims - 1], where
+ * dtt_type is between 1 and 8, and dimensions beyond numdims are
+ * singleton (in and out can be the same array, and opts can be NULL to
+ * use the defaults) */
+DTT_API int dtt_transform_dim(const double *in, double *out, int numdims, const ptrdiff_t *dims,
+        int dim, int dtt_type, const dtt_options *opts);
+DTT_API int dtt_transform_dim_f(const float *in, float *out, int numdims, const ptrdiff_t *dims,
+        int dim, int dtt_type, const dtt_options *opts);
+
+/* transform along every dimension of an array with numdims dimensions,
+ * where dtt_types[i] is the DTT type used for dimension i, or 0 if the
+ * dimension is not transformed (as in dttND) */
+DTT_API int dtt_transform(const double *in, double *out, int numdims, const ptrdiff_t *dims,
+        const int *dtt_types, const dtt_options *opts);
+DTT_API int dtt_transform_f(const float *in, float *out, int numdims, const ptrdiff_t *dims,
+        const int *dtt_types, const dtt_options *opts);
+
+/* transform a 3D array of size dims[0] by dims[1] by dims[2] stored in a
+ * raw binary file (column-major, native byte order, starting at
+ * in_offset bytes, with the given DTT_PRECISION_*), where dtt_types[i] is
+ * the DTT type used for dimension i, or 0 if the dimension is not
+ * transformed, and write the result to out_file starting at out_offset
+ * bytes (out_file is created if it doesn't exist, and can be the same as
+ * in_file). The array is transformed out of core using at most
+ * memory_limit bytes for the buffers (0 to use the default of 1 GB),
+ * which must hold three xy-planes and three xz-planes of the array (see
+ * dttFile.h) */
+DTT_API int dtt_transform_file(const char *in_file, long long in_offset, const char *out_file,
+        long long out_offset, const ptrdiff_t *dims, const int *dtt_types, int precision,
+        size_t memory_limit, const dtt_options *opts);
+
+/* release the cached FFTW plans and buffers */
+DTT_API void dtt_cleanup(void);
+
+/* description of a status code */
+DTT_API const char *dtt_error_message(int status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,10 +1,10 @@
 /**************************************************************************
  * MEX file to compute 1D discrete trigonometric transforms in double 
- * precision using FFTW. See dtt1D.m for usage notes.
+ * or single precision using FFTW. See dtt1D.m for usage notes.
  *
  * author: Bradley Treeby
  * date: 31 May 2012
- * last update: 19 March 2020
+ * last update: 16 October 2026
  *
  * Copyright (C) 2012-2020 Bradley Treeby
  *
@@ -25,8 +25,14 @@
 #include <matrix.h>
 #include <mex.h>
 #include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttOptions.h"
+#include "dttCore.h"
+#include "dttExecute.h"
+#include "dttStats.h"
+#include "dttMex.h"
 
-void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+DTT_MEX_FUNCTION(dtt1D)
 {
 
     //--------------------------------------------
@@ -37,26 +43,25 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
     const mwSize *dims;
     mwSize check_el_num;
     mwSize numelements;
-    int NX, NY, N, numdims;
+    int numdims;
     int i;
-    double *input_ptr, *output_ptr;
-    fftw_plan plan;
-    int DIM = 1;    // set default DIM to 1 if not given by user
-    int rank = 1;   // DTTs are all 1D or rank 1
-    int n[1];       // DTT size is thus also rank 1
-    int howmany;
-    int idist, odist;
-    int istride, ostride;
+    void *input_ptr, *output_ptr;
+    int DIM = 0;            // set to the first non-singleton dimension if not given by user
+    int first_option = 2;   // index of the first optional name/value input
+    
+    //start timing the call (see dttStats.h)
+    dtt::CallStats stats("dtt1D");
+    
+    //release cached FFTW plans when the mex file is cleared
+    dtt::atExit(dtt::clearPlanCache);
     
     //--------------------------------------------
     // CHECK NUMBER OF INPUTS AND OUTPUTS
     //--------------------------------------------
     
     //check for proper number of input and output arguments
-    if( !(nrhs == 2 || nrhs == 3) ) {
-        mexErrMsgTxt("Two or three inputs are required.");
-	} else if(nlhs!=1) {
-        mexErrMsgTxt("One output is required.");
+    if(nrhs < 2) {
+        mexErrMsgTxt("At least two inputs are required.");
 	}
     
     //--------------------------------------------
@@ -73,7 +78,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
     int DTT_type = (* (double *) mxGetPr(prhs[1]));
     
     //check the value
-    if ( !((DTT_type == 1) || (DTT_type == 2) || (DTT_type == 3) || (DTT_type == 4) || (DTT_type == 5) || (DTT_type == 6) || (DTT_type == 7) || (DTT_type == 8)) ){
+    if (dtt::fftwKind(DTT_type) < 0){
         mexErrMsgTxt("Input for DTT_TYPE must be an integer between 1 and 8.");
     }
     
@@ -81,14 +86,18 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
     // CHECK AND ALLOCATE DIM INPUT
     //--------------------------------------------
     
-    //if DIM input is given, check it
-    if (nrhs == 3){
+    //if DIM input is given, check it (the third input is either DIM, or 
+    //the name of the first option)
+    if (nrhs >= 3 && !mxIsChar(prhs[2])){
+        
+        //options start after DIM
+        first_option = 3;
         
         //get the number of elements
         check_el_num = mxGetNumberOfElements(prhs[2]);
         
         //check DIM input is real, scalar, and double precision
-        if( !(mxIsDouble(prhs[1]) && !mxIsComplex(prhs[1]) && check_el_num == 1) ){
+        if( !(mxIsDouble(prhs[2]) && !mxIsComplex(prhs[2]) && check_el_num == 1) ){
             mexErrMsgTxt("Input for DIM must be real, scalar, and double precision.");
         }
         
@@ -96,121 +105,103 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
         // (* something) means take the first element == something[0]
         DIM = (int)(* (double *) mxGetPr(prhs[2]));
         
-        //check the value is 1 or 2
-        if ( !( (DIM == 1) || (DIM == 2) ) ){
-            mexErrMsgTxt("Input for DIM must be 1 or 2.");
+        //check the value is a positive integer
+        if ( !(DIM >= 1 && DIM == (* (double *) mxGetPr(prhs[2]))) ){
+            mexErrMsgTxt("Input for DIM must be a positive integer.");
         }
         
     }
     
+    //--------------------------------------------
+    // CHECK OPTIONAL INPUTS
+    //--------------------------------------------
+    
+    //get planner options from name/value pairs and global defaults
+    dtt::Options options = dtt::getOptions(nrhs, prhs, first_option);
+    stats.enable(options.stats);
+
+    //check the number of outputs (none for in-place transforms)
+    dtt::checkOutputs(options, nlhs);
+    
     //--------------------------------------------
     // CHECK AND ALLOCATE INPUT AND OUTPUT ARRAYS
     //--------------------------------------------
     
-    //check the input matrix is real and double precision
-    if( !(mxIsDouble(prhs[0]) && !mxIsComplex(prhs[0])) ) {
-        mexErrMsgTxt("Input array must be double precision and real.");
+    //check the input matrix is real and double or single precision
+    if( !((mxIsDouble(prhs[0]) || mxIsSingle(prhs[0])) && !mxIsComplex(prhs[0])) ) {
+        mexErrMsgTxt("Input array must be double or single precision and real.");
     }  
 
-    //check that the input is either 1D or 2D
-    numdims = mxGetNumberOfDimensions(prhs[0]);     //number of dimensions is always >= 2
-    if ( numdims > 2){
-        mexErrMsgTxt("Input array must be 1D or 2D.");
-    }
-    
-    //get the dimensions of the input array
+    //get the dimensions of the input array (number of dimensions is
+    //always >= 2)
+    numdims = mxGetNumberOfDimensions(prhs[0]);
     dims = mxGetDimensions(prhs[0]);
     numelements = mxGetNumberOfElements(prhs[0]);
-    NX = (int)dims[0];
-    NY = (int)dims[1];
-    N = NX*NY;
     
     //check if 1D and force the correct DIM (input DIM is not used)
-    if (NX == 1) {
+    if (numdims == 2 && dims[0] == 1) {
         DIM = 2;
     }
-    else if (NY == 1) {
+    else if (numdims == 2 && dims[1] == 1) {
         DIM = 1;
     }
     
-    //print dimensions of the input array
-    //mexPrintf("DTT Type %d, Array Dimensions %d by %d, DTT on Dimension %d\n", DTT_type, NX, NY, DIM);
-   
-    //create MATLAB output
-    output_mat = plhs[0] = mxCreateNumericArray(numdims, dims, mxDOUBLE_CLASS, mxREAL);
-    
-    //get pointer to input and output arrays
-    input_ptr = (double *) mxGetPr(prhs[0]);
-    output_ptr = (double *) mxGetPr(output_mat);
-    
-    //--------------------------------------------
-    // DEFINE PLAN VARIABLES
-    //--------------------------------------------
-    
-    //define plan_many variables based on DIM setting (these are switched 
-    //to c++ as MATLAB inputs are column major)
-    switch ( DIM ) {
-        case 1 :
-            //perform DTT over columns of input array
-            n[0] = NX;
-            howmany = NY;
-            idist = odist = NX;
-            istride = ostride = 1;            
-            break;
-        case 2 :      
-            //perform DTT over rows of input array
-            n[0] = NY;
-            howmany = NX;
-            idist = odist = 1;
-            istride = ostride = NX;
-            break;
-        default :
-            mexErrMsgTxt("Input for DIM must be 1 or 2.");
+    //if DIM is not given, use the first non-singleton dimension
+    if (DIM == 0) {
+        DIM = 1;
+        for (i = 0; i < numdims; i++) {
+            if (dims[i] != 1) {
+                DIM = i + 1;
+                break;
+            }
+        }
     }
     
-    //plan_many requires a pointer to the input type. However, FFTW_REDFT00 etc
-    //are defined using #define so we cannot directly get a pointer to them. 
-    //Instead we allocate some memory, copy the value of the input type, and use the 
-    //pointer to this memory.
-    fftw_r2r_kind * fKind = (fftw_r2r_kind *) fftw_malloc(sizeof(fftw_r2r_kind));
-     
-    //set DTT type
-    switch ( DTT_type ) {
-        case 1: fKind[0] = FFTW_REDFT00; break;
-        case 2: fKind[0] = FFTW_REDFT10; break;
-        case 3: fKind[0] = FFTW_REDFT01; break;
-        case 4: fKind[0] = FFTW_REDFT11; break;
-        case 5: fKind[0] = FFTW_RODFT00; break;
-        case 6: fKind[0] = FFTW_RODFT10; break;
-        case 7: fKind[0] = FFTW_RODFT01; break;
-        case 8: fKind[0] = FFTW_RODFT11; break;  		
-        default: mexErrMsgTxt("Input for DTT_TYPE must be an integer between 1 and 8.");
+    //print number of dimensions of the input array
+    //mexPrintf("DTT Type %d, Array Dimensions %d, DTT on Dimension %d\n", DTT_type, numdims, DIM);
+   
+    stats.mark(DTT_PHASE_VALIDATE);
+    
+    //create MATLAB output with the same precision as the input, or for
+    //in-place transforms, write the output to the input array (the output
+    //is not zero-filled as every element is written by FFTW, so the pages
+    //are first touched by the threads executing the transform)
+    input_ptr = mxGetData(prhs[0]);
+    if (options.in_place){
+        output_ptr = input_ptr;
+    } else {
+        output_mat = plhs[0] = mxCreateUninitNumericArray(numdims, dims, mxGetClassID(prhs[0]), mxREAL);
+        output_ptr = mxGetData(output_mat);
     }
+    stats.mark(DTT_PHASE_ALLOCATE);
     
     //--------------------------------------------
-    // CREATE AND EXECUTE FFTW PLAN
+    // EXECUTE FFTW PLAN
     //--------------------------------------------
     
-    /*fftw_plan fftw_plan_many_r2r(int rank, const int *n, int howmany,
-                                  double *in, const int *inembed,
-                                  int istride, int idist,
-                                  double *out, const int *onembed,
-                                  int ostride, int odist,
-                                  const fftw_r2r_kind *kind, unsigned flags);*/
+    //describe the transform along DIM using guru64 dimensions, the
+    //transform is looped over the dimensions before and after DIM, so the
+    //output is in the original layout without permuting the array (see
+    //dttCore.h)
+    std::vector<ptrdiff_t> sz(dims, dims + numdims);
+    dtt::Transform transform = dtt::describeAxis(sz, DIM - 1, dtt::fftwKind(DTT_type));
     
-    //create plan using the input and output pointers directly (out of place transform)
-    plan = fftw_plan_many_r2r(rank, (int *) &n, howmany, (double *) input_ptr, NULL, istride, idist, (double *) output_ptr, NULL, ostride, odist, (fftw_r2r_kind*) fKind, FFTW_ESTIMATE);    
-
-    //execute plan
-    fftw_execute(plan);    
-    
-    //--------------------------------------------
-    // CLEANUP ALLOCATED VARIABLES
-    //--------------------------------------------
-    
-    //cleanup
-    fftw_destroy_plan(plan);
-    fftw_free((fftw_r2r_kind*)fKind);
+    //execute using a cached plan (out of place unless InPlace is set),
+    //short transforms use kernels specialised for each length, and large
+    //strides are transposed through a contiguous buffer (see dttExecute.h)
+    int threads = dtt::getThreads(options, numelements);
+    bool success;
+    if (mxIsSingle(prhs[0])){
+        success = dtt::execute(transform, (float *) input_ptr, (float *) output_ptr, options, threads);
+    } else {
+        success = dtt::execute(transform, (double *) input_ptr, (double *) output_ptr, options, threads);
+    }
+    if (!success){
+        mexErrMsgTxt("FFTW plan could not be created.");
+    }
+    stats.mark(DTT_PHASE_EXECUTE);
+    stats.addBytes(2.0 * numelements * mxGetElementSize(prhs[0]));
+    stats.finish();
     
     return;
 }
\ No newline at end of file
@@ -1,10 +1,10 @@
 /**************************************************************************
  * MEX file to compute 2D discrete trigonometric transforms in double 
- * precision using FFTW. See dtt2D.m for usage notes.
+ * or single precision using FFTW. See dtt2D.m for usage notes.
  *
  * author: Bradley Treeby
  * date: 31 May 2012
- * last update: 19 March 2020
+ * last update: 16 October 2026
  *
  * Copyright (C) 2012-2020 Bradley Treeby
  *
@@ -25,8 +25,14 @@
 #include <matrix.h>
 #include <mex.h>
 #include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttOptions.h"
+#include "dttCore.h"
+#include "dttExecute.h"
+#include "dttStats.h"
+#include "dttMex.h"
 
-void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+DTT_MEX_FUNCTION(dtt2D)
 {
 
     //--------------------------------------------
@@ -36,20 +42,23 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
     mxArray *output_mat;
     mwSize numelements;    
     const mwSize *dims;
-    int NX, NY, numdims;
-    double *input_ptr, *output_ptr;
-    fftw_plan plan;
-    fftw_r2r_kind DTT_type_x, DTT_type_y;
+    int numdims, i;
+    void *input_ptr, *output_ptr;
+    std::vector<int> axis_kinds(2);    // FFTW kind for each dimension, fastest varying first
+    
+    //start timing the call (see dttStats.h)
+    dtt::CallStats stats("dtt2D");
+    
+    //release cached FFTW plans when the mex file is cleared
+    dtt::atExit(dtt::clearPlanCache);
     
     //--------------------------------------------
     // CHECK NUMBER OF INPUTS AND OUTPUTS
     //--------------------------------------------    
     
     //check for proper number of arguments
-    if(nrhs!=2) {
-        mexErrMsgTxt("Two inputs are required.");
-	} else if(nlhs!=1) {
-        mexErrMsgTxt("One output is required.");
+    if(nrhs < 2) {
+        mexErrMsgTxt("At least two inputs are required.");
 	}
     
     //--------------------------------------------
@@ -65,64 +74,35 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
     double * dtt_type_pointer = mxGetPr(prhs[1]);
     mwSize check_el_num = mxGetNumberOfElements(prhs[1]);
     
-    //assign DTT types, first cast double input to 32-bit integer for switch, 
-    //and then assign the literals
-    if (check_el_num == 1){
-        
-        //assign scalar input to both x and y directions
-        switch ( (int) dtt_type_pointer[0] ) {
-            case 1: DTT_type_x = FFTW_REDFT00; DTT_type_y = FFTW_REDFT00; break;
-            case 2: DTT_type_x = FFTW_REDFT10; DTT_type_y = FFTW_REDFT10; break;
-            case 3: DTT_type_x = FFTW_REDFT01; DTT_type_y = FFTW_REDFT01; break;
-            case 4: DTT_type_x = FFTW_REDFT11; DTT_type_y = FFTW_REDFT11; break;
-			case 5: DTT_type_x = FFTW_RODFT00; DTT_type_y = FFTW_RODFT00; break;
-            case 6: DTT_type_x = FFTW_RODFT10; DTT_type_y = FFTW_RODFT10; break;
-            case 7: DTT_type_x = FFTW_RODFT01; DTT_type_y = FFTW_RODFT01; break;
-            case 8: DTT_type_x = FFTW_RODFT11; DTT_type_y = FFTW_RODFT11; break;   
-            default: mexErrMsgTxt("Input for DTT_TYPE must be an integer between 1 and 8.");
-        }            
-        
-    }
-    else if (check_el_num == 2){
-        
-        //assign x-direction
-        switch ( (int) dtt_type_pointer[0] ) {
-            case 1: DTT_type_x = FFTW_REDFT00; break;
-            case 2: DTT_type_x = FFTW_REDFT10; break;
-            case 3: DTT_type_x = FFTW_REDFT01; break;
-            case 4: DTT_type_x = FFTW_REDFT11; break;
-            case 5: DTT_type_x = FFTW_RODFT00; break;
-            case 6: DTT_type_x = FFTW_RODFT10; break;
-            case 7: DTT_type_x = FFTW_RODFT01; break;
-            case 8: DTT_type_x = FFTW_RODFT11; break;            
-            default: mexErrMsgTxt("Input for DTT_TYPE must be an integer between 1 and 8.");
-        }   
-        
-        //assign y-direction
-        switch ( (int) dtt_type_pointer[1] ) {
-            case 1: DTT_type_y = FFTW_REDFT00; break;
-            case 2: DTT_type_y = FFTW_REDFT10; break;
-            case 3: DTT_type_y = FFTW_REDFT01; break;
-            case 4: DTT_type_y = FFTW_REDFT11; break;  
-            case 5: DTT_type_y = FFTW_RODFT00; break;
-            case 6: DTT_type_y = FFTW_RODFT10; break;
-            case 7: DTT_type_y = FFTW_RODFT01; break;
-            case 8: DTT_type_y = FFTW_RODFT11; break;              
-            default: mexErrMsgTxt("Input for DTT_TYPE must be an integer between 1 and 8.");
-        }         
-        
-    }
-    else {
+    //assign DTT types, where a scalar input is used for every dimension
+    if (check_el_num != 1 && check_el_num != 2){
         mexErrMsgTxt("Input for DTT_TYPE must be scalar or length 2.");
     }
+    for (i = 0; i < 2; i++){
+        axis_kinds[i] = dtt::fftwKind((int) dtt_type_pointer[check_el_num == 1 ? 0 : i]);
+        if (axis_kinds[i] < 0){
+            mexErrMsgTxt("Input for DTT_TYPE must be an integer between 1 and 8.");
+        }
+    }
+    
+    //--------------------------------------------
+    // CHECK OPTIONAL INPUTS
+    //--------------------------------------------
+    
+    //get planner options from name/value pairs and global defaults
+    dtt::Options options = dtt::getOptions(nrhs, prhs, 2);
+    stats.enable(options.stats);
+
+    //check the number of outputs (none for in-place transforms)
+    dtt::checkOutputs(options, nlhs);
     
     //--------------------------------------------
     // CHECK AND ALLOCATE INPUT AND OUTPUT ARRAYS
     //--------------------------------------------
     
-    //check the input matrix is real and double precision
-    if( !(mxIsDouble(prhs[0]) && !mxIsComplex(prhs[0])) ) {
-        mexErrMsgTxt("Input array must be double precision and real.");
+    //check the input matrix is real and double or single precision
+    if( !((mxIsDouble(prhs[0]) || mxIsSingle(prhs[0])) && !mxIsComplex(prhs[0])) ) {
+        mexErrMsgTxt("Input array must be double or single precision and real.");
     }  
 
     //check that the input is 2D
@@ -134,35 +114,50 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
     //get the dimensions of the input array
     dims = mxGetDimensions(prhs[0]);
     numelements = mxGetNumberOfElements(prhs[0]);
-    NX = (int) dims[0];
-    NY = (int) dims[1];
              
-    //create MATLAB output
-    output_mat = plhs[0] = mxCreateNumericArray(numdims, dims, mxDOUBLE_CLASS, mxREAL);
-    
-    //get pointer to input and output arrays
-    input_ptr = (double *) mxGetPr(prhs[0]);
-    output_ptr = (double *) mxGetPr(output_mat);
-    
-    //print dimensions of the input array
-    //mexPrintf("DTT Type (%d, %d), Array Dimensions %d by %d\n", (int) dtt_type_pointer[0], (int) dtt_type_pointer[0], NX, NY);  
+    stats.mark(DTT_PHASE_VALIDATE);
+    
+    //create MATLAB output with the same precision as the input, or for
+    //in-place transforms, write the output to the input array (the output
+    //is not zero-filled as every element is written by FFTW, so the pages
+    //are first touched by the threads executing the transform)
+    input_ptr = mxGetData(prhs[0]);
+    if (options.in_place){
+        output_ptr = input_ptr;
+    } else {
+        output_mat = plhs[0] = mxCreateUninitNumericArray(numdims, dims, mxGetClassID(prhs[0]), mxREAL);
+        output_ptr = mxGetData(output_mat);
+    }
+    stats.mark(DTT_PHASE_ALLOCATE);
     
     //--------------------------------------------
-    // CREATE AND EXECUTE FFTW PLAN
+    // EXECUTE FFTW PLAN
     //--------------------------------------------    
     
-    //create FFTW plan
-    plan = fftw_plan_r2r_2d(NY, NX, (double *) input_ptr, (double *) output_ptr, DTT_type_y, DTT_type_x, FFTW_ESTIMATE);    
-    
-    //execute FFTW
-    fftw_execute(plan);    
-    
-    //--------------------------------------------
-    // CLEANUP ALLOCATED VARIABLES
-    //--------------------------------------------
-
-    //cleanup
-    fftw_destroy_plan(plan);
+    //describe the transform using guru64 dimensions, equivalent to
+    //fftw_plan_r2r_2d(NY, NX, in, out, DTT_type_y, DTT_type_x, flags)
+    //(see dttCore.h)
+    std::vector<ptrdiff_t> sz(dims, dims + numdims);
+    dtt::Transform transform = dtt::describeAxes(sz, axis_kinds);
+    
+    //execute using a cached plan (out of place unless InPlace is set), the plan
+    //is only created on the first call for a given array size, type,
+    //planner rigor, number of threads, precision, and in-place setting
+    //(for the inverse, the output is scaled by 1/M as it is computed, see
+    //dttExecute.h)
+    int threads = dtt::getThreads(options, numelements);
+    bool success;
+    if (mxIsSingle(prhs[0])){
+        success = dtt::execute(transform, (float *) input_ptr, (float *) output_ptr, options, threads);
+    } else {
+        success = dtt::execute(transform, (double *) input_ptr, (double *) output_ptr, options, threads);
+    }
+    if (!success){
+        mexErrMsgTxt("FFTW plan could not be created.");
+    }
+    stats.mark(DTT_PHASE_EXECUTE);
+    stats.addBytes(2.0 * numelements * mxGetElementSize(prhs[0]));
+    stats.finish();
     
     return;
 }
\ No newline at end of file
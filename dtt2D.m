@@ -1,3 +1,4 @@
+function varargout = dtt2D(varargin)
 %DTT2D Two-dimensional discrete trigonometric transform.
 %
 % DESCRIPTION:
@@ -13,23 +14,32 @@
 %
 %     The type of DTT is specified by the input dtt_type, where 1 to 4
 %     corresponds to DCTs, and 5 to 8 to DSTs. The transform in each
-%     direction can be specified independently. Currently, only double
-%     precisions transforms are supported, thus the input array must be in
-%     double precision.
+%     direction can be specified independently. The input array can be
+%     double or single precision, and the output has the same precision as
+%     the input. Single precision transforms use the single precision FFTW
+%     library, and require half the memory and bandwidth.
 %
 %     The DTT functions in this library create the FFTW plan using
-%     FFTW_ESTIMATE, and then destroy the plan after execution.
-%     Consequently, the performance will not match that of the inbuilt fft
-%     functions which can re-use wisdom (see help fftw).
+%     FFTW_ESTIMATE the first time a given array size and dtt_type is
+%     used. The plan is then cached and re-used by later calls with the
+%     same size and type, so repeated transforms (e.g., within a
+%     time-stepping loop) do not pay the planning cost. Cached plans are
+%     released when the mex function is cleared (e.g., using clear mex).
+%     A more rigorous planner (e.g., FFTW_MEASURE) can be selected using
+%     the optional 'Planner' input or dttOptions, and the resulting FFTW
+%     wisdom saved and re-loaded using dttWisdom.
 %
 %     For compilation instructions, see compileDttMex.
 %
 % USAGE:
 %     X = dtt2D(x, dtt_type)
-%     X = dtt2D(x, dtt_type)
+%     X = dtt2D(x, dtt_type, 'Planner', 'measure')
+%     dtt2D(x, dtt_type, 'InPlace', true)
+%     x = dtt2D(X, dtt_type, 'Inverse', true)
 %
 % INPUTS:
-%     x             - 2D array to transform in double precision.
+%     x             - 2D array to transform in double or single
+%                     precision.
 %     dtt_type      - Type of discrete trigonometric transform. This
 %                     relates to the assumed symmetry of the input x, where
 %                     the symmetry can be either whole (W) or half (H)
@@ -55,18 +65,51 @@
 %                     specified independently by specifying dtt_type as a 2
 %                     element array.
 %
+% OPTIONAL INPUTS:
+%     Optional inputs are given as name/value pairs after the other
+%     inputs. Default values for all calls can be set using dttOptions.
+%
+%     'Planner'     - Rigor used by the FFTW planner when a new plan is
+%                     created: 'estimate' (default), 'measure', 'patient',
+%                     or 'exhaustive'. 
+%     'TimeLimit'   - Approximate upper bound on the time in seconds
+%                     spent creating each plan (default = Inf).
+%     'Threads'     - Number of threads used by FFTW (default =
+%                     maxNumCompThreads for arrays with at least 65536
+%                     elements, and 1 otherwise).
+%     'InPlace'     - Boolean controlling whether the transform overwrites
+%                     the input array instead of allocating an output
+%                     (default = false), which halves the peak memory
+%                     for large arrays. The function must be called
+%                     without an output argument, and x must be a
+%                     variable that doesn't share its data with another
+%                     variable (for example, after y = x, both x and y
+%                     would be overwritten). This option can't be set
+%                     using dttOptions.
+%     'Inverse'     - Boolean controlling whether the normalised inverse
+%                     of the given dtt_type is computed (default = false),
+%                     so that dtt2D(dtt2D(x, dtt_type), dtt_type, 'Inverse',
+%                     true) returns x. The inverse uses the matching
+%                     inverse DTT (e.g., DCT-III for DCT-II), and the 1/M
+%                     normalisation (where M is the logical period of the
+%                     transform, 2(N - 1) for DCT-I, 2(N + 1) for DST-I,
+%                     and 2N otherwise, multiplied over both
+%                     dimensions) is applied as the output is
+%                     computed, rather than as a separate pass in MATLAB.
+%                     This option can't be set using dttOptions.
+%
 % OUTPUTS:
 %     X             - Discrete trigonometric transform of the input array
-%                     x.
+%                     x, returned with the same precision as x.
 %
 % ABOUT:
 %     author        - Bradley Treeby
 %     date          - 31 May 2012
-%     last update   - 19 March 2020
+%     last update   - 16 October 2026
 %
 % Copyright (C) 2012-2020 Bradley Treeby
 %
-% See also dtt1D, dtt3D
+% See also dtt1D, dtt3D, dttND, dttOptions, dttWisdom
 
 % This program is free software: you can redistribute it and/or modify it
 % under the terms of the GNU General Public License as published by the
@@ -79,4 +122,9 @@
 % Public License for more details.
 % 
 % You should have received a copy of the GNU General Public License along
-% with this program.  If not, see <https://www.gnu.org/licenses/>.
\ No newline at end of file
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+% call the function in the unified dttmex binary (if dtt2D has been
+% compiled as a separate mex function, the mex function is called
+% instead of this file, see compileDttMex)
+[varargout{1:nargout}] = dttmex('2D', varargin{:});
@@ -0,0 +1,196 @@
+/**************************************************************************
+ * MEX file to compute 3D discrete trigonometric transforms of arrays
+ * stored in files that are too large to fit in memory, using FFTW. See
+ * dtt3DFile.m for usage notes, and dttFile.h for the algorithm.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#include <string>
+#include <vector>
+#include <matrix.h>
+#include <mex.h>
+#include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttOptions.h"
+#include "dttCore.h"
+#include "dttFile.h"
+#include "dttStats.h"
+#include "dttMex.h"
+
+//get a file name input
+static std::string getFilename(const mxArray *value, const char *message){
+    if (!mxIsChar(value) || mxIsEmpty(value)){
+        mexErrMsgTxt(message);
+    }
+    char *buffer = mxArrayToString(value);
+    std::string filename(buffer);
+    mxFree(buffer);
+    return filename;
+}
+
+//get a non-negative integer option
+static double getNonNegative(const mxArray *value, const char *message){
+    double scalar;
+    if (!dtt::getScalar(value, scalar) || !(scalar >= 0) || scalar != (double) (long long) scalar){
+        mexErrMsgTxt(message);
+    }
+    return scalar;
+}
+
+DTT_MEX_FUNCTION(dtt3DFile)
+{
+
+    //--------------------------------------------
+    // DECLARE VARIABLES
+    //--------------------------------------------
+
+    ptrdiff_t dims[3] = {1, 1, 1};              // size of the array
+    std::vector<int> kinds(3, -1);              // FFTW kind for each dimension (-1 if not transformed)
+    bool single = false;                        // double precision by default
+    double memory_limit = DTT_FILE_MEMORY_LIMIT;
+    long long in_offset = 0, out_offset = 0;    // offset of the array in each file in bytes
+    int i;
+
+    //start timing the call (see dttStats.h)
+    dtt::CallStats stats("dtt3DFile");
+
+    //release cached FFTW plans when the mex file is cleared
+    dtt::atExit(dtt::clearPlanCache);
+
+    //--------------------------------------------
+    // CHECK INPUTS
+    //--------------------------------------------
+
+    //check for proper number of arguments (the result is written to the
+    //output file, so there are no outputs)
+    (void) plhs;
+    if (nrhs < 4){
+        mexErrMsgTxt("At least four inputs are required.");
+    } else if (nlhs > 0){
+        mexErrMsgTxt("Too many output arguments.");
+    }
+
+    //file names
+    std::string in_file = getFilename(prhs[0], "Input for INPUT_FILE must be a file name.");
+    std::string out_file = getFilename(prhs[1], "Input for OUTPUT_FILE must be a file name.");
+
+    //size of the array, where missing dimensions are singleton
+    if (!(mxIsDouble(prhs[2]) && !mxIsComplex(prhs[2])) || mxIsEmpty(prhs[2]) || mxGetNumberOfElements(prhs[2]) > 3){
+        mexErrMsgTxt("Input for SZ must be a vector of up to three positive integers.");
+    }
+    for (i = 0; i < (int) mxGetNumberOfElements(prhs[2]); i++){
+        double value = mxGetPr(prhs[2])[i];
+        if (!(value >= 1) || value != (double) (ptrdiff_t) value){
+            mexErrMsgTxt("Input for SZ must be a vector of up to three positive integers.");
+        }
+        dims[i] = (ptrdiff_t) value;
+    }
+
+    //DTT type for each dimension, where a scalar is used for every
+    //dimension, and 0 means the dimension is not transformed
+    if (!(mxIsDouble(prhs[3]) && !mxIsComplex(prhs[3])) || (mxGetNumberOfElements(prhs[3]) != 1 && mxGetNumberOfElements(prhs[3]) != 3)){
+        mexErrMsgTxt("Input for DTT_TYPE must be scalar or length 3.");
+    }
+    for (i = 0; i < 3; i++){
+        double dtt_type = mxGetPr(prhs[3])[mxGetNumberOfElements(prhs[3]) == 1 ? 0 : i];
+        if (dtt_type != (int) dtt_type){
+            mexErrMsgTxt("Input for DTT_TYPE must contain integers between 0 and 8.");
+        }
+        kinds[i] = (dtt_type == 0) ? -1 : dtt::fftwKind((int) dtt_type);
+        if (dtt_type != 0 && kinds[i] < 0){
+            mexErrMsgTxt("Input for DTT_TYPE must contain integers between 0 and 8.");
+        }
+    }
+
+    //--------------------------------------------
+    // CHECK OPTIONAL INPUTS
+    //--------------------------------------------
+
+    //planner options from the global defaults, and then the name/value
+    //pairs, which can also set the options for the files
+    dtt::Options options = dtt::getOptions(nrhs, prhs, nrhs);
+    if ((nrhs - 4) % 2 != 0){
+        mexErrMsgTxt("Optional inputs must be given as name/value pairs.");
+    }
+    for (i = 4; i < nrhs; i += 2){
+        char name[32];
+        if (!dtt::getString(prhs[i], name, sizeof(name))){
+            mexErrMsgTxt("Option names must be given as strings.");
+        }
+        if (dtt::equalsIgnoreCase(name, "Precision")){
+            char precision[16];
+            if (!dtt::getString(prhs[i + 1], precision, sizeof(precision))
+                    || !(dtt::equalsIgnoreCase(precision, "double") || dtt::equalsIgnoreCase(precision, "single"))){
+                mexErrMsgTxt("Value for PRECISION must be 'double' or 'single'.");
+            }
+            single = dtt::equalsIgnoreCase(precision, "single");
+        } else if (dtt::equalsIgnoreCase(name, "MemoryLimit")){
+            memory_limit = getNonNegative(prhs[i + 1], "Value for MEMORYLIMIT must be a positive integer (in bytes).");
+            if (memory_limit == 0){
+                mexErrMsgTxt("Value for MEMORYLIMIT must be a positive integer (in bytes).");
+            }
+        } else if (dtt::equalsIgnoreCase(name, "InputOffset")){
+            in_offset = (long long) getNonNegative(prhs[i + 1], "Value for INPUTOFFSET must be a non-negative integer (in bytes).");
+        } else if (dtt::equalsIgnoreCase(name, "OutputOffset")){
+            out_offset = (long long) getNonNegative(prhs[i + 1], "Value for OUTPUTOFFSET must be a non-negative integer (in bytes).");
+        } else if (dtt::equalsIgnoreCase(name, "InPlace") || dtt::equalsIgnoreCase(name, "Strategy")){
+            mexErrMsgTxt("The InPlace and Strategy options are not supported by dtt3DFile.");
+        } else {
+            dtt::setOption(options, name, prhs[i + 1]);
+        }
+    }
+    stats.enable(options.stats);
+    stats.mark(DTT_PHASE_VALIDATE);
+
+    //--------------------------------------------
+    // TRANSFORM
+    //--------------------------------------------
+
+    //transform out of core, where the plans are created and executed
+    //using the plan cache as the blocks are transformed (see dttFile.h)
+    int threads = dtt::getThreads(options, (size_t) (dims[0] * dims[1] * dims[2]));
+    int status;
+    if (single){
+        status = dtt::transformFile<float>(in_file.c_str(), in_offset, out_file.c_str(), out_offset, dims, kinds,
+                (size_t) memory_limit, options, threads);
+    } else {
+        status = dtt::transformFile<double>(in_file.c_str(), in_offset, out_file.c_str(), out_offset, dims, kinds,
+                (size_t) memory_limit, options, threads);
+    }
+    stats.mark(DTT_PHASE_EXECUTE);
+    switch (status) {
+        case DTT_FILE_ERROR_READ:
+            mexErrMsgTxt("Input file could not be opened, or is smaller than the array.");
+        case DTT_FILE_ERROR_WRITE:
+            mexErrMsgTxt("Output file could not be opened or written.");
+        case DTT_FILE_ERROR_LIMIT:
+            mexErrMsgTxt("Value for MEMORYLIMIT is too small, it must hold three xy-planes and three xz-planes of the array.");
+        case DTT_FILE_ERROR_PLAN:
+            mexErrMsgTxt("FFTW plan or buffer could not be created.");
+    }
+
+    //each pass reads and writes the whole array
+    double bytes = (double) dims[0] * dims[1] * dims[2] * (single ? sizeof(float) : sizeof(double));
+    int passes = ((kinds[0] >= 0 || kinds[1] >= 0 || in_file != out_file || in_offset != out_offset) ? 1 : 0) + (kinds[2] >= 0 ? 1 : 0);
+    stats.addBytes(2.0 * passes * bytes);
+    stats.finish();
+
+}
@@ -0,0 +1,94 @@
+function varargout = dtt3DFile(varargin)
+%DTT3DFILE Out-of-core 3D discrete trigonometric transform of a file.
+%
+% DESCRIPTION:
+%     dtt3DFile computes the three-dimensional discrete trigonometric
+%     transform (DTT) of an array stored in a file, and writes the result
+%     to an output file, without loading the whole array into memory.
+%     This allows transforms of arrays that are larger than the available
+%     memory (e.g., 2048^3 in double precision is 64 GB).
+%
+%     The transform is computed in two passes. In the first pass, the
+%     input file is read in slabs of xy-planes, and each slab is
+%     transformed in 2D and written to the output file. In the second
+%     pass, the output file is read in blocks of z-pencils (a range of
+%     y-rows across every xy-plane), and each block is transformed in 1D
+%     along z and written back in place. The array is held in three
+%     buffers, so the read of the next block and the write of the previous
+%     block overlap with the transform of the current block. The size of
+%     each block is chosen so the three buffers fit within the memory
+%     limit, which must be large enough to hold three xy-planes and three
+%     xz-planes of the array.
+%
+%     The files contain the raw array in column-major (MATLAB) order,
+%     starting at an optional byte offset, for example, written using
+%     fwrite, or a contiguous HDF5 dataset (the offset can be found using
+%     H5D.get_offset). The output file is created if it doesn't exist,
+%     otherwise the data outside the array is not modified. The input and
+%     output files can be the same file, in which case the transform is
+%     computed in place.
+%
+%     The type of DTT is specified in the same way as dtt3D, or can be 0
+%     for dimensions that are not transformed. The plans are created and
+%     cached in the same way as dtt3D.
+%
+%     For compilation instructions, see compileDttMex.
+%
+% USAGE:
+%     dtt3DFile(input_file, output_file, sz, dtt_type)
+%     dtt3DFile(..., 'MemoryLimit', 4e9)
+%     dtt3DFile(..., 'Precision', 'single')
+%     dtt3DFile(..., 'InputOffset', 512, 'OutputOffset', 512)
+%     dtt3DFile(..., 'Inverse', true)
+%
+% INPUTS:
+%     input_file    - Name of the file containing the array.
+%     output_file   - Name of the file the result is written to.
+%     sz            - Size of the array [Nx, Ny, Nz].
+%     dtt_type      - Type of discrete trigonometric transform for each
+%                     dimension, specified as an integer between 0 and 8
+%                     (see dtt3D), or a scalar to use the same type for
+%                     each dimension.
+%
+% OPTIONAL INPUTS:
+%     'MemoryLimit' - Memory used for the buffers in bytes (default 1 GB).
+%     'Precision'   - Precision of the array in the files, 'double'
+%                     (default) or 'single'.
+%     'InputOffset' - Offset of the array in the input file in bytes
+%                     (default 0).
+%     'OutputOffset'
+%                   - Offset of the array in the output file in bytes
+%                     (default 0).
+%
+%     The options 'Planner', 'TimeLimit', 'Threads', 'Inverse', and
+%     'Stats' can also be given as name/value pairs (see dtt1D). The
+%     'InPlace' and 'Strategy' options are not supported. The timing
+%     statistics are recorded as dtt3DFile (see dttStats), where the
+%     execute time includes the file access.
+%
+% ABOUT:
+%     author        - Bradley Treeby
+%     date          - 16 October 2026
+%     last update   - 16 October 2026
+%
+% Copyright (C) 2026 Bradley Treeby
+%
+% See also dtt3D, dttOptions, dttStats
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+%
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+% call the function in the unified dttmex binary (if dtt3DFile has been
+% compiled as a separate mex function, the mex function is called
+% instead of this file, see compileDttMex)
+[varargout{1:nargout}] = dttmex('3Dfile', varargin{:});
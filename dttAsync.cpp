@@ -0,0 +1,484 @@
+/**************************************************************************
+ * MEX file to compute discrete trigonometric transforms asynchronously on
+ * a pool of native worker threads. See dttAsync.m for usage notes.
+ *
+ * Submitting a transform copies the input array into an aligned buffer
+ * owned by the job, looks up or creates the FFTW plan on the MATLAB
+ * thread (the FFTW planner is not thread safe), and adds the job to a
+ * queue. A worker thread then executes the plan in place on the buffer
+ * using fftw_execute_r2r (which is thread safe), while MATLAB continues.
+ * The pool has one worker for each hardware thread, and the jobs are
+ * started in the order they are submitted while the threads used by the
+ * running jobs (the Threads option of each job) fit within the number of
+ * hardware threads, so several small transforms run concurrently, while a
+ * transform using every thread runs on its own. Each job has its own
+ * buffer, and plans are only shared between buffers with the same
+ * alignment, so concurrent jobs can execute the same plan.
+ * When the result is requested, the buffer is copied into the output
+ * array (MATLAB arrays can only be created on the MATLAB thread).
+ *
+ * The plans are created in the same way as the plans held by dttPlan
+ * handles (using the description in dttCore.h), but are kept by this
+ * file rather than in the implicit plan cache, so they cannot be evicted
+ * while a job is running. The plans are only destroyed once all of the
+ * jobs have finished (using dttAsync('clear'), or when the mex file is
+ * cleared).
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <matrix.h>
+#include <mex.h>
+#include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttOptions.h"
+#include "dttCore.h"
+#include "dttInverse.h"
+#include "dttStats.h"
+#include "dttMex.h"
+
+//maximum number of worker threads (0 to use the number of hardware
+//threads), where each job is executed by a single worker (and the FFTW
+//plan for the job can itself use multiple threads, set using the Threads
+//option)
+#ifndef DTT_ASYNC_WORKERS
+#define DTT_ASYNC_WORKERS 0
+#endif
+
+//state of a job
+#define DTT_JOB_QUEUED      0
+#define DTT_JOB_RUNNING     1
+#define DTT_JOB_DONE        2
+
+//--------------------------------------------
+// JOBS
+//--------------------------------------------
+
+//transform of a copy of the input array
+struct AsyncJob {
+    mxClassID class_id;             // precision of the array
+    std::vector<mwSize> dims;       // size of the array
+    void *data;                     // copy of the input, transformed in place
+    ptrdiff_t numel;                // number of elements
+    void *plan;                     // fftw_plan or fftwf_plan
+    double scale;                   // normalisation (1/M for inverse transforms, otherwise 1)
+    bool stats;                     // record the timing of the calls for the job
+    int threads;                    // number of threads used by the plan
+    int state;
+};
+
+//plans indexed by their description (including the alignment of the
+//buffer), shared by all jobs with the same description
+static std::map<dtt::PlanKey, void *> double_plans;
+static std::map<dtt::PlanKey, void *> float_plans;
+
+//jobs indexed by the value returned to MATLAB, and the queue of jobs
+//waiting for a worker, both protected by job_mutex
+static std::map<unsigned long long, AsyncJob *> jobs;
+static std::deque<AsyncJob *> queue;
+static unsigned long long next_job = 1;
+static std::mutex job_mutex;
+static std::condition_variable job_queued;     // signalled when a job is added to the queue
+static std::condition_variable job_done;       // signalled when a job is finished
+static std::vector<std::thread> workers;
+static bool stopping = false;
+static int thread_budget = 1;                  // hardware threads shared by the running jobs
+static int running_threads = 0;                // threads used by the running jobs
+
+//returns true if the job at the front of the queue can start, where a job
+//always starts if no other job is running
+static bool canStart(){
+    return !queue.empty() && (running_threads == 0 || running_threads + queue.front()->threads <= thread_budget);
+}
+
+//execute the jobs in the queue until stopping is set
+static void workerLoop(){
+    std::unique_lock<std::mutex> lock(job_mutex);
+    while (true){
+        job_queued.wait(lock, []{ return stopping || canStart(); });
+        if (stopping){
+            return;
+        }
+        AsyncJob *job = queue.front();
+        queue.pop_front();
+        job->state = DTT_JOB_RUNNING;
+        running_threads += job->threads;
+        lock.unlock();
+
+        //execute the plan in place on the buffer
+        if (job->class_id == mxSINGLE_CLASS){
+            float *data = (float *) job->data;
+            dtt::FftwApi<float>::executeR2r((dtt::FftwApi<float>::plan) job->plan, data, data);
+            if (job->scale != 1.0){
+                dtt::scaleArray(data, job->numel, (float) job->scale);
+            }
+        } else {
+            double *data = (double *) job->data;
+            dtt::FftwApi<double>::executeR2r((dtt::FftwApi<double>::plan) job->plan, data, data);
+            if (job->scale != 1.0){
+                dtt::scaleArray(data, job->numel, job->scale);
+            }
+        }
+
+        lock.lock();
+        job->state = DTT_JOB_DONE;
+        running_threads -= job->threads;
+        job_done.notify_all();
+
+        //the threads released may allow the next job to start
+        job_queued.notify_all();
+    }
+}
+
+//start the worker threads the first time a job is submitted
+static void startWorkers(){
+    if (!workers.empty()){
+        return;
+    }
+    int hardware = (int) std::thread::hardware_concurrency();
+    thread_budget = (hardware > 1) ? hardware : 1;
+    int num_workers = (DTT_ASYNC_WORKERS > 0 && DTT_ASYNC_WORKERS < thread_budget) ? DTT_ASYNC_WORKERS : thread_budget;
+    stopping = false;
+    running_threads = 0;
+    for (int i = 0; i < num_workers; i++){
+        workers.push_back(std::thread(workerLoop));
+    }
+}
+
+//wait for a job to finish
+static void waitForJob(AsyncJob *job){
+    std::unique_lock<std::mutex> lock(job_mutex);
+    job_done.wait(lock, [job]{ return job->state == DTT_JOB_DONE; });
+}
+
+//remove a job from the queue if it hasn't started, returns false if the
+//job is running or finished (the next job in the queue may then be able
+//to start)
+static bool dequeueJob(AsyncJob *job){
+    std::lock_guard<std::mutex> lock(job_mutex);
+    for (std::deque<AsyncJob *>::iterator it = queue.begin(); it != queue.end(); ++it){
+        if (*it == job){
+            queue.erase(it);
+            job_queued.notify_all();
+            return true;
+        }
+    }
+    return false;
+}
+
+//release a job that is not queued or running
+static void freeJob(AsyncJob *job){
+    if (job->class_id == mxSINGLE_CLASS){
+        dtt::FftwApi<float>::deallocate(job->data);
+    } else {
+        dtt::FftwApi<double>::deallocate(job->data);
+    }
+    delete job;
+}
+
+//remove a job from the queue or wait for it to finish, and release it
+static void discardJob(std::map<unsigned long long, AsyncJob *>::iterator it){
+    AsyncJob *job = it->second;
+    if (!dequeueJob(job)){
+        waitForJob(job);
+    }
+    jobs.erase(it);
+    freeJob(job);
+}
+
+//discard all jobs, stop the workers, and destroy the plans (registered
+//with dtt::atExit)
+static void clearJobs(){
+    while (!jobs.empty()){
+        discardJob(jobs.begin());
+    }
+    {
+        std::lock_guard<std::mutex> lock(job_mutex);
+        stopping = true;
+    }
+    job_queued.notify_all();
+    for (size_t i = 0; i < workers.size(); i++){
+        workers[i].join();
+    }
+    workers.clear();
+    for (std::map<dtt::PlanKey, void *>::iterator it = double_plans.begin(); it != double_plans.end(); ++it){
+        dtt::FftwApi<double>::destroyPlan((dtt::FftwApi<double>::plan) it->second);
+    }
+    for (std::map<dtt::PlanKey, void *>::iterator it = float_plans.begin(); it != float_plans.end(); ++it){
+        dtt::FftwApi<float>::destroyPlan((dtt::FftwApi<float>::plan) it->second);
+    }
+    double_plans.clear();
+    float_plans.clear();
+}
+
+//return the plan for the given description, creating it if needed
+//(returns NULL if FFTW cannot create the plan)
+template <typename T>
+static void *getPlan(std::map<dtt::PlanKey, void *> &plans, const dtt::PlanKey &key, T *data, double time_limit){
+    std::map<dtt::PlanKey, void *>::iterator it = plans.find(key);
+    if (it != plans.end()){
+        return it->second;
+    }
+    void *plan = (void *) dtt::planCache<T>().createPlan(key, data, data, time_limit);
+    if (plan != NULL){
+        plans[key] = plan;
+    }
+    return plan;
+}
+
+//find the job given as a MATLAB input
+static std::map<unsigned long long, AsyncJob *>::iterator getJob(const mxArray *value){
+    if (!(mxIsUint64(value) && mxGetNumberOfElements(value) == 1)){
+        mexErrMsgTxt("Input for JOB must be a job handle returned by dttAsync('submit', ...).");
+    }
+    std::map<unsigned long long, AsyncJob *>::iterator it = jobs.find(*((unsigned long long *) mxGetData(value)));
+    if (it == jobs.end()){
+        mexErrMsgTxt("Input for JOB is not a valid job handle (the result may have already been returned).");
+    }
+    return it;
+}
+
+//--------------------------------------------
+// COMMANDS
+//--------------------------------------------
+
+//submit a transform: job = dttAsync('submit', x, dtt_type, [dim], options...)
+static void submitJob(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]){
+
+    int DIM = 0;            // only set if the transform is along a single dimension
+    int first_option = 3;   // index of the first optional name/value input
+
+    //start timing the call (see dttStats.h)
+    dtt::CallStats stats("dttAsyncSubmit");
+
+    //check for proper number of arguments
+    if (nrhs < 3){
+        mexErrMsgTxt("At least three inputs are required to submit a transform.");
+    } else if (nlhs > 1){
+        mexErrMsgTxt("Too many output arguments.");
+    }
+
+    //check the input matrix is real and double or single precision
+    if( !((mxIsDouble(prhs[1]) || mxIsSingle(prhs[1])) && !mxIsComplex(prhs[1])) ) {
+        mexErrMsgTxt("Input array must be double or single precision and real.");
+    }
+    if (mxIsEmpty(prhs[1])){
+        mexErrMsgTxt("Input array must not be empty.");
+    }
+
+    //optional dimension for a 1D transform
+    if (nrhs > 3 && !mxIsChar(prhs[3])){
+        double value;
+        if (!dtt::getScalar(prhs[3], value) || !(value >= 1) || value != (int) value){
+            mexErrMsgTxt("Input for DIM must be a positive integer.");
+        }
+        DIM = (int) value;
+        first_option = 4;
+    }
+
+    //get planner options from name/value pairs and global defaults (the
+    //copy of the input is always transformed in place)
+    dtt::Options options = dtt::getOptions(nrhs, prhs, first_option);
+    stats.enable(options.stats);
+    if (options.in_place){
+        mexErrMsgTxt("The InPlace option is not supported by dttAsync (the transform is computed on a copy of the input).");
+    }
+
+    //DTT type for each dimension (see dttOptions.h)
+    std::vector<ptrdiff_t> sz;
+    std::vector<double> dtt_types;
+    std::vector<int> axis_kinds;
+    dtt::getAxisKinds(prhs[1], prhs[2], DIM, sz, dtt_types, axis_kinds);
+
+    //describe the transform using guru64 dimensions (as in dttPlan, see
+    //dttCore.h)
+    dtt::Transform transform = dtt::describeAxes(sz, axis_kinds);
+    dtt::PlanKey key;
+    key.dims = transform.dims;
+    key.howmany = transform.howmany;
+    key.kinds = transform.kinds;
+    double scale = options.inverse ? dtt::invertKinds(key.dims, key.kinds) : 1.0;
+    key.in_place = true;
+    key.flags = options.planner;
+    key.threads = dtt::getThreads(options, mxGetNumberOfElements(prhs[1]));
+    stats.mark(DTT_PHASE_VALIDATE);
+
+    //copy the input into an aligned buffer owned by the job (the plan
+    //never overwrites the buffer, as plans other than FFTW_ESTIMATE are
+    //created using scratch arrays, see dttPlanCache.h)
+    size_t bytes = mxGetNumberOfElements(prhs[1]) * mxGetElementSize(prhs[1]);
+    void *data = mxIsSingle(prhs[1]) ? dtt::FftwApi<float>::allocate(bytes) : dtt::FftwApi<double>::allocate(bytes);
+    if (data == NULL){
+        mexErrMsgTxt("Buffer for the copy of the input array could not be allocated.");
+    }
+    memcpy(data, mxGetData(prhs[1]), bytes);
+    stats.mark(DTT_PHASE_ALLOCATE);
+
+    //create the plan for the alignment of the buffer (on the MATLAB
+    //thread, as the FFTW planner is not thread safe)
+    key.in_align = key.out_align = dtt::alignmentOf(data);
+    void *plan;
+    if (mxIsSingle(prhs[1])){
+        plan = getPlan(float_plans, key, (float *) data, options.time_limit);
+    } else {
+        plan = getPlan(double_plans, key, (double *) data, options.time_limit);
+    }
+    stats.mark(DTT_PHASE_PLAN);
+    if (plan == NULL){
+        if (mxIsSingle(prhs[1])){
+            dtt::FftwApi<float>::deallocate(data);
+        } else {
+            dtt::FftwApi<double>::deallocate(data);
+        }
+        mexErrMsgTxt("FFTW plan could not be created.");
+    }
+
+    //add the job to the queue
+    AsyncJob *job = new AsyncJob;
+    job->class_id = mxGetClassID(prhs[1]);
+    job->dims.assign(mxGetDimensions(prhs[1]), mxGetDimensions(prhs[1]) + mxGetNumberOfDimensions(prhs[1]));
+    job->data = data;
+    job->numel = (ptrdiff_t) mxGetNumberOfElements(prhs[1]);
+    job->plan = plan;
+    job->scale = scale;
+    job->stats = options.stats;
+    job->threads = key.threads;
+    job->state = DTT_JOB_QUEUED;
+    unsigned long long value = next_job++;
+    jobs[value] = job;
+    startWorkers();
+    {
+        std::lock_guard<std::mutex> lock(job_mutex);
+        queue.push_back(job);
+    }
+    job_queued.notify_one();
+
+    //return the job handle
+    plhs[0] = mxCreateNumericMatrix(1, 1, mxUINT64_CLASS, mxREAL);
+    *((unsigned long long *) mxGetData(plhs[0])) = value;
+    stats.mark(DTT_PHASE_EXECUTE);
+    stats.addBytes((double) bytes);
+    stats.finish();
+
+}
+
+//check if a job has finished: done = dttAsync('poll', job)
+static void pollJob(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]){
+    if (nrhs != 2){
+        mexErrMsgTxt("Two inputs are required to poll a job.");
+    } else if (nlhs > 1){
+        mexErrMsgTxt("Too many output arguments.");
+    }
+    AsyncJob *job = getJob(prhs[1])->second;
+    bool done;
+    {
+        std::lock_guard<std::mutex> lock(job_mutex);
+        done = (job->state == DTT_JOB_DONE);
+    }
+    plhs[0] = mxCreateLogicalScalar(done);
+}
+
+//wait for a job to finish and return the result: X = dttAsync('wait', job)
+static void waitJob(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]){
+
+    if (nrhs != 2){
+        mexErrMsgTxt("Two inputs are required to wait for a job.");
+    } else if (nlhs > 1){
+        mexErrMsgTxt("Too many output arguments.");
+    }
+    std::map<unsigned long long, AsyncJob *>::iterator it = getJob(prhs[1]);
+    AsyncJob *job = it->second;
+
+    //start timing the call, which is recorded if the Stats option was set
+    //when the job was submitted (the time spent waiting for the worker is
+    //recorded as the execution time)
+    dtt::CallStats stats("dttAsyncWait");
+    stats.enable(job->stats);
+    stats.mark(DTT_PHASE_VALIDATE);
+    waitForJob(job);
+    stats.mark(DTT_PHASE_EXECUTE);
+
+    //copy the result into the output array and release the job
+    plhs[0] = mxCreateUninitNumericArray(job->dims.size(), &job->dims[0], job->class_id, mxREAL);
+    size_t bytes = (size_t) job->numel * mxGetElementSize(plhs[0]);
+    memcpy(mxGetData(plhs[0]), job->data, bytes);
+    jobs.erase(it);
+    freeJob(job);
+    stats.mark(DTT_PHASE_ALLOCATE);
+    stats.addBytes((double) bytes);
+    stats.finish();
+
+}
+
+//discard a job without returning the result: dttAsync('discard', job)
+static void discardCommand(int nlhs, int nrhs, const mxArray *prhs[]){
+    if (nrhs != 2){
+        mexErrMsgTxt("Two inputs are required to discard a job.");
+    } else if (nlhs > 0){
+        mexErrMsgTxt("Too many output arguments.");
+    }
+    discardJob(getJob(prhs[1]));
+}
+
+DTT_MEX_FUNCTION(dttAsync)
+{
+
+    //discard jobs, stop the workers, and destroy the plans when the mex
+    //file is cleared
+    dtt::atExit(clearJobs);
+
+    //--------------------------------------------
+    // CHECK COMMAND
+    //--------------------------------------------
+
+    char command[16];
+    if (nrhs < 1 || !dtt::getString(prhs[0], command, sizeof(command))){
+        mexErrMsgTxt("First input must be 'submit', 'poll', 'wait', 'discard', or 'clear'.");
+    }
+
+    //--------------------------------------------
+    // RUN COMMAND
+    //--------------------------------------------
+
+    if (dtt::equalsIgnoreCase(command, "submit")){
+        submitJob(nlhs, plhs, nrhs, prhs);
+    } else if (dtt::equalsIgnoreCase(command, "poll")){
+        pollJob(nlhs, plhs, nrhs, prhs);
+    } else if (dtt::equalsIgnoreCase(command, "wait")){
+        waitJob(nlhs, plhs, nrhs, prhs);
+    } else if (dtt::equalsIgnoreCase(command, "discard")){
+        discardCommand(nlhs, nrhs, prhs);
+    } else if (dtt::equalsIgnoreCase(command, "clear")){
+        if (nrhs != 1 || nlhs > 0){
+            mexErrMsgTxt("The clear command does not take any other inputs or outputs.");
+        }
+        clearJobs();
+    } else {
+        mexErrMsgTxt("First input must be 'submit', 'poll', 'wait', 'discard', or 'clear'.");
+    }
+
+}
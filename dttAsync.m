@@ -0,0 +1,107 @@
+function varargout = dttAsync(varargin)
+%DTTASYNC Compute DTTs asynchronously on native worker threads.
+%
+% DESCRIPTION:
+%     dttAsync computes discrete trigonometric transforms (DTTs) in the
+%     background, so MATLAB can continue with other work (e.g., reading
+%     the next frame of data, or post-processing the previous result)
+%     while the transform is computed. Submitting a transform copies the
+%     input array, creates or looks up the FFTW plan, and adds the
+%     transform to a queue executed by a pool of native worker threads.
+%     The returned job handle can then be polled, or waited on to return
+%     the result. For example, to overlap the transform of frame n + 1
+%     with the processing of frame n:
+%
+%         job = dttAsync('submit', frames{1}, 2);
+%         for n = 1:num_frames
+%             X = dttAsync('wait', job);
+%             if n < num_frames
+%                 job = dttAsync('submit', frames{n + 1}, 2);
+%             end
+%             process(X);
+%         end
+%
+%     The DTT type is given in the same way as dttND and dttPlan, with one
+%     type for each dimension of x (where 0 means the dimension is not
+%     transformed), or a scalar to transform every dimension (equivalent
+%     to dtt3D for 3D arrays). If dim is given, the transform is only
+%     taken along dim, equivalent to dtt1D.
+%
+%     The plans are created when the transform is submitted, and are kept
+%     until dttAsync('clear') is called or the mex function is cleared,
+%     so submitting further transforms of the same size and type only
+%     costs the copy of the input. Each job holds a copy of its input
+%     until the result is returned (or the job is discarded), and the
+%     result is copied into the output array when it is returned. Jobs
+%     are started in the order they are submitted by a pool of worker
+%     threads (one for each hardware thread, or DTT_ASYNC_WORKERS if set
+%     when compiling), where each transform can use multiple threads
+%     using the 'Threads' option. A job is started while the threads used
+%     by the running jobs fit within the number of hardware threads, so
+%     transforms using a single thread run concurrently, while a
+%     transform using every thread runs on its own.
+%
+%     For compilation instructions, see compileDttMex.
+%
+% USAGE:
+%     job = dttAsync('submit', x, dtt_type)
+%     job = dttAsync('submit', x, dtt_type, dim)
+%     job = dttAsync('submit', ..., 'Threads', 4)
+%     done = dttAsync('poll', job)
+%     X = dttAsync('wait', job)
+%     dttAsync('discard', job)
+%     dttAsync('clear')
+%
+% INPUTS:
+%     x             - Array in double or single precision (the values of
+%                     x are copied when the transform is submitted, so x
+%                     can be modified or cleared while the transform is
+%                     computed).
+%     dtt_type      - Type of discrete trigonometric transform for each
+%                     dimension of x, specified as an integer between 0
+%                     and 8 (see dttPlan).
+%     job           - Job handle returned by dttAsync('submit', ...).
+%
+% OPTIONAL INPUTS:
+%     dim           - Dimension over which a 1D transform is taken.
+%
+%     The options 'Planner', 'TimeLimit', 'Threads', 'Inverse', and
+%     'Stats' can be given as name/value pairs when submitting a
+%     transform (see dtt1D). The 'InPlace' option is not supported. The
+%     timing statistics are recorded as dttAsyncSubmit and dttAsyncWait
+%     (see dttStats), where the execute time of dttAsyncWait is the time
+%     spent waiting for the worker.
+%
+% OUTPUTS:
+%     job           - Job handle (uint64 scalar).
+%     done          - true if the transform has finished.
+%     X             - Discrete trigonometric transform of x, returned
+%                     with the same precision as x. After the result is
+%                     returned, the job handle is no longer valid.
+%
+% ABOUT:
+%     author        - Bradley Treeby
+%     date          - 16 October 2026
+%     last update   - 16 October 2026
+%
+% Copyright (C) 2026 Bradley Treeby
+%
+% See also dtt1D, dtt3D, dttND, dttOptions, dttPlan, dttStats
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+%
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+% call the function in the unified dttmex binary (if dttAsync has been
+% compiled as a separate mex function, the mex function is called
+% instead of this file, see compileDttMex)
+[varargout{1:nargout}] = dttmex('async', varargin{:});
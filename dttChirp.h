@@ -0,0 +1,499 @@
+/**************************************************************************
+ * Chirp-z (Bluestein) path for DTTs with badly factored lengths.
+ *
+ * FFTW computes each r2r transform using a real DFT of the logical length
+ * (2(N - 1) for DCT-I, 2(N + 1) for DST-I, and 2N otherwise) or of N. When
+ * this length has a large prime factor, FFTW falls back to much slower
+ * algorithms (Rader's algorithm, or O(N^2) generic codelets). For these
+ * lengths, each DTT is instead written as
+ *
+ *     Y_k = 2 sum_j w_j x_j f(pi (j + a)(k + b) / L)
+ *
+ * where f is cos (DCTs) or sin (DSTs), a and b are 0, 1/2, or 1, L is
+ * half the logical length, and the weights w_j are 1 except for the end
+ * points of DCT-I, DCT-III, and DST-III (which are 1/2). Using
+ * uv = (u^2 + v^2 - (v - u)^2) / 2 with u = j + a and v = k + b, the sum
+ * is the real (or imaginary) part of a chirp-modulated convolution
+ *
+ *     Y_k = 2 Re[c_k^* sum_j (w_j x_j c_j^*) h_{k - j}]
+ *
+ * with c_j = exp(i pi u^2 / 2L) and h_m = exp(i pi (m + b - a)^2 / 2L),
+ * which is computed using complex FFTs of the smallest length M >= 2N - 1
+ * with no prime factors above 7. The FFT of the chirp h is computed once
+ * for each transform, so each batch of lines costs one forward and one
+ * backward complex FFT of length M, both planned with the same rigor as
+ * the r2r plans.
+ *
+ * The lines are transformed in batches through a contiguous buffer owned
+ * by the plan, so the FFTW plans are created once and re-used for every
+ * array with the same transform length and batch size. The batch size is
+ * limited to the number of lines in the array, so a single line is not
+ * padded to a full batch, and when the last batch is partial, it uses a
+ * second pair of plans for the remaining lines (kept with the plan, and
+ * re-created if the remainder changes). The plans are cached separately
+ * from the r2r plans, and are destroyed by clearPlanCache.
+ *
+ * The same rule is used by gradientDtt, pstd2D, and dttPoissonSolve,
+ * which transform their lines through executeChirpLines or dtt::execute.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_CHIRP_H
+#define DTT_CHIRP_H
+
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <vector>
+#include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttCore.h"
+
+//the auto strategy uses the chirp path when the logical length has a
+//prime factor larger than this (set to 0 at compile time to disable)
+#ifndef DTT_CHIRP_MIN_FACTOR
+#define DTT_CHIRP_MIN_FACTOR 1000
+#endif
+
+//target size of the complex buffer for each thread in bytes
+#ifndef DTT_CHIRP_BATCH_BYTES
+#define DTT_CHIRP_BATCH_BYTES 1048576
+#endif
+
+//maximum number of chirp plans kept before the cache is cleared
+#ifndef DTT_CHIRP_CACHE_SIZE
+#define DTT_CHIRP_CACHE_SIZE 16
+#endif
+
+namespace dtt {
+
+//--------------------------------------------
+// LENGTHS
+//--------------------------------------------
+
+//logical length of the real DFT used by FFTW for a transform of length n
+inline ptrdiff_t logicalLength(int kind, ptrdiff_t n){
+    switch (kind) {
+        case FFTW_REDFT00: return 2 * (n - 1);
+        case FFTW_RODFT00: return 2 * (n + 1);
+        default: return 2 * n;
+    }
+}
+
+//largest prime factor of n
+inline ptrdiff_t largestPrimeFactor(ptrdiff_t n){
+    ptrdiff_t largest = 1;
+    for (ptrdiff_t p = 2; p * p <= n; p++){
+        while (n % p == 0){
+            largest = p;
+            n /= p;
+        }
+    }
+    return (n > 1) ? n : largest;
+}
+
+//smallest length at least n with no prime factors above 7, which FFTW
+//computes using its fastest codelets
+inline ptrdiff_t smoothLength(ptrdiff_t n){
+    for (ptrdiff_t m = n; ; m++){
+        ptrdiff_t r = m;
+        while (r % 2 == 0) r /= 2;
+        while (r % 3 == 0) r /= 3;
+        while (r % 5 == 0) r /= 5;
+        while (r % 7 == 0) r /= 7;
+        if (r == 1){
+            return m;
+        }
+    }
+}
+
+//returns true if the logical length of the transform of length n has a
+//prime factor larger than DTT_CHIRP_MIN_FACTOR (DCT-I requires at least
+//two points, as in FFTW)
+inline bool badlyFactored(int kind, ptrdiff_t n){
+    return n >= 2 && DTT_CHIRP_MIN_FACTOR > 0
+        && largestPrimeFactor(logicalLength(kind, n)) > DTT_CHIRP_MIN_FACTOR;
+}
+
+//returns true if the transform of length n should use the chirp path
+inline bool useChirp(const Options &options, int kind, ptrdiff_t n){
+    if (n < 2){
+        return false;
+    }
+    if (options.strategy == DTT_STRATEGY_CHIRP){
+        return true;
+    }
+    return options.strategy == DTT_STRATEGY_AUTO && badlyFactored(kind, n);
+}
+
+//--------------------------------------------
+// PLANS
+//--------------------------------------------
+
+//description of a chirp plan, used as the cache key
+struct ChirpKey {
+    int kind;
+    ptrdiff_t n;
+    ptrdiff_t lines;            // number of lines in each batch
+    unsigned flags;
+    int threads;
+};
+
+inline bool operator<(const ChirpKey &a, const ChirpKey &b){
+    if (a.kind != b.kind) return a.kind < b.kind;
+    if (a.n != b.n) return a.n < b.n;
+    if (a.lines != b.lines) return a.lines < b.lines;
+    if (a.flags != b.flags) return a.flags < b.flags;
+    return a.threads < b.threads;
+}
+
+//exp(-i pi num^2 / den) for integers num and den, where num^2 is reduced
+//modulo 2 den first so the phase is accurate for long transforms
+inline void chirpPhase(long long num, long long den, double &re, double &im){
+    const double pi = 3.14159265358979323846;
+    long long r = (num % (2 * den)) * (num % (2 * den)) % (2 * den);
+    re = std::cos(pi * (double) r / (double) den);
+    im = -std::sin(pi * (double) r / (double) den);
+}
+
+//number of lines in each batch when transforming total lines of length
+//n, where each thread is given a full batch of DTT_CHIRP_BATCH_BYTES
+template <typename T>
+inline ptrdiff_t chirpBatchLines(ptrdiff_t n, ptrdiff_t total, int threads){
+    ptrdiff_t m = smoothLength(2 * n - 1);
+    ptrdiff_t lines = DTT_CHIRP_BATCH_BYTES * (ptrdiff_t) (threads > 1 ? threads : 1) / (m * 2 * (ptrdiff_t) sizeof(T));
+    if (lines > total) lines = total;
+    return (lines > 1) ? lines : 1;
+}
+
+//plans, twiddles, and buffer for one transform length, kind, and batch
+//size, where complex values are stored as interleaved (re, im) pairs
+template <typename T>
+struct ChirpPlan {
+
+    typedef FftwApi<T> Api;
+    typedef typename Api::plan Plan;
+    typedef typename Api::complex Complex;
+
+    ptrdiff_t n;                // transform length
+    ptrdiff_t m;                // FFT length
+    ptrdiff_t lines;            // number of lines in each batch
+    bool sine;                  // take the sine (imaginary) part
+    std::vector<T> in_twiddle;  // w_j c_j^*
+    std::vector<T> out_twiddle; // 2 c_k^* / m (including the FFT normalisation)
+    std::vector<T> kernel;      // FFT of the chirp h
+    T *buffer;                  // lines by m complex values
+    Plan forward, backward;     // plans for a full batch
+    ptrdiff_t tail;             // number of lines in the remainder plans (0 if none)
+    Plan tail_forward, tail_backward;
+    unsigned flags;
+    int threads;
+    double time_limit;
+
+    ChirpPlan() : buffer(NULL), forward(NULL), backward(NULL), tail(0), tail_forward(NULL), tail_backward(NULL) {}
+    ~ChirpPlan(){
+        destroyTail();
+        if (forward != NULL) Api::destroyPlan(forward);
+        if (backward != NULL) Api::destroyPlan(backward);
+        if (buffer != NULL) Api::deallocate(buffer);
+    }
+
+    //create the forward and backward plans for count lines at the start
+    //of the buffer (the buffer is overwritten when planning with a rigor
+    //above FFTW_ESTIMATE)
+    bool planBatch(ptrdiff_t count, Plan &batch_forward, Plan &batch_backward){
+        fftw_iodim64 dim = iodim(m, 1, 1);
+        fftw_iodim64 batch = iodim(count, m, m);
+        //the number of threads is always set, as the last r2r plan may
+        //have used a different number (initialising the threads library
+        //more than once has no effect)
+        if (Api::initThreads() != 0){
+            Api::planWithNThreads(threads > 1 ? threads : 1);
+        }
+        Api::setTimeLimit(time_limit);
+        batch_forward = Api::planGuru64Dft(1, &dim, 1, &batch, (Complex *) buffer, (Complex *) buffer, FFTW_FORWARD, flags);
+        batch_backward = Api::planGuru64Dft(1, &dim, 1, &batch, (Complex *) buffer, (Complex *) buffer, FFTW_BACKWARD, flags);
+        return batch_forward != NULL && batch_backward != NULL;
+    }
+
+    void destroyTail(){
+        if (tail_forward != NULL) Api::destroyPlan(tail_forward);
+        if (tail_backward != NULL) Api::destroyPlan(tail_backward);
+        tail_forward = tail_backward = NULL;
+        tail = 0;
+    }
+
+    //create the plans for a partial batch of count lines, unless they
+    //already exist (called before the buffer is filled), returns false if
+    //the plans could not be created
+    bool prepareTail(ptrdiff_t count){
+        if (count == tail){
+            return true;
+        }
+        destroyTail();
+        if (!planBatch(count, tail_forward, tail_backward)){
+            destroyTail();
+            return false;
+        }
+        tail = count;
+        return true;
+    }
+
+    //create the plans and twiddles, returns false if the buffer could not
+    //be allocated or the plans could not be created
+    bool create(const ChirpKey &key, double time_limit){
+
+        //offsets a and b (stored as 2a and 2b), weights at the end points,
+        //and half the logical length L
+        n = key.n;
+        int a2 = 0, b2 = 0;
+        double w_first = 1.0, w_last = 1.0;
+        long long L = n;
+        sine = false;
+        switch (key.kind) {
+            case FFTW_REDFT00: L = n - 1; w_first = w_last = 0.5; break;
+            case FFTW_REDFT10: a2 = 1; break;
+            case FFTW_REDFT01: b2 = 1; w_first = 0.5; break;
+            case FFTW_REDFT11: a2 = b2 = 1; break;
+            case FFTW_RODFT00: L = n + 1; a2 = b2 = 2; sine = true; break;
+            case FFTW_RODFT10: a2 = 1; b2 = 2; sine = true; break;
+            case FFTW_RODFT01: a2 = 2; b2 = 1; w_last = 0.5; sine = true; break;
+            default: a2 = b2 = 1; sine = true; break;
+        }
+        m = smoothLength(2 * n - 1);
+
+        //the chirp phases are pi (U / 2)^2 / 2L = pi U^2 / 8L, with U = 2u
+        //an integer
+        double re, im;
+        in_twiddle.resize(2 * n);
+        out_twiddle.resize(2 * n);
+        for (ptrdiff_t j = 0; j < n; j++){
+            double w = (j == 0) ? w_first : ((j == n - 1) ? w_last : 1.0);
+            chirpPhase(2 * j + a2, 8 * L, re, im);
+            in_twiddle[2 * j] = (T) (w * re);
+            in_twiddle[2 * j + 1] = (T) (w * im);
+            chirpPhase(2 * j + b2, 8 * L, re, im);
+            out_twiddle[2 * j] = (T) (2.0 * re / (double) m);
+            out_twiddle[2 * j + 1] = (T) (2.0 * im / (double) m);
+        }
+
+        //allocate the buffer for one batch (sized by chirpBatchLines),
+        //and create the batch plans, in place in the buffer
+        lines = key.lines;
+        flags = key.flags;
+        threads = key.threads;
+        this->time_limit = time_limit;
+        buffer = (T *) Api::allocate(lines * m * 2 * sizeof(T));
+        if (buffer == NULL || !planBatch(lines, forward, backward)){
+            return false;
+        }
+
+        //FFT of the chirp h_p = exp(i pi (p + b - a)^2 / 2L) for p from
+        //-(n - 1) to n - 1, stored from index 0 so the convolution for
+        //output k is at index k + n - 1, computed using the first line of
+        //the batch plan
+        std::memset(buffer, 0, lines * m * 2 * sizeof(T));
+        for (ptrdiff_t p = -(n - 1); p <= n - 1; p++){
+            chirpPhase(2 * p + b2 - a2, 8 * L, re, im);
+            buffer[2 * (p + n - 1)] = (T) re;
+            buffer[2 * (p + n - 1) + 1] = (T) -im;
+        }
+        Api::executeDft(forward, (Complex *) buffer, (Complex *) buffer);
+        kernel.assign(buffer, buffer + 2 * m);
+        return true;
+
+    }
+
+    //transform count lines (a full batch, or the number of lines given to
+    //prepareTail), where line i starts at in_offsets[i] in the input and
+    //out_offsets[i] in the output with stride between elements, and
+    //multiply the output by scale
+    void execute(const T *in, const ptrdiff_t *in_offsets, T *out, const ptrdiff_t *out_offsets, ptrdiff_t count,
+            ptrdiff_t stride, T scale){
+
+        //modulate each line by the input chirp, and pad with zeros (when
+        //the lines are strided, the lines are adjacent in memory so the
+        //loop over the lines is inner)
+        for (ptrdiff_t i = 0; i < count; i++){
+            std::memset(buffer + 2 * (i * m + n), 0, 2 * (m - n) * sizeof(T));
+        }
+        if (stride == 1){
+            for (ptrdiff_t i = 0; i < count; i++){
+                const T *x = in + in_offsets[i];
+                T *z = buffer + 2 * i * m;
+                for (ptrdiff_t j = 0; j < n; j++){
+                    z[2 * j] = x[j] * in_twiddle[2 * j];
+                    z[2 * j + 1] = x[j] * in_twiddle[2 * j + 1];
+                }
+            }
+        } else {
+            for (ptrdiff_t j = 0; j < n; j++){
+                T tr = in_twiddle[2 * j], ti = in_twiddle[2 * j + 1];
+                for (ptrdiff_t i = 0; i < count; i++){
+                    T x = in[in_offsets[i] + j * stride];
+                    buffer[2 * (i * m + j)] = x * tr;
+                    buffer[2 * (i * m + j) + 1] = x * ti;
+                }
+            }
+        }
+
+        //convolve with the chirp h
+        bool full = (count == lines);
+        Api::executeDft(full ? forward : tail_forward, (Complex *) buffer, (Complex *) buffer);
+        for (ptrdiff_t i = 0; i < count; i++){
+            T *z = buffer + 2 * i * m;
+            for (ptrdiff_t p = 0; p < m; p++){
+                T zr = z[2 * p], zi = z[2 * p + 1];
+                T hr = kernel[2 * p], hi = kernel[2 * p + 1];
+                z[2 * p] = zr * hr - zi * hi;
+                z[2 * p + 1] = zr * hi + zi * hr;
+            }
+        }
+        Api::executeDft(full ? backward : tail_backward, (Complex *) buffer, (Complex *) buffer);
+
+        //demodulate by the output chirp and keep the real part (DCTs) or
+        //minus the imaginary part (DSTs)
+        for (ptrdiff_t i = 0; i < count; i++){
+            const T *z = buffer + 2 * (i * m + n - 1);
+            T *y = out + out_offsets[i];
+            for (ptrdiff_t k = 0; k < n; k++){
+                T zr = z[2 * k], zi = z[2 * k + 1];
+                T tr = out_twiddle[2 * k], ti = out_twiddle[2 * k + 1];
+                T value = sine ? -(zr * ti + zi * tr) : (zr * tr - zi * ti);
+                y[k * stride] = value * scale;
+            }
+        }
+
+    }
+
+};
+
+//cache of chirp plans for each precision
+template <typename T>
+inline std::map<ChirpKey, ChirpPlan<T> *> &chirpPlans(){
+    static std::map<ChirpKey, ChirpPlan<T> *> plans;
+    return plans;
+}
+
+template <typename T>
+inline void clearChirpPlans(){
+    std::map<ChirpKey, ChirpPlan<T> *> &plans = chirpPlans<T>();
+    for (typename std::map<ChirpKey, ChirpPlan<T> *>::iterator it = plans.begin(); it != plans.end(); ++it){
+        delete it->second;
+    }
+    plans.clear();
+}
+
+//destroy the chirp plans for both precisions (called by clearPlanCache)
+inline void clearChirpCache(){
+    clearChirpPlans<double>();
+    clearChirpPlans<float>();
+}
+
+//return the chirp plan matching the key, creating it if it doesn't
+//already exist (returns NULL if the plan cannot be created)
+template <typename T>
+inline ChirpPlan<T> *getChirpPlan(const ChirpKey &key, double time_limit){
+    PlanCounters &counters = planCounters();
+    double start = counters.timing ? wallTime() : 0;
+    std::map<ChirpKey, ChirpPlan<T> *> &plans = chirpPlans<T>();
+    typename std::map<ChirpKey, ChirpPlan<T> *>::iterator it = plans.find(key);
+    ChirpPlan<T> *plan = NULL;
+    if (it != plans.end()){
+        counters.hits++;
+        plan = it->second;
+    } else {
+        counters.misses++;
+        addClearFunction(clearChirpCache);
+        if (plans.size() >= DTT_CHIRP_CACHE_SIZE){
+            clearChirpPlans<T>();
+        }
+        plan = new ChirpPlan<T>();
+        if (plan->create(key, time_limit)){
+            plans[key] = plan;
+        } else {
+            delete plan;
+            plan = NULL;
+        }
+    }
+    if (counters.timing){
+        counters.time += wallTime() - start;
+    }
+    return plan;
+}
+
+//--------------------------------------------
+// EXECUTION
+//--------------------------------------------
+
+//transform the lines of length n along the middle dimension of arrays of
+//size [pre, n, post] using the chirp path, where the post index o starts
+//at o * in_dist in the input and o * out_dist in the output, and multiply
+//the output by scale, returns false if the plans could not be created (in
+//and out can be the same if in_dist is equal to out_dist)
+template <typename T>
+inline bool executeChirpLines(ptrdiff_t n, ptrdiff_t pre, ptrdiff_t post, int kind, const T *in, ptrdiff_t in_dist,
+        T *out, ptrdiff_t out_dist, double scale, const Options &options, int threads){
+    ptrdiff_t total = pre * post;
+    ChirpKey key;
+    key.kind = kind;
+    key.n = n;
+    key.lines = chirpBatchLines<T>(n, total, threads);
+    key.flags = options.planner;
+    key.threads = threads;
+    ChirpPlan<T> *plan = getChirpPlan<T>(key, options.time_limit);
+    if (plan == NULL){
+        return false;
+    }
+
+    //plans for a partial last batch
+    ptrdiff_t remainder = total % plan->lines;
+    if (remainder > 0 && !plan->prepareTail(remainder)){
+        return false;
+    }
+
+    //line l = p + pre * o starts at o * dist + p, and consecutive lines
+    //are transformed in batches
+    std::vector<ptrdiff_t> in_offsets(plan->lines), out_offsets(plan->lines);
+    for (ptrdiff_t l0 = 0; l0 < total; l0 += plan->lines){
+        ptrdiff_t count = (l0 + plan->lines < total) ? plan->lines : total - l0;
+        for (ptrdiff_t i = 0; i < count; i++){
+            ptrdiff_t p = (l0 + i) % pre, o = (l0 + i) / pre;
+            in_offsets[i] = o * in_dist + p;
+            out_offsets[i] = o * out_dist + p;
+        }
+        plan->execute(in, &in_offsets[0], out, &out_offsets[0], count, pre, (T) scale);
+    }
+    return true;
+}
+
+//transform along the middle dimension of an array of size [pre, n, post]
+//using the chirp path, and multiply the output by scale, returns false if
+//the plans could not be created (in and out can be the same)
+template <typename T>
+inline bool executeChirp(ptrdiff_t n, ptrdiff_t pre, ptrdiff_t post, int kind, const T *in, T *out, double scale,
+        const Options &options, int threads){
+    return executeChirpLines(n, pre, post, kind, in, pre * n, out, pre * n, scale, options, threads);
+}
+
+} // namespace dtt
+
+#endif
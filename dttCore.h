@@ -0,0 +1,179 @@
+/**************************************************************************
+ * Core definitions shared by the DTT library and the mex functions.
+ *
+ * This header has no dependency on MATLAB, and contains the execution
+ * options, the mapping from DTT type to FFTW r2r kind, and the shape
+ * descriptors that describe a transform of an array stored in
+ * column-major order using FFTW guru64 dimensions. The descriptors are
+ * executed by dtt::execute (see dttExecute.h), which is used by both the
+ * mex functions and the C API (see dtt.h).
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_CORE_H
+#define DTT_CORE_H
+
+#include <vector>
+#include "fftw3.h"
+#include "dttPlanCache.h"
+
+//arrays with fewer elements than this use a single thread unless the
+//number of threads is given explicitly
+#ifndef DTT_MIN_THREADED_SIZE
+#define DTT_MIN_THREADED_SIZE 65536
+#endif
+
+//execution strategy for transforms along a single dimension (see
+//dttTranspose.h, dttSmall.h, dttChirp.h, and dttGemm.h)
+#define DTT_STRATEGY_AUTO 0
+#define DTT_STRATEGY_STRIDED 1
+#define DTT_STRATEGY_TRANSPOSE 2
+#define DTT_STRATEGY_SMALL 3
+#define DTT_STRATEGY_CHIRP 4
+#define DTT_STRATEGY_GEMM 5
+
+namespace dtt {
+
+//--------------------------------------------
+// OPTIONS
+//--------------------------------------------
+
+struct Options {
+    unsigned planner;       // FFTW planner rigor flag
+    double time_limit;      // planner time limit in seconds (negative for no limit)
+    int threads;            // number of threads (0 to use the default)
+    bool in_place;          // transform the input array in place
+    int strategy;           // execution strategy for transforms along a single dimension
+    bool inverse;           // compute the normalised inverse transform
+    bool stats;             // record the timing of each phase of the call (see dttStats.h)
+};
+
+//default options
+inline Options defaultOptions(){
+    Options options;
+    options.planner = FFTW_ESTIMATE;
+    options.time_limit = FFTW_NO_TIMELIMIT;
+    options.threads = 0;
+    options.in_place = false;
+    options.strategy = DTT_STRATEGY_AUTO;
+    options.inverse = false;
+    options.stats = false;
+    return options;
+}
+
+//--------------------------------------------
+// DTT TYPES
+//--------------------------------------------
+
+//FFTW kind for each DTT type (1 to 8), returns -1 if the type is not
+//valid
+inline int fftwKind(int dtt_type){
+    switch (dtt_type) {
+        case 1: return FFTW_REDFT00;
+        case 2: return FFTW_REDFT10;
+        case 3: return FFTW_REDFT01;
+        case 4: return FFTW_REDFT11;
+        case 5: return FFTW_RODFT00;
+        case 6: return FFTW_RODFT10;
+        case 7: return FFTW_RODFT01;
+        case 8: return FFTW_RODFT11;
+        default: return -1;
+    }
+}
+
+//--------------------------------------------
+// SHAPE DESCRIPTORS
+//--------------------------------------------
+
+//description of a transform, where the transform and loop dimensions are
+//listed from the slowest to the fastest varying dimension (as in
+//fftw_plan_r2r), and transforms along a single dimension also store the
+//array as [pre, n, post]
+struct Transform {
+    std::vector<fftw_iodim64> dims;     // transform dimensions
+    std::vector<fftw_iodim64> howmany;  // loop dimensions
+    std::vector<int> kinds;             // FFTW kind for each transform dimension
+    ptrdiff_t numel;                    // number of elements in the array
+    bool single_axis;                   // transform is along a single dimension
+    ptrdiff_t n, pre, post;             // length, and product of the dimensions before and after
+};
+
+//describe the transform along dim (counting from zero) of an array with
+//size sz (fastest varying first), the transform is taken with stride
+//pre, and is looped over the dimensions before dim (stride 1) and after
+//dim (stride pre * n), so the output is in the original layout without
+//permuting the array (dimensions beyond sz are singleton, and singleton
+//loop dimensions are omitted)
+inline Transform describeAxis(const std::vector<ptrdiff_t> &sz, int dim, int kind){
+    Transform t;
+    t.single_axis = true;
+    t.n = (dim < (int) sz.size()) ? sz[dim] : 1;
+    t.pre = 1;
+    t.post = 1;
+    for (int i = 0; i < (int) sz.size(); i++){
+        if (i < dim){
+            t.pre *= sz[i];
+        } else if (i > dim){
+            t.post *= sz[i];
+        }
+    }
+    t.numel = t.pre * t.n * t.post;
+    t.dims.push_back(iodim(t.n, t.pre, t.pre));
+    if (t.pre > 1){
+        t.howmany.push_back(iodim(t.pre, 1, 1));
+    }
+    if (t.post > 1){
+        t.howmany.push_back(iodim(t.post, t.pre * t.n, t.pre * t.n));
+    }
+    t.kinds.push_back(kind);
+    return t;
+}
+
+//describe the transform of an array with size sz, where dimension i is
+//transformed using kinds[i], or is not transformed if kinds[i] < 0 (the
+//non-singleton dimensions that are not transformed become loop
+//dimensions, so batched lower rank transforms are a single plan)
+inline Transform describeAxes(const std::vector<ptrdiff_t> &sz, const std::vector<int> &kinds){
+    Transform t;
+    t.single_axis = false;
+    t.n = t.pre = t.post = 0;
+    int numaxes = (int) sz.size();
+    std::vector<ptrdiff_t> strides(numaxes);
+    ptrdiff_t stride = 1;
+    for (int i = 0; i < numaxes; i++){
+        strides[i] = stride;
+        stride *= sz[i];
+    }
+    t.numel = stride;
+    for (int i = numaxes - 1; i >= 0; i--){
+        if (kinds[i] >= 0){
+            t.dims.push_back(iodim(sz[i], strides[i], strides[i]));
+            t.kinds.push_back(kinds[i]);
+        } else if (sz[i] > 1){
+            t.howmany.push_back(iodim(sz[i], strides[i], strides[i]));
+        }
+    }
+    return t;
+}
+
+} // namespace dtt
+
+#endif
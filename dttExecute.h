@@ -0,0 +1,130 @@
+/**************************************************************************
+ * Execution of the transforms described in dttCore.h.
+ *
+ * dtt::execute selects how a transform is computed: transforms along a
+ * single dimension use the small kernels for short lengths (see
+ * dttSmall.h), the GEMM path when selected (see dttGemm.h), the chirp
+ * path for badly factored lengths (see dttChirp.h), and the transpose
+ * path for large strides (see dttTranspose.h), and all other transforms
+ * are executed as a single cached FFTW plan (see dttPlanCache.h), with
+ * the normalisation of the inverse applied as the output is computed (see
+ * dttInverse.h).
+ * Multi-dimensional transforms with a badly factored dimension are
+ * computed one dimension at a time, so that dimension can use the chirp
+ * path. This header has no dependency on MATLAB, and is used by both the
+ * mex functions and the C API (see dtt.h).
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_EXECUTE_H
+#define DTT_EXECUTE_H
+
+#include <vector>
+#include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttCore.h"
+#include "dttInverse.h"
+#include "dttTranspose.h"
+#include "dttSmall.h"
+#include "dttChirp.h"
+#include "dttGemm.h"
+
+namespace dtt {
+
+template <typename T>
+inline bool execute(const Transform &t, T *in, T *out, const Options &options, int threads);
+
+//returns true if any dimension of a multi-dimensional transform should
+//use the chirp path (only checked for the auto strategy, as the other
+//strategies apply to transforms along a single dimension)
+inline bool useChirpAxes(const Options &options, const Transform &t){
+    if (options.strategy != DTT_STRATEGY_AUTO){
+        return false;
+    }
+    for (size_t i = 0; i < t.dims.size(); i++){
+        if (useChirp(options, t.kinds[i], t.dims[i].n)){
+            return true;
+        }
+    }
+    return false;
+}
+
+//compute a multi-dimensional transform one dimension at a time, where the
+//first dimension is transformed from in to out, and the others in place
+//in out (the array is dense, as described by describeAxes, so dimension
+//i is the middle dimension of [stride, n, numel / (stride * n)])
+template <typename T>
+inline bool executeAxes(const Transform &t, T *in, T *out, const Options &options, int threads){
+    for (size_t i = 0; i < t.dims.size(); i++){
+        std::vector<ptrdiff_t> sz(3);
+        sz[0] = t.dims[i].is;
+        sz[1] = t.dims[i].n;
+        sz[2] = t.numel / (sz[0] * sz[1]);
+        if (!execute(describeAxis(sz, 1, t.kinds[i]), (i == 0) ? in : out, out, options, threads)){
+            return false;
+        }
+    }
+    return true;
+}
+
+//compute the transform t of in, and store the result in out (which can
+//be the same array) using the given options and number of threads,
+//returns false if a buffer could not be allocated or the FFTW plan could
+//not be created (the plan is only created on the first call for a given
+//array size, type, planner rigor, number of threads, precision, and
+//in-place setting)
+template <typename T>
+inline bool execute(const Transform &t, T *in, T *out, const Options &options, int threads){
+
+    //for the inverse, the kinds are replaced by their inverse, and the
+    //output is scaled by 1/M as it is computed
+    std::vector<int> kinds(t.kinds);
+    double scale = options.inverse ? invertKinds(t.dims, kinds) : 1.0;
+
+    //short transforms along a single dimension are computed using
+    //kernels specialised for each length (or as a matrix product if
+    //selected), badly factored lengths use the chirp path, and for large
+    //strides, the array is transposed in tiles through a contiguous buffer
+    if (t.single_axis){
+        if (useSmall(options, t.n)){
+            executeSmall(t.n, t.pre, t.post, kinds[0], in, out, scale, threads);
+            return true;
+        } else if (useGemm(options, t.n, t.pre * t.post)){
+            executeGemm(t.n, t.pre, t.post, kinds[0], in, out, scale, threads);
+            return true;
+        } else if (useChirp(options, kinds[0], t.n)){
+            return executeChirp(t.n, t.pre, t.post, kinds[0], in, out, scale, options, threads);
+        } else if (useTranspose(options, t.n, t.pre, t.post, sizeof(T), threads)){
+            return executeTransposed(t.n, t.pre, t.post, kinds[0], in, out, scale, options, threads);
+        }
+    } else if (useChirpAxes(options, t)){
+        return executeAxes(t, in, out, options, threads);
+    }
+
+    //otherwise execute using a single cached plan (if no dimensions are
+    //transformed, FFTW copies the input to the output)
+    return executeScaled(t.dims, t.howmany, kinds, in, out, t.numel, scale, options.planner, options.time_limit, threads);
+
+}
+
+} // namespace dtt
+
+#endif
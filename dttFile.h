@@ -0,0 +1,340 @@
+/**************************************************************************
+ * Out-of-core transforms of 3D arrays stored in files.
+ *
+ * The array is stored in a raw binary file in column-major order (native
+ * byte order, starting at a given offset in bytes, so the array can also
+ * be a contiguous dataset inside a container file such as HDF5), and the
+ * result is written to an output file with the same layout (which can be
+ * the same file). The transform is computed in two passes, using at most
+ * the given amount of memory for the buffers:
+ *
+ *     1. The array is read in slabs of whole xy-planes, the 2D transform
+ *        over x and y is computed for each slab, and the slab is written
+ *        to the output file.
+ *
+ *     2. The output file is read in blocks of whole y-rows for every z
+ *        (i.e., an Nx by Ny_block by Nz sub-array, read as Nz contiguous
+ *        chunks), the 1D transform over z is computed for each block,
+ *        and the block is written back in place.
+ *
+ * The second pass gathers the pencils along z directly from the file in
+ * chunks of Nx * Ny_block elements, which is equivalent to a blocked
+ * transpose on disk without writing a transposed copy of the array.
+ *
+ * The memory is split into three buffers, so the read of the next block
+ * and the write of the previous block (each on its own thread) overlap
+ * the transform of the current block, and for large transforms the
+ * throughput approaches the disk bandwidth. Each buffer must hold at
+ * least one xy-plane and one xz-plane of the array. The FFTW plans are
+ * created and executed on the calling thread using the plan cache (see
+ * dttPlanCache.h), and the normalisation of the inverse is split between
+ * the two passes (see dttInverse.h). This header has no dependency on
+ * MATLAB, and is used by both dtt3DFile and the C API (see dtt.h).
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_FILE_H
+#define DTT_FILE_H
+
+#include <cstdio>
+#include <cstring>
+#include <future>
+#include <vector>
+#include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttCore.h"
+#include "dttExecute.h"
+
+//default memory used for the buffers in bytes
+#ifndef DTT_FILE_MEMORY_LIMIT
+#define DTT_FILE_MEMORY_LIMIT 1073741824
+#endif
+
+//number of buffers (read, transform, and write)
+#define DTT_FILE_NUM_BUFFERS 3
+
+//status returned by transformFile
+#define DTT_FILE_SUCCESS        0   // transform computed
+#define DTT_FILE_ERROR_READ     1   // input file could not be opened or read
+#define DTT_FILE_ERROR_WRITE    2   // output file could not be opened or written
+#define DTT_FILE_ERROR_LIMIT    3   // memory limit too small for the array
+#define DTT_FILE_ERROR_PLAN     4   // FFTW plan or buffer could not be created
+
+namespace dtt {
+
+//--------------------------------------------
+// FILE ACCESS
+//--------------------------------------------
+
+//move to a 64-bit offset in bytes
+inline bool seekFile(FILE *file, long long offset){
+#ifdef _WIN32
+    return _fseeki64(file, offset, SEEK_SET) == 0;
+#else
+    return fseeko(file, (off_t) offset, SEEK_SET) == 0;
+#endif
+}
+
+//read or write count elements at the offset (in elements) from the start
+//of the array
+template <typename T>
+inline bool readChunk(FILE *file, long long start, ptrdiff_t offset, T *data, ptrdiff_t count){
+    return seekFile(file, start + (long long) offset * (long long) sizeof(T))
+            && fread(data, sizeof(T), (size_t) count, file) == (size_t) count;
+}
+
+template <typename T>
+inline bool writeChunk(FILE *file, long long start, ptrdiff_t offset, const T *data, ptrdiff_t count){
+    return seekFile(file, start + (long long) offset * (long long) sizeof(T))
+            && fwrite(data, sizeof(T), (size_t) count, file) == (size_t) count;
+}
+
+//open the output file for update, creating it if it doesn't exist (the
+//contents outside the array are not modified)
+inline FILE *openOutput(const char *filename){
+    FILE *file = fopen(filename, "r+b");
+    if (file == NULL){
+        file = fopen(filename, "wb");
+        if (file != NULL){
+            fclose(file);
+            file = fopen(filename, "r+b");
+        }
+    }
+    return file;
+}
+
+//--------------------------------------------
+// BLOCKS
+//--------------------------------------------
+
+//block of the array transformed in one step, where the block is an Nx by
+//rows by planes sub-array starting at row and plane
+struct FileBlock {
+    ptrdiff_t row, rows;        // y-rows in the block
+    ptrdiff_t plane, planes;    // z-planes in the block
+};
+
+//read or write a block, where each plane of the block is a contiguous
+//chunk of the file
+template <typename T>
+inline bool readBlock(FILE *file, long long start, const ptrdiff_t *dims, const FileBlock &b, T *data){
+    ptrdiff_t chunk = dims[0] * b.rows;
+    for (ptrdiff_t z = 0; z < b.planes; z++){
+        if (!readChunk(file, start, ((b.plane + z) * dims[1] + b.row) * dims[0], data + z * chunk, chunk)){
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+inline bool writeBlock(FILE *file, long long start, const ptrdiff_t *dims, const FileBlock &b, const T *data){
+    ptrdiff_t chunk = dims[0] * b.rows;
+    for (ptrdiff_t z = 0; z < b.planes; z++){
+        if (!writeChunk(file, start, ((b.plane + z) * dims[1] + b.row) * dims[0], data + z * chunk, chunk)){
+            return false;
+        }
+    }
+    return fflush(file) == 0;
+}
+
+//transform a block in place along the axes with kinds[i] >= 0
+template <typename T>
+inline bool transformBlock(const ptrdiff_t *dims, const FileBlock &b, const std::vector<int> &kinds, T *data,
+        const Options &options, int threads){
+    std::vector<ptrdiff_t> sz(3);
+    sz[0] = dims[0];
+    sz[1] = b.rows;
+    sz[2] = b.planes;
+    int numaxes = 0, axis = 0;
+    for (int i = 0; i < 3; i++){
+        if (kinds[i] >= 0){
+            numaxes++;
+            axis = i;
+        }
+    }
+    Transform t = (numaxes == 1) ? describeAxis(sz, axis, kinds[axis]) : describeAxes(sz, kinds);
+    return execute(t, data, data, options, threads);
+}
+
+//read, transform, and write each block, overlapping the read of the next
+//block and the write of the previous block with the transform of the
+//current block (each buffer holds buffer_size elements)
+template <typename T>
+inline int transformBlocks(const std::vector<FileBlock> &blocks, FILE *in, long long in_offset, FILE *out,
+        long long out_offset, const ptrdiff_t *dims, const std::vector<int> &kinds, std::vector<T *> &buffers,
+        const Options &options, int threads){
+
+    int num_blocks = (int) blocks.size();
+    std::vector<std::future<bool> > reads(num_blocks), writes(num_blocks);
+    int status = DTT_FILE_SUCCESS;
+
+    //read the first block
+    reads[0] = std::async(std::launch::async, readBlock<T>, in, in_offset, dims, blocks[0], buffers[0]);
+
+    for (int i = 0; i < num_blocks; i++){
+
+        //wait for the read of this block
+        T *data = buffers[i % DTT_FILE_NUM_BUFFERS];
+        if (!reads[i].get()){
+            status = DTT_FILE_ERROR_READ;
+            break;
+        }
+
+        //start reading the next block (the buffer for the next block was
+        //last used by block i - 2, which has already been written)
+        if (i + 1 < num_blocks){
+            reads[i + 1] = std::async(std::launch::async, readBlock<T>, in, in_offset, dims, blocks[i + 1],
+                    buffers[(i + 1) % DTT_FILE_NUM_BUFFERS]);
+        }
+
+        //transform this block
+        if (!transformBlock(dims, blocks[i], kinds, data, options, threads)){
+            status = DTT_FILE_ERROR_PLAN;
+            break;
+        }
+
+        //start writing this block once the previous block has been
+        //written (so only one thread writes to the output file)
+        if (i > 0 && !writes[i - 1].get()){
+            status = DTT_FILE_ERROR_WRITE;
+            break;
+        }
+        writes[i] = std::async(std::launch::async, writeBlock<T>, out, out_offset, dims, blocks[i], (const T *) data);
+
+    }
+
+    //wait for any reads and writes still running
+    for (int i = 0; i < num_blocks; i++){
+        if (reads[i].valid()){
+            reads[i].wait();
+        }
+        if (writes[i].valid() && !writes[i].get() && status == DTT_FILE_SUCCESS){
+            status = DTT_FILE_ERROR_WRITE;
+        }
+    }
+    return status;
+
+}
+
+//--------------------------------------------
+// TRANSFORM
+//--------------------------------------------
+
+//transform the 3D array with size dims stored in in_file (starting at
+//in_offset bytes), and write the result to out_file (starting at
+//out_offset bytes), where kinds[i] is the FFTW kind for dimension i (-1
+//if the dimension is not transformed), using at most memory_limit bytes
+//for the buffers, returns one of the DTT_FILE status codes
+template <typename T>
+inline int transformFile(const char *in_file, long long in_offset, const char *out_file, long long out_offset,
+        const ptrdiff_t *dims, const std::vector<int> &kinds, size_t memory_limit, const Options &options,
+        int threads){
+
+    //size of each buffer, which must hold at least one xy-plane and one
+    //xz-plane
+    ptrdiff_t buffer_size = (ptrdiff_t) (memory_limit / (DTT_FILE_NUM_BUFFERS * sizeof(T)));
+    if (buffer_size < dims[0] * dims[1] || buffer_size < dims[0] * dims[2]){
+        return DTT_FILE_ERROR_LIMIT;
+    }
+    bool same_file = (strcmp(in_file, out_file) == 0) && (in_offset == out_offset);
+    bool xy = (kinds[0] >= 0 || kinds[1] >= 0);
+    bool z = (kinds[2] >= 0);
+
+    //allocate the buffers
+    std::vector<T *> buffers(DTT_FILE_NUM_BUFFERS, (T *) NULL);
+    for (int i = 0; i < DTT_FILE_NUM_BUFFERS; i++){
+        buffers[i] = (T *) FftwApi<T>::allocate(buffer_size * sizeof(T));
+        if (buffers[i] == NULL){
+            for (int j = 0; j < i; j++){
+                FftwApi<T>::deallocate(buffers[j]);
+            }
+            return DTT_FILE_ERROR_PLAN;
+        }
+    }
+
+    int status = DTT_FILE_SUCCESS;
+    FILE *in = NULL, *out = NULL;
+
+    //first pass, transform over x and y in slabs of xy-planes (or copy
+    //the input to the output if x and y are not transformed)
+    if (xy || !same_file){
+        ptrdiff_t planes = buffer_size / (dims[0] * dims[1]);
+        std::vector<FileBlock> blocks;
+        for (ptrdiff_t plane = 0; plane < dims[2]; plane += planes){
+            FileBlock b = {0, dims[1], plane, (plane + planes < dims[2]) ? planes : dims[2] - plane};
+            blocks.push_back(b);
+        }
+        std::vector<int> slab_kinds(kinds);
+        slab_kinds[2] = -1;
+        in = fopen(in_file, "rb");
+        out = openOutput(out_file);
+        if (in == NULL){
+            status = DTT_FILE_ERROR_READ;
+        } else if (out == NULL){
+            status = DTT_FILE_ERROR_WRITE;
+        } else {
+            status = transformBlocks(blocks, in, in_offset, out, out_offset, dims, slab_kinds, buffers, options, threads);
+        }
+        if (in != NULL) fclose(in);
+        if (out != NULL && fclose(out) != 0 && status == DTT_FILE_SUCCESS){
+            status = DTT_FILE_ERROR_WRITE;
+        }
+    }
+
+    //second pass, transform over z in place in blocks of y-rows for every
+    //z-plane
+    if (z && status == DTT_FILE_SUCCESS){
+        ptrdiff_t rows = buffer_size / (dims[0] * dims[2]);
+        std::vector<FileBlock> blocks;
+        for (ptrdiff_t row = 0; row < dims[1]; row += rows){
+            FileBlock b = {row, (row + rows < dims[1]) ? rows : dims[1] - row, 0, dims[2]};
+            blocks.push_back(b);
+        }
+        std::vector<int> pencil_kinds(3, -1);
+        pencil_kinds[2] = kinds[2];
+        const char *source = (xy || !same_file) ? out_file : in_file;
+        long long source_offset = (xy || !same_file) ? out_offset : in_offset;
+        in = fopen(source, "rb");
+        out = openOutput(out_file);
+        if (in == NULL){
+            status = DTT_FILE_ERROR_READ;
+        } else if (out == NULL){
+            status = DTT_FILE_ERROR_WRITE;
+        } else {
+            status = transformBlocks(blocks, in, source_offset, out, out_offset, dims, pencil_kinds, buffers, options, threads);
+        }
+        if (in != NULL) fclose(in);
+        if (out != NULL && fclose(out) != 0 && status == DTT_FILE_SUCCESS){
+            status = DTT_FILE_ERROR_WRITE;
+        }
+    }
+
+    for (int i = 0; i < DTT_FILE_NUM_BUFFERS; i++){
+        FftwApi<T>::deallocate(buffers[i]);
+    }
+    return status;
+
+}
+
+} // namespace dtt
+
+#endif
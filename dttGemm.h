@@ -0,0 +1,434 @@
+/**************************************************************************
+ * Matrix multiply (GEMM) path for large batches of short DTTs.
+ *
+ * For a tall-skinny array (e.g., 8 to 48 rows and millions of columns),
+ * FFTW computes each short column separately, as do the small kernels in
+ * dttSmall.h. Here, the whole batch is instead
+ * computed as one dense matrix product with the N by N transform matrix
+ * (see smallMatrix in dttSmall.h), i.e., Y = C X for contiguous columns
+ * (dim = 1), or Y = X C^T for each [pre, n] slab of strided lines
+ * (dim > 1).
+ *
+ * The product is computed in blocks of lines sized to fit in cache,
+ * using a register-blocked kernel (tiles of DTT_GEMM_MR rows by
+ * DTT_GEMM_NR columns are accumulated in registers while the inner
+ * dimension is traversed), and the blocks are divided between the
+ * persistent worker threads in dttThreads.h. Each thread packs the
+ * operands into a workspace that is kept between calls. As for the small
+ * kernels, the kernel is compiled for the baseline instruction set, AVX2
+ * with FMA, and AVX-512, and selected at run time based on the CPU.
+ *
+ * The auto strategy uses the GEMM path for batches of at least
+ * DTT_GEMM_MIN_LINES transforms with lengths above DTT_SMALL_MAX_N (which
+ * use the small kernels) up to DTT_GEMM_MAX_N. Measured against FFTW 3.3
+ * on a single thread (DCT-II of 2^22 elements), the GEMM path was 1.1 to
+ * 2.6x faster than FFTW_ESTIMATE for lengths 36 to 56, as contiguous
+ * columns or strided lines, in both precisions, but slower than
+ * FFTW_MEASURE for length 64. The thresholds can be changed at compile
+ * time after checking the crossover using benchmarks/benchmark_gemm.m.
+ * When selected using the 'gemm' strategy, lengths up to
+ * DTT_GEMM_MAX_FORCED_N use the GEMM path, and longer lengths use FFTW.
+ *
+ * Alternatively, the product can be computed using an external BLAS by
+ * compiling with -DDTT_USE_BLAS and linking to the library (e.g.,
+ * -lopenblas, or -lmwblas -DDTT_BLAS_INT=ptrdiff_t for the BLAS included
+ * with MATLAB). Each block is then computed using a single call to
+ * dgemm or sgemm from the calling thread, so the BLAS library controls
+ * the threading.
+ *
+ * When the input and output are the same array, each block of the input
+ * is copied to a buffer before the product is computed.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_GEMM_H
+#define DTT_GEMM_H
+
+#include <cstring>
+#include <vector>
+#include "dttCore.h"
+#include "dttSmall.h"
+#include "dttThreads.h"
+
+//transforms up to this length use the GEMM path automatically for large
+//batches (when not using the small kernels), 0 to only use the GEMM path
+//when selected using the 'gemm' strategy (the matrix product costs 2N
+//flops per point, so long transforms are always faster using FFTW)
+#ifndef DTT_GEMM_MAX_N
+#define DTT_GEMM_MAX_N 56
+#endif
+
+//longest transform computed using the GEMM path when it is selected
+//using the 'gemm' strategy, longer transforms use FFTW (the matrix has
+//N^2 elements, so this bounds the memory used)
+#ifndef DTT_GEMM_MAX_FORCED_N
+#define DTT_GEMM_MAX_FORCED_N 1024
+#endif
+
+//minimum number of lines for the auto strategy to use the GEMM path
+#ifndef DTT_GEMM_MIN_LINES
+#define DTT_GEMM_MIN_LINES 4096
+#endif
+
+//target size of each block of the input in bytes
+#ifndef DTT_GEMM_BLOCK_BYTES
+#define DTT_GEMM_BLOCK_BYTES 65536
+#endif
+
+//size of the register tile (DTT_GEMM_MR is given in bytes, so the tile
+//holds 8 doubles or 16 floats in each column)
+#define DTT_GEMM_MR 64
+#define DTT_GEMM_NR 6
+
+//external BLAS, where the integer type and symbol names can be changed
+//to match the library
+#ifdef DTT_USE_BLAS
+#ifndef DTT_BLAS_INT
+#define DTT_BLAS_INT int
+#endif
+#ifndef DTT_BLAS_FUNCTION
+#if defined(_WIN32)
+#define DTT_BLAS_FUNCTION(name) name
+#else
+#define DTT_BLAS_FUNCTION(name) name##_
+#endif
+#endif
+extern "C" {
+void DTT_BLAS_FUNCTION(dgemm)(const char *transa, const char *transb, const DTT_BLAS_INT *m, const DTT_BLAS_INT *n,
+        const DTT_BLAS_INT *k, const double *alpha, const double *a, const DTT_BLAS_INT *lda, const double *b,
+        const DTT_BLAS_INT *ldb, const double *beta, double *c, const DTT_BLAS_INT *ldc);
+void DTT_BLAS_FUNCTION(sgemm)(const char *transa, const char *transb, const DTT_BLAS_INT *m, const DTT_BLAS_INT *n,
+        const DTT_BLAS_INT *k, const float *alpha, const float *a, const DTT_BLAS_INT *lda, const float *b,
+        const DTT_BLAS_INT *ldb, const float *beta, float *c, const DTT_BLAS_INT *ldc);
+}
+#endif
+
+namespace dtt {
+
+//--------------------------------------------
+// KERNELS
+//--------------------------------------------
+
+//accumulate a tile of DTT_GEMM_MR bytes by DTT_GEMM_NR columns over the
+//inner dimension k, where column j of the tile of A starts at a + j * lda,
+//and row j of the panel of B is b[j * NR] to b[j * NR + NR - 1] (with
+//GCC or Clang, each column of the tile is held in one vector register,
+//or two for AVX2)
+template <typename T>
+DTT_SMALL_INLINE void gemmTile(ptrdiff_t k, const T *a, ptrdiff_t lda, const T *b, T *tile){
+    const int NR = DTT_GEMM_NR;
+#ifdef __GNUC__
+    typedef T Vector __attribute__((vector_size(DTT_GEMM_MR)));
+    Vector acc[NR];
+    for (int c = 0; c < NR; c++){
+        acc[c] = Vector();
+    }
+    for (ptrdiff_t j = 0; j < k; j++){
+        Vector x;
+        std::memcpy(&x, a + j * lda, sizeof(Vector));
+    #pragma GCC unroll 8
+        for (int c = 0; c < NR; c++){
+            acc[c] += x * b[j * NR + c];
+        }
+    }
+    std::memcpy(tile, acc, sizeof(acc));
+#else
+    const int MR = DTT_GEMM_MR / sizeof(T);
+    for (int i = 0; i < NR * MR; i++){
+        tile[i] = 0;
+    }
+    for (ptrdiff_t j = 0; j < k; j++){
+        for (int c = 0; c < NR; c++){
+            T bj = b[j * NR + c];
+            for (int i = 0; i < MR; i++){
+                tile[c * MR + i] += a[j * lda + i] * bj;
+            }
+        }
+    }
+#endif
+}
+
+//number of elements of the workspace used by gemmImpl for inner
+//dimension k
+template <typename T>
+inline ptrdiff_t gemmWorkSize(ptrdiff_t k){
+    return k * (DTT_GEMM_MR / sizeof(T) + DTT_GEMM_NR);
+}
+
+//compute Y(i, c) = alpha sum_j A(i, j) B(j, c) for an m by nc output and
+//inner dimension k, where A(i, j) = A[i + j * lda], B(j, c) = B[j * brs +
+//c * bcs], and Y(i, c) = Y[i + c * ldy] (Y must not overlap A or B), and
+//work holds gemmWorkSize(k) elements
+template <typename T>
+DTT_SMALL_INLINE void gemmImpl(ptrdiff_t m, ptrdiff_t nc, ptrdiff_t k, T alpha, const T *A, ptrdiff_t lda,
+        const T *B, ptrdiff_t brs, ptrdiff_t bcs, T *Y, ptrdiff_t ldy, T *work){
+    const int MR = DTT_GEMM_MR / sizeof(T);
+    const int NR = DTT_GEMM_NR;
+    T tile[NR * MR];
+    T *edge = work;
+    T *panel = work + k * MR;
+
+    //copy the last rows of A to a panel padded with zeros if m is not a
+    //multiple of the tile size
+    ptrdiff_t full = m - m % MR;
+    for (ptrdiff_t j = 0; j < k && m > full; j++){
+        for (ptrdiff_t i = 0; i < MR; i++){
+            edge[j * MR + i] = (full + i < m) ? A[full + i + j * lda] : 0;
+        }
+    }
+
+    for (ptrdiff_t c0 = 0; c0 < nc; c0 += NR){
+        ptrdiff_t w = (c0 + NR < nc) ? NR : nc - c0;
+
+        //copy NR columns of B to a contiguous panel (padded with zeros)
+        for (ptrdiff_t j = 0; j < k; j++){
+            for (ptrdiff_t c = 0; c < NR; c++){
+                panel[j * NR + c] = (c < w) ? B[j * brs + (c0 + c) * bcs] : 0;
+            }
+        }
+        for (ptrdiff_t i0 = 0; i0 < m; i0 += MR){
+            ptrdiff_t h = (i0 + MR < m) ? MR : m - i0;
+            if (i0 < full){
+                gemmTile<T>(k, A + i0, lda, panel, tile);
+            } else {
+                gemmTile<T>(k, edge, MR, panel, tile);
+            }
+            for (ptrdiff_t c = 0; c < w; c++){
+                T *y = Y + i0 + (c0 + c) * ldy;
+                for (ptrdiff_t i = 0; i < h; i++){
+                    y[i] = tile[c * MR + i] * alpha;
+                }
+            }
+        }
+    }
+}
+
+//kernel signature
+template <typename T>
+struct GemmKernel {
+    typedef void (*kernel)(ptrdiff_t m, ptrdiff_t nc, ptrdiff_t k, T alpha, const T *A, ptrdiff_t lda,
+            const T *B, ptrdiff_t brs, ptrdiff_t bcs, T *Y, ptrdiff_t ldy, T *work);
+};
+
+//compiled versions of the kernel for the baseline instruction set, and
+//(if dispatch is enabled) AVX2 and AVX-512
+template <typename T>
+void gemm(ptrdiff_t m, ptrdiff_t nc, ptrdiff_t k, T alpha, const T *A, ptrdiff_t lda,
+        const T *B, ptrdiff_t brs, ptrdiff_t bcs, T *Y, ptrdiff_t ldy, T *work){
+    gemmImpl<T>(m, nc, k, alpha, A, lda, B, brs, bcs, Y, ldy, work);
+}
+
+#ifdef DTT_SMALL_DISPATCH
+template <typename T>
+__attribute__((target("avx2,fma"))) void gemmAvx2(ptrdiff_t m, ptrdiff_t nc, ptrdiff_t k, T alpha, const T *A, ptrdiff_t lda,
+        const T *B, ptrdiff_t brs, ptrdiff_t bcs, T *Y, ptrdiff_t ldy, T *work){
+    gemmImpl<T>(m, nc, k, alpha, A, lda, B, brs, bcs, Y, ldy, work);
+}
+template <typename T>
+__attribute__((target("avx512f"))) void gemmAvx512(ptrdiff_t m, ptrdiff_t nc, ptrdiff_t k, T alpha, const T *A, ptrdiff_t lda,
+        const T *B, ptrdiff_t brs, ptrdiff_t bcs, T *Y, ptrdiff_t ldy, T *work){
+    gemmImpl<T>(m, nc, k, alpha, A, lda, B, brs, bcs, Y, ldy, work);
+}
+#endif
+
+//the product computed using an external BLAS, where B is either B or B^T
+//stored by columns (the workspace is not used)
+#ifdef DTT_USE_BLAS
+inline void gemmBlas(ptrdiff_t m, ptrdiff_t nc, ptrdiff_t k, double alpha, const double *A, ptrdiff_t lda,
+        const double *B, ptrdiff_t brs, ptrdiff_t bcs, double *Y, ptrdiff_t ldy, double *){
+    char transa = 'N', transb = (brs == 1) ? 'N' : 'T';
+    DTT_BLAS_INT M = m, N = nc, K = k, LDA = lda, LDB = (brs == 1) ? bcs : brs, LDY = ldy;
+    double beta = 0;
+    DTT_BLAS_FUNCTION(dgemm)(&transa, &transb, &M, &N, &K, &alpha, A, &LDA, B, &LDB, &beta, Y, &LDY);
+}
+inline void gemmBlas(ptrdiff_t m, ptrdiff_t nc, ptrdiff_t k, float alpha, const float *A, ptrdiff_t lda,
+        const float *B, ptrdiff_t brs, ptrdiff_t bcs, float *Y, ptrdiff_t ldy, float *){
+    char transa = 'N', transb = (brs == 1) ? 'N' : 'T';
+    DTT_BLAS_INT M = m, N = nc, K = k, LDA = lda, LDB = (brs == 1) ? bcs : brs, LDY = ldy;
+    float beta = 0;
+    DTT_BLAS_FUNCTION(sgemm)(&transa, &transb, &M, &N, &K, &alpha, A, &LDA, B, &LDB, &beta, Y, &LDY);
+}
+#endif
+
+//return the kernel for the instruction set supported by the CPU
+template <typename T>
+inline typename GemmKernel<T>::kernel gemmKernel(){
+#if defined(DTT_USE_BLAS)
+    return &gemmBlas;
+#else
+#ifdef DTT_SMALL_DISPATCH
+    if (smallIsa() == DTT_ISA_AVX512){
+        return &gemmAvx512<T>;
+    } else if (smallIsa() == DTT_ISA_AVX2){
+        return &gemmAvx2<T>;
+    }
+#endif
+    return &gemm<T>;
+#endif
+}
+
+//--------------------------------------------
+// EXECUTION
+//--------------------------------------------
+
+//workspaces for each part of a call (see dttThreads.h), which are kept
+//between calls
+template <typename T>
+inline std::vector<std::vector<T> > &gemmWorkspaces(){
+    static std::vector<std::vector<T> > workspaces;
+    return workspaces;
+}
+
+//free the workspaces for both precisions (called by clearPlanCache)
+inline void clearGemmWorkspaces(){
+    std::vector<std::vector<double> >().swap(gemmWorkspaces<double>());
+    std::vector<std::vector<float> >().swap(gemmWorkspaces<float>());
+}
+
+//make sure there is a workspace of at least size elements for each of
+//the given number of parts
+template <typename T>
+inline void reserveGemmWorkspaces(int parts, ptrdiff_t size){
+    std::vector<std::vector<T> > &workspaces = gemmWorkspaces<T>();
+    addClearFunction(clearGemmWorkspaces);
+    if ((int) workspaces.size() < parts){
+        workspaces.resize(parts);
+    }
+    for (int i = 0; i < parts; i++){
+        if ((ptrdiff_t) workspaces[i].size() < size){
+            workspaces[i].resize(size);
+        }
+    }
+}
+
+//returns true if the transform of length n should use the GEMM path,
+//where lines is the number of transforms (DCT-I requires at least two
+//points, as in FFTW)
+inline bool useGemm(const Options &options, ptrdiff_t n, ptrdiff_t lines){
+    if (n < 2 || n > DTT_GEMM_MAX_FORCED_N){
+        return false;
+    }
+    if (options.strategy == DTT_STRATEGY_GEMM){
+        return true;
+    }
+    return options.strategy == DTT_STRATEGY_AUTO && n <= DTT_GEMM_MAX_N && lines >= DTT_GEMM_MIN_LINES;
+}
+
+//blocks of lines for a transform along the middle dimension of an array
+//of size [pre, n, post], where each block is either a range of columns
+//(pre = 1) or a range of rows of one [pre, n] slab (pre > 1)
+template <typename T>
+struct GemmBlocks {
+    const T *C;
+    ptrdiff_t n, pre, post;
+    const T *in;
+    T *out;
+    T scale;
+    ptrdiff_t block;        // lines in each block
+    ptrdiff_t per_slab;     // blocks in each slab (pre > 1)
+    ptrdiff_t count;        // total number of blocks
+
+    //number of elements of the workspace used by each part
+    ptrdiff_t workSize() const {
+        return gemmWorkSize<T>(n) + ((in == out) ? n * block : 0);
+    }
+
+    //transform blocks first to last - 1, where the workspace for the part
+    //holds the packed operands, and a copy of each block if in and out
+    //are the same
+    void execute(int part, ptrdiff_t first, ptrdiff_t last) const {
+        typename GemmKernel<T>::kernel kernel = gemmKernel<T>();
+        T *work = &gemmWorkspaces<T>()[part][0];
+        T *buffer = work + gemmWorkSize<T>(n);
+        for (ptrdiff_t b = first; b < last; b++){
+            if (pre == 1){
+                //Y = C X for columns b * block onwards
+                ptrdiff_t b0 = b * block;
+                ptrdiff_t w = (b0 + block < post) ? block : post - b0;
+                const T *x = in + b0 * n;
+                if (in == out){
+                    std::memcpy(buffer, x, n * w * sizeof(T));
+                    x = buffer;
+                }
+                kernel(n, w, n, scale, C, n, x, 1, n, out + b0 * n, n, work);
+            } else {
+                //Y = X C^T for rows p0 onwards of slab o
+                ptrdiff_t o = b / per_slab, p0 = (b % per_slab) * block;
+                ptrdiff_t h = (p0 + block < pre) ? block : pre - p0;
+                const T *x = in + o * pre * n + p0;
+                ptrdiff_t ldx = pre;
+                if (in == out){
+                    for (ptrdiff_t j = 0; j < n; j++){
+                        std::memcpy(buffer + j * h, x + j * pre, h * sizeof(T));
+                    }
+                    x = buffer;
+                    ldx = h;
+                }
+                kernel(h, n, n, scale, x, ldx, C, n, 1, out + o * pre * n + p0, pre, work);
+            }
+        }
+    }
+};
+
+template <typename T>
+inline void executeGemmBlocks(const void *blocks, int part, ptrdiff_t first, ptrdiff_t last){
+    static_cast<const GemmBlocks<T> *>(blocks)->execute(part, first, last);
+}
+
+//transform along the middle dimension of an array of size [pre, n, post]
+//using the GEMM path, and multiply the output by scale (in and out can be
+//the same)
+template <typename T>
+inline void executeGemm(ptrdiff_t n, ptrdiff_t pre, ptrdiff_t post, int kind, const T *in, T *out, double scale, int threads){
+    GemmBlocks<T> blocks;
+    blocks.C = smallMatrix<T>(kind, n);
+    blocks.n = n;
+    blocks.pre = pre;
+    blocks.post = post;
+    blocks.in = in;
+    blocks.out = out;
+    blocks.scale = (T) scale;
+
+    //size the blocks to fit in cache, or with an external BLAS, use the
+    //largest blocks possible unless the input must be copied
+    ptrdiff_t lines = (pre == 1) ? post : pre;
+    blocks.block = DTT_GEMM_BLOCK_BYTES / (n * (ptrdiff_t) sizeof(T));
+#ifdef DTT_USE_BLAS
+    if (in != out){
+        blocks.block = lines;
+    }
+    threads = 1;
+#endif
+    if (blocks.block < 1) blocks.block = 1;
+    if (blocks.block > lines) blocks.block = lines;
+    blocks.per_slab = (lines + blocks.block - 1) / blocks.block;
+    blocks.count = (pre == 1) ? blocks.per_slab : blocks.per_slab * post;
+
+    //divide the blocks between the worker threads (see dttThreads.h)
+    if (threads > blocks.count) threads = (int) blocks.count;
+    if (threads < 1) threads = 1;
+    reserveGemmWorkspaces<T>(threads, blocks.workSize());
+    parallelFor(executeGemmBlocks<T>, &blocks, blocks.count, threads);
+}
+
+} // namespace dtt
+
+#endif
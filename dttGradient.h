@@ -0,0 +1,303 @@
+/**************************************************************************
+ * Spectral gradient calculation using discrete trigonometric transforms,
+ * shared by the gradientDtt and pstd2D mex functions.
+ *
+ * The gradient along one dimension of an array is computed using the
+ * steps in gradientDtt1D.m: a forward transform, multiplication by the
+ * wavenumbers, trimming or padding the basis function weights based on
+ * the symmetry of the output, an inverse transform, and normalisation.
+ *
+ * The forward transform is written into a workspace line of length
+ * Nx + 2 (starting at index 1), so the values prepended or appended
+ * before the inverse transform are the zeros at either end of the line,
+ * and the values removed are skipped by offsetting the start of the
+ * inverse transform. The wavenumbers, the normalisation, and any other
+ * constant factor are combined into a single scaling pass. If the output
+ * doesn't require any values to be removed, the inverse transform is
+ * written directly into the output array, otherwise it is computed in
+ * place and copied. Both transforms use the chirp path in dttChirp.h for
+ * badly factored lengths (as for the auto strategy of dtt1D).
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_GRADIENT_H
+#define DTT_GRADIENT_H
+
+#include <vector>
+#include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttCore.h"
+#include "dttChirp.h"
+
+//values added at the ends of the output to align it with the input
+#define DTT_ALIGN_NONE      0   // no value added
+#define DTT_ALIGN_ZERO      1   // zero
+#define DTT_ALIGN_MIRROR    2   // negative of the adjacent value
+
+namespace dtt {
+
+//--------------------------------------------
+// GRADIENT DESCRIPTION
+//--------------------------------------------
+
+//description of the gradient calculation for a given DTT type and shift
+struct Gradient {
+    int forward_kind;       // fftw_r2r_kind of the forward transform
+    int inverse_kind;       // fftw_r2r_kind of the inverse transform
+    int start;              // start of the inverse transform in the workspace line
+    ptrdiff_t L;            // length of the inverse transform
+    int head;               // value prepended to the output
+    int tail;               // value appended to the output
+    int drop_first;         // remove the first value of the inverse transform
+    int drop_last;          // remove the last value of the inverse transform
+    ptrdiff_t num_out;      // length of the output
+};
+
+//set the alignment of the output
+inline void setAlign(Gradient &g, int head, int drop_first, int drop_last, int tail){
+    g.head = head;
+    g.drop_first = drop_first;
+    g.drop_last = drop_last;
+    g.tail = tail;
+}
+
+//describe the gradient calculation (see gradientDtt1D.m for the
+//derivation of each case), the forward transform is stored at indices
+//1 to Nx of a workspace line of length Nx + 2
+inline Gradient describeGradient(int dtt_type, int shift, bool align_output, ptrdiff_t Nx){
+
+    Gradient g;
+
+    //select the range of the inverse transform, and the type of inverse
+    //transform used
+    g.start = 1;
+    g.L = Nx;
+    switch (dtt_type) {
+        case 1:
+            //WSWS -> HAHA (S2^-1 = S3) remove left endpoint, or
+            //WSWS -> WAWA (S1^-1 = S1) remove both endpoints
+            g.start = 2;
+            g.L = shift ? Nx - 1 : Nx - 2;
+            g.inverse_kind = shift ? 7 : 5;
+            break;
+        case 2:
+            //HSHS -> WAWA (S1^-1 = S1) remove left endpoint, or
+            //HSHS -> HAHA (S2^-1 = S3) remove left endpoint and append a zero
+            g.start = 2;
+            g.L = shift ? Nx - 1 : Nx;
+            g.inverse_kind = shift ? 5 : 7;
+            break;
+        case 3:
+            //WSWA -> HAHS (S4^-1 = S4), or WSWA -> WAWS (S3^-1 = S2)
+            g.inverse_kind = shift ? 8 : 6;
+            break;
+        case 4:
+            //HSHA -> WAWS (S3^-1 = S2), or HSHA -> HAHS (S4^-1 = S4)
+            g.inverse_kind = shift ? 6 : 8;
+            break;
+        case 5:
+            //WAWA -> HSHS (C2^-1 = C3) prepend zero, or
+            //WAWA -> WSWS (C1^-1 = C1) prepend and append zeros
+            g.start = 0;
+            g.L = shift ? Nx + 1 : Nx + 2;
+            g.inverse_kind = shift ? 3 : 1;
+            break;
+        case 6:
+            //HAHA -> WSWS (C1^-1 = C1) prepend zero, or
+            //HAHA -> HSHS (C2^-1 = C3) prepend zero, remove right endpoint
+            g.start = 0;
+            g.L = shift ? Nx + 1 : Nx;
+            g.inverse_kind = shift ? 1 : 3;
+            break;
+        case 7:
+            //WAWS -> HSHA (C4^-1 = C4), or WAWS -> WSWA (C3^-1 = C2)
+            g.inverse_kind = shift ? 4 : 2;
+            break;
+        default:
+            //HAHS -> WSWA (C3^-1 = C2), or HAHS -> HSHA (C4^-1 = C4)
+            g.inverse_kind = shift ? 2 : 4;
+            break;
+    }
+    g.forward_kind = fftwKind(dtt_type);
+    g.inverse_kind = fftwKind(g.inverse_kind);
+
+    //add back in the implied values so the output is the same length as
+    //the input
+    setAlign(g, DTT_ALIGN_NONE, 0, 0, DTT_ALIGN_NONE);
+    if (align_output){
+        switch (dtt_type * 10 + shift) {
+            case 10: setAlign(g, DTT_ALIGN_ZERO,   0, 0, DTT_ALIGN_ZERO);   break;    // WSWS -> WAWA, add both endpoints
+            case 11: setAlign(g, DTT_ALIGN_NONE,   0, 0, DTT_ALIGN_MIRROR); break;    // WSWS -> HAHA, mirror right endpoint
+            case 12: setAlign(g, DTT_ALIGN_MIRROR, 0, 0, DTT_ALIGN_NONE);   break;    // WSWS -> HAHA, mirror left endpoint
+            case 21: setAlign(g, DTT_ALIGN_NONE,   0, 0, DTT_ALIGN_ZERO);   break;    // HSHS -> WAWA, append zero
+            case 22: setAlign(g, DTT_ALIGN_ZERO,   0, 0, DTT_ALIGN_NONE);   break;    // HSHS -> WAWA, prepend zero
+            case 30: setAlign(g, DTT_ALIGN_ZERO,   0, 1, DTT_ALIGN_NONE);   break;    // WSWA -> WAWS, prepend zero, remove right endpoint
+            case 32: setAlign(g, DTT_ALIGN_MIRROR, 0, 1, DTT_ALIGN_NONE);   break;    // WSWA -> HAHS, mirror left endpoint, remove right endpoint
+            case 42: setAlign(g, DTT_ALIGN_ZERO,   0, 1, DTT_ALIGN_NONE);   break;    // HSHA -> WAWS, prepend zero, remove right endpoint
+            case 50: setAlign(g, DTT_ALIGN_NONE,   1, 1, DTT_ALIGN_NONE);   break;    // WAWA -> WSWS, remove both endpoints
+            case 51: setAlign(g, DTT_ALIGN_NONE,   1, 0, DTT_ALIGN_NONE);   break;    // WAWA -> HSHS, remove left endpoint
+            case 52: setAlign(g, DTT_ALIGN_NONE,   0, 1, DTT_ALIGN_NONE);   break;    // WAWA -> HSHS, remove right endpoint
+            case 61: setAlign(g, DTT_ALIGN_NONE,   1, 0, DTT_ALIGN_NONE);   break;    // HAHA -> WSWS, remove left endpoint
+            case 62: setAlign(g, DTT_ALIGN_NONE,   0, 1, DTT_ALIGN_NONE);   break;    // HAHA -> WSWS, remove right endpoint
+            case 70: setAlign(g, DTT_ALIGN_NONE,   1, 0, DTT_ALIGN_ZERO);   break;    // WAWS -> WSWA, remove left endpoint, append zero
+            case 71: setAlign(g, DTT_ALIGN_NONE,   1, 0, DTT_ALIGN_MIRROR); break;    // WAWS -> HSHA, remove left endpoint, mirror right endpoint
+            case 81: setAlign(g, DTT_ALIGN_NONE,   1, 0, DTT_ALIGN_ZERO);   break;    // HAHS -> WSWA, remove left endpoint, append zero
+            default: break;                                                    // no change
+        }
+    }
+    g.num_out = g.L - g.drop_first - g.drop_last + (g.head != DTT_ALIGN_NONE) + (g.tail != DTT_ALIGN_NONE);
+
+    return g;
+
+}
+
+//--------------------------------------------
+// WAVENUMBERS
+//--------------------------------------------
+
+//compute the wavenumbers for the given DTT type, combined with the sign
+//of the derivative (-k for the DCTs and +k for the DSTs), the 1/M
+//normalisation of the inverse transform, and a constant factor
+inline void gradientScale(int dtt_type, ptrdiff_t Nx, double dx, double factor, std::vector<double> &scale){
+
+    //compute the implied period of the input function
+    double M;
+    switch (dtt_type) {
+        case 1: M = 2.0 * (Nx - 1); break;
+        case 5: M = 2.0 * (Nx + 1); break;
+        default: M = 2.0 * Nx; break;
+    }
+
+    //calculate the wavenumbers, and combine with the sign, normalisation,
+    //and factor
+    const double pi = 3.14159265358979323846;
+    double sign = (dtt_type < 5) ? -1.0 : 1.0;
+    scale.resize(Nx);
+    for (ptrdiff_t j = 0; j < Nx; j++){
+        double n;
+        switch (dtt_type) {
+            case 1: case 2: n = (double) j; break;          // WSWS, HSHS
+            case 5: case 6: n = (double) (j + 1); break;    // WAWA, HAHA
+            default: n = j + 0.5; break;                    // WSWA, HSHA, WAWS, HAHS
+        }
+        scale[j] = factor * sign * 2.0 * pi * n / (M * dx) / M;
+    }
+
+}
+
+//--------------------------------------------
+// GRADIENT CALCULATION
+//--------------------------------------------
+
+//transform the lines of length n along the middle dimension of arrays of
+//size [pre, n, post], where the post index o starts at o * in_dist in the
+//input and o * out_dist in the output, using the chirp path if the length
+//is badly factored, and otherwise a cached FFTW plan
+template <typename T>
+inline bool transformLines(ptrdiff_t n, ptrdiff_t pre, ptrdiff_t post, int kind, T *in, ptrdiff_t in_dist,
+        T *out, ptrdiff_t out_dist, const Options &options, int threads){
+    if (badlyFactored(kind, n)){
+        return executeChirpLines(n, pre, post, kind, in, in_dist, out, out_dist, 1.0, options, threads);
+    }
+    std::vector<fftw_iodim64> dims(1, iodim(n, pre, pre));
+    std::vector<fftw_iodim64> howmany;
+    if (pre > 1) howmany.push_back(iodim(pre, 1, 1));
+    if (post > 1) howmany.push_back(iodim(post, in_dist, out_dist));
+    std::vector<int> kinds(1, kind);
+    return executeTransform(dims, howmany, kinds, in, out, options.planner, options.time_limit, threads);
+}
+
+//compute the gradient of in along a dimension of length Nx with pre
+//elements before and post elements after, where scale is given by
+//gradientScale and work has space for pre * (Nx + 2) * post elements,
+//returns false if an FFTW plan could not be created
+template <typename T>
+inline bool computeGradient(const Gradient &g, const std::vector<double> &scale, T *in, T *out, T *work,
+        ptrdiff_t Nx, ptrdiff_t pre, ptrdiff_t post, const Options &options, int threads){
+
+    ptrdiff_t line = Nx + 2;
+    bool direct = !(g.drop_first || g.drop_last);
+
+    //forward transform into indices 1 to Nx of each workspace line
+    if (!transformLines(Nx, pre, post, g.forward_kind, in, pre * Nx, work + pre, pre * line, options, threads)){
+        return false;
+    }
+
+    //multiply by the wavenumbers and normalisation, and zero the values
+    //at either end of each line used for padding
+    for (ptrdiff_t o = 0; o < post; o++){
+        T *w = work + o * pre * line;
+        for (ptrdiff_t p = 0; p < pre; p++){
+            w[p] = 0;
+            w[(Nx + 1) * pre + p] = 0;
+        }
+        for (ptrdiff_t j = 0; j < Nx; j++){
+            T s = (T) scale[j];
+            T *wj = w + (j + 1) * pre;
+            for (ptrdiff_t p = 0; p < pre; p++){
+                wj[p] *= s;
+            }
+        }
+    }
+
+    //inverse transform, either written directly into the output (offset
+    //by the prepended value), or in place in the workspace
+    T *inv_in = work + g.start * pre;
+    T *inv_out = direct ? out + (g.head != DTT_ALIGN_NONE) * pre : inv_in;
+    ptrdiff_t out_line = direct ? g.num_out : line;
+    if (!transformLines(g.L, pre, post, g.inverse_kind, inv_in, pre * line, inv_out, pre * out_line, options, threads)){
+        return false;
+    }
+
+    //copy the values that are kept into the output
+    ptrdiff_t head = (g.head != DTT_ALIGN_NONE);
+    if (!direct){
+        ptrdiff_t num_copy = g.L - g.drop_first - g.drop_last;
+        for (ptrdiff_t o = 0; o < post; o++){
+            const T *src = inv_in + o * pre * line + g.drop_first * pre;
+            T *dst = out + o * pre * g.num_out + head * pre;
+            for (ptrdiff_t i = 0; i < num_copy * pre; i++){
+                dst[i] = src[i];
+            }
+        }
+    }
+
+    //set the prepended and appended values
+    if (g.head != DTT_ALIGN_NONE || g.tail != DTT_ALIGN_NONE){
+        ptrdiff_t last = (g.num_out - 1) * pre;
+        for (ptrdiff_t o = 0; o < post; o++){
+            T *y = out + o * pre * g.num_out;
+            for (ptrdiff_t p = 0; p < pre; p++){
+                if (g.head == DTT_ALIGN_ZERO) y[p] = 0;
+                if (g.head == DTT_ALIGN_MIRROR) y[p] = -y[pre + p];
+                if (g.tail == DTT_ALIGN_ZERO) y[last + p] = 0;
+                if (g.tail == DTT_ALIGN_MIRROR) y[last + p] = -y[last - pre + p];
+            }
+        }
+    }
+
+    return true;
+
+}
+
+} // namespace dtt
+
+#endif
@@ -0,0 +1,296 @@
+/**************************************************************************
+ * Inverse transforms with fused normalisation.
+ *
+ * The inverse of each DTT is another DTT (DCT-I and DCT-IV, DST-I and
+ * DST-IV are their own inverses, DCT-II and DCT-III are inverses of each
+ * other, as are DST-II and DST-III), scaled by 1/M, where M is the
+ * logical period of the transform as defined by FFTW (2(N - 1) for
+ * DCT-I, 2(N + 1) for DST-I, and 2N otherwise). For multi-dimensional
+ * transforms, the scaling is the product over the transformed
+ * dimensions.
+ *
+ * FFTW doesn't scale the output, so the scaling is applied after the
+ * transform. To avoid a separate pass over the output, the transform is
+ * executed in chunks, and each chunk is scaled immediately after it is
+ * transformed, while it is still in cache. If the output for each index
+ * of the slowest varying loop dimension is contiguous (e.g., dtt1D along
+ * the first dimension, or dtt2D of a 3D array), the chunks are ranges of
+ * this dimension. Otherwise (e.g., dtt1D along a later dimension, or
+ * dtt3D), the array is viewed as [inner, n, outer], where n is the
+ * slowest varying transformed dimension: the other transformed dimensions
+ * are first computed by a single batched plan, and the transform along n
+ * is then computed in chunks of adjacent lines, each of which is scaled
+ * as it is computed. Arrays that don't match either layout are scaled by
+ * a separate pass divided between the threads (see dttThreads.h).
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_INVERSE_H
+#define DTT_INVERSE_H
+
+#include <vector>
+#include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttThreads.h"
+
+//target size of each chunk of the output per thread in bytes (sized to
+//fit in the L2 cache)
+#ifndef DTT_INVERSE_CHUNK_BYTES
+#define DTT_INVERSE_CHUNK_BYTES 262144
+#endif
+
+namespace dtt {
+
+//FFTW kind of the inverse transform
+inline int inverseKind(int kind){
+    switch (kind) {
+        case FFTW_REDFT10: return FFTW_REDFT01;
+        case FFTW_REDFT01: return FFTW_REDFT10;
+        case FFTW_RODFT10: return FFTW_RODFT01;
+        case FFTW_RODFT01: return FFTW_RODFT10;
+        default: return kind;
+    }
+}
+
+//logical period of a transform of length n (the normalisation of the
+//inverse transform)
+inline double logicalPeriod(int kind, ptrdiff_t n){
+    switch (kind) {
+        case FFTW_REDFT00: return 2.0 * (double) (n - 1);
+        case FFTW_RODFT00: return 2.0 * (double) (n + 1);
+        default: return 2.0 * (double) n;
+    }
+}
+
+//replace the kinds with their inverses and return the normalisation
+inline double invertKinds(const std::vector<fftw_iodim64> &dims, std::vector<int> &kinds){
+    double scale = 1.0;
+    for (size_t i = 0; i < kinds.size(); i++){
+        scale /= logicalPeriod(kinds[i], dims[i].n);
+        kinds[i] = inverseKind(kinds[i]);
+    }
+    return scale;
+}
+
+//multiply n elements by scale
+template <typename T>
+inline void scaleArray(T *x, ptrdiff_t n, T scale){
+    for (ptrdiff_t i = 0; i < n; i++){
+        x[i] *= scale;
+    }
+}
+
+//rows of an array multiplied by scale, where row i starts at x + i *
+//stride and has length elements (the last row is cut at numel)
+template <typename T>
+struct ScaledRows {
+    T *x;
+    ptrdiff_t length, stride, numel;
+    T scale;
+};
+
+//number of elements in each block of a contiguous array scaled by one
+//thread
+#ifndef DTT_INVERSE_SCALE_BLOCK
+#define DTT_INVERSE_SCALE_BLOCK 16384
+#endif
+
+template <typename T>
+inline void scaleRows(const void *rows, int, ptrdiff_t first, ptrdiff_t last){
+    const ScaledRows<T> *r = static_cast<const ScaledRows<T> *>(rows);
+    for (ptrdiff_t i = first; i < last; i++){
+        ptrdiff_t start = i * r->stride;
+        scaleArray(r->x + start, (start + r->length < r->numel) ? r->length : r->numel - start, r->scale);
+    }
+}
+
+//multiply rows rows of length elements starting every stride elements
+//by scale, divided between up to the given number of threads (only from
+//the thread that owns the worker threads in dttThreads.h)
+template <typename T>
+inline void scaleArray(T *x, ptrdiff_t length, ptrdiff_t stride, ptrdiff_t rows, T scale, int threads){
+    ScaledRows<T> r = {x, length, stride, (rows - 1) * stride + length, scale};
+    parallelFor(scaleRows<T>, &r, rows, threads);
+}
+
+//multiply n contiguous elements by scale using up to the given number of
+//threads
+template <typename T>
+inline void scaleArray(T *x, ptrdiff_t n, T scale, int threads){
+    ptrdiff_t rows = (n + DTT_INVERSE_SCALE_BLOCK - 1) / DTT_INVERSE_SCALE_BLOCK;
+    if (rows > 0){
+        ScaledRows<T> r = {x, DTT_INVERSE_SCALE_BLOCK, DTT_INVERSE_SCALE_BLOCK, n, scale};
+        parallelFor(scaleRows<T>, &r, rows, threads);
+    }
+}
+
+//number of indices in each chunk of a dimension with the given stride,
+//sized so each chunk holds about DTT_INVERSE_CHUNK_BYTES per thread, and
+//each chunk starts with the same alignment (to re-use the same plan)
+template <typename T>
+inline ptrdiff_t chunkSize(ptrdiff_t stride, ptrdiff_t bytes_per_index, ptrdiff_t n, int threads){
+    ptrdiff_t chunk = DTT_INVERSE_CHUNK_BYTES * (ptrdiff_t) threads / bytes_per_index;
+    ptrdiff_t step = 1;
+    while ((step * stride * (ptrdiff_t) sizeof(T)) % 64 != 0 && step < 64){
+        step++;
+    }
+    chunk = (chunk / step) * step;
+    if (chunk < step) chunk = step;
+    if (chunk > n) chunk = n;
+    return chunk;
+}
+
+//execute the transform as for executeScaled when the output for each
+//index of the loop dimensions isn't contiguous, where the array is
+//viewed as [inner, n, outer] (n is the transformed dimension with the
+//largest stride), the other transformed dimensions are computed first
+//(with n as an extra loop dimension), and the transform along n is then
+//computed and scaled in chunks of adjacent lines of each [inner, n] slab
+template <typename T>
+inline bool executeScaledLines(const std::vector<fftw_iodim64> &dims, const std::vector<fftw_iodim64> &howmany,
+        const std::vector<int> &kinds, T *in, T *out, ptrdiff_t numel, double scale, unsigned flags,
+        double time_limit, int threads){
+
+    //find the slowest varying transformed dimension, where the array must
+    //be dense, with the same layout for the input and output
+    size_t axis = 0;
+    bool dense = true;
+    for (size_t i = 0; i < dims.size(); i++){
+        dense = dense && (dims[i].is == dims[i].os);
+        if (dims[i].os > dims[axis].os) axis = i;
+    }
+    for (size_t i = 0; i < howmany.size(); i++){
+        dense = dense && (howmany[i].is == howmany[i].os);
+    }
+    ptrdiff_t inner = dims.empty() ? 0 : dims[axis].os;
+    ptrdiff_t n = dims.empty() ? 0 : dims[axis].n;
+    dense = dense && inner > 0 && numel % (inner * n) == 0;
+
+    //otherwise execute the whole transform and then scale
+    if (!dense){
+        if (!executeTransform(dims, howmany, kinds, in, out, flags, time_limit, threads)){
+            return false;
+        }
+        scaleArray(out, numel, (T) scale, threads);
+        return true;
+    }
+    ptrdiff_t outer = numel / (inner * n);
+
+    //transform the other dimensions from in to out, then transform along
+    //n in place in out
+    T *src = in;
+    if (dims.size() > 1){
+        std::vector<fftw_iodim64> rest_dims;
+        std::vector<int> rest_kinds;
+        for (size_t i = 0; i < dims.size(); i++){
+            if (i != axis){
+                rest_dims.push_back(dims[i]);
+                rest_kinds.push_back(kinds[i]);
+            }
+        }
+        std::vector<fftw_iodim64> rest_howmany(howmany);
+        rest_howmany.push_back(dims[axis]);
+        if (!executeTransform(rest_dims, rest_howmany, rest_kinds, in, out, flags, time_limit, threads)){
+            return false;
+        }
+        src = out;
+    }
+
+    //transform and scale chunks of adjacent lines of each slab
+    std::vector<fftw_iodim64> line_dims(1, dims[axis]);
+    std::vector<fftw_iodim64> line_howmany(1);
+    std::vector<int> line_kinds(1, kinds[axis]);
+    ptrdiff_t chunk = chunkSize<T>(1, n * (ptrdiff_t) sizeof(T), inner, threads);
+    for (ptrdiff_t o = 0; o < outer; o++){
+        for (ptrdiff_t start = 0; start < inner; start += chunk){
+            ptrdiff_t lines = (start + chunk < inner) ? chunk : inner - start;
+            ptrdiff_t offset = o * inner * n + start;
+            line_howmany[0] = iodim(lines, 1, 1);
+            if (!executeTransform(line_dims, line_howmany, line_kinds, src + offset, out + offset, flags, time_limit, threads)){
+                return false;
+            }
+            scaleArray(out + offset, lines, inner, n, (T) scale, threads);
+        }
+    }
+    return true;
+
+}
+
+//execute the transform described by dims, howmany, and kinds from in to
+//out (as in executeTransform), and multiply the output by scale, where
+//the array is dense with numel elements
+template <typename T>
+inline bool executeScaled(const std::vector<fftw_iodim64> &dims, const std::vector<fftw_iodim64> &howmany,
+        const std::vector<int> &kinds, T *in, T *out, ptrdiff_t numel, double scale, unsigned flags,
+        double time_limit, int threads){
+
+    //no scaling is needed
+    if (scale == 1.0){
+        return executeTransform(dims, howmany, kinds, in, out, flags, time_limit, threads);
+    }
+
+    //find the loop dimension with the largest output stride, the output
+    //for each index of this dimension is contiguous if this stride is the
+    //size of the rest of the array
+    ptrdiff_t max_stride = 0;
+    for (size_t i = 0; i < dims.size(); i++){
+        if (dims[i].os > max_stride) max_stride = dims[i].os;
+    }
+    int loop = -1;
+    for (size_t i = 0; i < howmany.size(); i++){
+        if (howmany[i].os > max_stride && howmany[i].is == howmany[i].os && howmany[i].os * howmany[i].n == numel){
+            loop = (int) i;
+            max_stride = howmany[i].os;
+        }
+    }
+
+    //if the output can't be split into contiguous chunks, split the
+    //transform along the slowest varying transformed dimension
+    if (loop < 0){
+        return executeScaledLines(dims, howmany, kinds, in, out, numel, scale, flags, time_limit, threads);
+    }
+
+    //if one index of the loop dimension is larger than a chunk, split the
+    //transform along the slowest varying transformed dimension instead
+    ptrdiff_t stride = howmany[loop].os;
+    if (stride * (ptrdiff_t) sizeof(T) > DTT_INVERSE_CHUNK_BYTES * (ptrdiff_t) threads){
+        return executeScaledLines(dims, howmany, kinds, in, out, numel, scale, flags, time_limit, threads);
+    }
+
+    //execute and scale each chunk of the loop dimension
+    ptrdiff_t chunk = chunkSize<T>(stride, stride * (ptrdiff_t) sizeof(T), howmany[loop].n, threads);
+    std::vector<fftw_iodim64> chunk_howmany(howmany);
+    for (ptrdiff_t start = 0; start < howmany[loop].n; start += chunk){
+        chunk_howmany[loop].n = (start + chunk < howmany[loop].n) ? chunk : howmany[loop].n - start;
+        T *chunk_in = in + start * stride;
+        T *chunk_out = out + start * stride;
+        if (!executeTransform(dims, chunk_howmany, kinds, chunk_in, chunk_out, flags, time_limit, threads)){
+            return false;
+        }
+        scaleArray(chunk_out, chunk_howmany[loop].n * stride, (T) scale, threads);
+    }
+    return true;
+
+}
+
+} // namespace dtt
+
+#endif
@@ -0,0 +1,102 @@
+/**************************************************************************
+ * Entry points of the dtt mex functions.
+ *
+ * Each mex source (dtt1D.cpp, dtt2D.cpp, etc.) can either be compiled as
+ * a separate mex function, or together with dttmex.cpp into the single
+ * dttmex binary by defining DTT_UNIFIED_MEX. In the unified binary, the
+ * entry point of each source is renamed (e.g., dtt1DMex instead of
+ * mexFunction) and called by dttmex.cpp for the matching subcommand, so
+ * all of the functions share one plan cache, one FFTW thread pool, and
+ * the same FFTW wisdom for the lifetime of the MATLAB process.
+ *
+ * As only one function can be registered with mexAtExit for each mex
+ * file, the functions used to release cached data are registered using
+ * dtt::atExit, which calls all of the registered functions when the
+ * unified binary is cleared.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_MEX_H
+#define DTT_MEX_H
+
+#include <vector>
+#include <matrix.h>
+#include <mex.h>
+
+//define the entry point of the named mex function
+#ifdef DTT_UNIFIED_MEX
+#define DTT_MEX_FUNCTION(name) void name##Mex(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+#else
+#define DTT_MEX_FUNCTION(name) void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+#endif
+
+//entry points called by dttmex.cpp
+#ifdef DTT_UNIFIED_MEX
+DTT_MEX_FUNCTION(dtt1D);
+DTT_MEX_FUNCTION(dtt2D);
+DTT_MEX_FUNCTION(dtt3D);
+DTT_MEX_FUNCTION(dtt3DFile);
+DTT_MEX_FUNCTION(dttAsync);
+DTT_MEX_FUNCTION(dttND);
+DTT_MEX_FUNCTION(dttPlan);
+DTT_MEX_FUNCTION(dttPoissonSolve);
+DTT_MEX_FUNCTION(dttWisdom);
+DTT_MEX_FUNCTION(gradientDtt);
+DTT_MEX_FUNCTION(pstd2D);
+#endif
+
+namespace dtt {
+
+//functions called when the unified binary is cleared
+inline std::vector<void (*)()> &atExitFunctions(){
+    static std::vector<void (*)()> functions;
+    return functions;
+}
+
+inline void runAtExitFunctions(){
+    std::vector<void (*)()> &functions = atExitFunctions();
+    for (size_t i = 0; i < functions.size(); i++){
+        functions[i]();
+    }
+    functions.clear();
+}
+
+//register a function to release cached data when the mex file is
+//cleared (replaces mexAtExit, which only keeps the last function
+//registered)
+inline void atExit(void (*function)()){
+#ifdef DTT_UNIFIED_MEX
+    std::vector<void (*)()> &functions = atExitFunctions();
+    for (size_t i = 0; i < functions.size(); i++){
+        if (functions[i] == function){
+            return;
+        }
+    }
+    functions.push_back(function);
+    mexAtExit(runAtExitFunctions);
+#else
+    mexAtExit(function);
+#endif
+}
+
+} // namespace dtt
+
+#endif
@@ -0,0 +1,290 @@
+/**************************************************************************
+ * MPI interface to the DTT library (see dttMpi.h).
+ *
+ * The local transforms are computed using the C interface in dtt.h, so
+ * the options are checked and the plans are cached in the same way as for
+ * arrays held by a single process. The transposes between the slab (z)
+ * and pencil (y) distributions use MPI_Alltoallv, with a contiguous MPI
+ * datatype for each x-row so the counts stay within the range of int for
+ * large grids.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#include <climits>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <mpi.h>
+#include "dtt.h"
+#include "dttMpi.h"
+
+//--------------------------------------------
+// DISTRIBUTION
+//--------------------------------------------
+
+//divide n between the ranks as evenly as possible, where the first
+//n % size ranks hold one extra element
+static void localRange(ptrdiff_t n, int size, int rank, ptrdiff_t &local_n, ptrdiff_t &local_start){
+    ptrdiff_t base = n / size, extra = n % size;
+    local_n = base + (rank < extra ? 1 : 0);
+    local_start = rank * base + (rank < extra ? rank : extra);
+}
+
+//check the array size and types, returns false if they are not valid
+static bool checkArguments(const ptrdiff_t *dims, const int *dtt_types){
+    if (dims == NULL || dtt_types == NULL){
+        return false;
+    }
+    for (int i = 0; i < 3; i++){
+        if (dims[i] < 1 || dtt_types[i] < 0 || dtt_types[i] > 8){
+            return false;
+        }
+    }
+    return true;
+}
+
+//options used for the local transforms, where the hardware threads are
+//divided between the ranks on each node if the number of threads is not
+//given explicitly
+static dtt_options localOptions(const dtt_options *opts, MPI_Comm comm){
+    dtt_options local;
+    if (opts == NULL){
+        dtt_default_options(&local);
+    } else {
+        local = *opts;
+    }
+    if (local.threads == 0){
+        MPI_Comm node;
+        int node_ranks = 1;
+        if (MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node) == MPI_SUCCESS){
+            MPI_Comm_size(node, &node_ranks);
+            MPI_Comm_free(&node);
+        }
+        if (node_ranks > 1){
+            int threads = (int) std::thread::hardware_concurrency() / node_ranks;
+            local.threads = threads > 1 ? threads : 1;
+        }
+    }
+    return local;
+}
+
+//--------------------------------------------
+// TRANSFORM
+//--------------------------------------------
+
+//C API and MPI datatype for each precision
+static int transformLocal(const double *in, double *out, const ptrdiff_t *dims, const int *dtt_types, const dtt_options *opts){
+    return dtt_transform(in, out, 3, dims, dtt_types, opts);
+}
+
+static int transformLocal(const float *in, float *out, const ptrdiff_t *dims, const int *dtt_types, const dtt_options *opts){
+    return dtt_transform_f(in, out, 3, dims, dtt_types, opts);
+}
+
+static int transformLocalDim(const double *in, double *out, const ptrdiff_t *dims, int dim, int dtt_type, const dtt_options *opts){
+    return dtt_transform_dim(in, out, 3, dims, dim, dtt_type, opts);
+}
+
+static int transformLocalDim(const float *in, float *out, const ptrdiff_t *dims, int dim, int dtt_type, const dtt_options *opts){
+    return dtt_transform_dim_f(in, out, 3, dims, dim, dtt_type, opts);
+}
+
+static MPI_Datatype mpiType(double){
+    return MPI_DOUBLE;
+}
+
+static MPI_Datatype mpiType(float){
+    return MPI_FLOAT;
+}
+
+//combine the status of each rank, so every rank returns the same status
+//(the largest status code)
+static int combineStatus(int status, MPI_Comm comm){
+    int combined;
+    if (MPI_Allreduce(&status, &combined, 1, MPI_INT, MPI_MAX, comm) != MPI_SUCCESS){
+        return DTT_ERROR_MPI;
+    }
+    return combined;
+}
+
+//transform the distributed array
+template <typename T>
+static int transformMpi(const T *in, T *out, const ptrdiff_t *dims, const int *dtt_types, const dtt_options *opts, MPI_Comm comm){
+
+    //check the inputs, where every rank must hold a valid local slab
+    int size, rank;
+    if (comm == MPI_COMM_NULL || MPI_Comm_size(comm, &size) != MPI_SUCCESS || MPI_Comm_rank(comm, &rank) != MPI_SUCCESS){
+        return DTT_ERROR_ARGUMENT;
+    }
+    ptrdiff_t nx = 1, ny = 1, nz = 1, local_nz = 0, local_z_start = 0;
+    int status = DTT_SUCCESS;
+    if (!checkArguments(dims, dtt_types)){
+        status = DTT_ERROR_ARGUMENT;
+    } else {
+        nx = dims[0];
+        ny = dims[1];
+        nz = dims[2];
+        localRange(nz, size, rank, local_nz, local_z_start);
+        if (local_nz > 0 && (in == NULL || out == NULL)){
+            status = DTT_ERROR_ARGUMENT;
+        }
+
+        //the counts are given in x-rows, and must fit in an int
+        if ((double) ny * nz > INT_MAX){
+            status = DTT_ERROR_ARGUMENT;
+        }
+    }
+    status = combineStatus(status, comm);
+    if (status != DTT_SUCCESS){
+        return status;
+    }
+    dtt_options local = localOptions(opts, comm);
+
+    //--------------------------------------------
+    // XY TRANSFORMS
+    //--------------------------------------------
+
+    //transform each local xy-plane, or copy the slab if the x and y
+    //dimensions are not transformed
+    if (local_nz > 0){
+        ptrdiff_t slab[3] = {nx, ny, local_nz};
+        int slab_types[3] = {dtt_types[0], dtt_types[1], 0};
+        if (dtt_types[0] != 0 || dtt_types[1] != 0){
+            status = transformLocal(in, out, slab, slab_types, &local);
+        } else if (in != out){
+            std::memcpy(out, in, nx * ny * local_nz * sizeof(T));
+        }
+    }
+    status = combineStatus(status, comm);
+    if (status != DTT_SUCCESS || dtt_types[2] == 0){
+        return status;
+    }
+
+    //--------------------------------------------
+    // TRANSPOSE TO Y-PENCILS
+    //--------------------------------------------
+
+    //counts and offsets in x-rows for each rank, where each rank sends
+    //the rows in the y range of the destination rank, and receives the
+    //rows in its own y range for the z range of the source rank
+    ptrdiff_t local_ny, local_y_start;
+    localRange(ny, size, rank, local_ny, local_y_start);
+    std::vector<int> send_counts(size), send_offsets(size), recv_counts(size), recv_offsets(size);
+    std::vector<ptrdiff_t> y_count(size), y_start(size);
+    int send_total = 0;
+    for (int r = 0; r < size; r++){
+        ptrdiff_t r_ny, r_y_start, r_nz, r_z_start;
+        localRange(ny, size, r, r_ny, r_y_start);
+        localRange(nz, size, r, r_nz, r_z_start);
+        y_count[r] = r_ny;
+        y_start[r] = r_y_start;
+        send_counts[r] = (int) (r_ny * local_nz);
+        send_offsets[r] = send_total;
+        send_total += send_counts[r];
+        recv_counts[r] = (int) (local_ny * r_nz);
+        recv_offsets[r] = (int) (local_ny * r_z_start);
+    }
+
+    //one datatype for each x-row
+    MPI_Datatype row;
+    if (MPI_Type_contiguous((int) nx, mpiType(T()), &row) != MPI_SUCCESS || MPI_Type_commit(&row) != MPI_SUCCESS){
+        return combineStatus(DTT_ERROR_MPI, comm);
+    }
+
+    //pack the rows sent to each rank in (x, y, z) order, which are then
+    //received directly as an nx by local_ny by nz array (the blocks from
+    //each source rank are consecutive z ranges)
+    std::vector<T> send((size_t) (nx * ny * local_nz));
+    std::vector<T> pencils((size_t) (nx * local_ny * nz));
+    for (int r = 0; r < size; r++){
+        for (ptrdiff_t z = 0; z < local_nz; z++){
+            std::memcpy(&send[0] + (send_offsets[r] + z * y_count[r]) * nx, out + (z * ny + y_start[r]) * nx,
+                    y_count[r] * nx * sizeof(T));
+        }
+    }
+    if (MPI_Alltoallv(send.empty() ? NULL : &send[0], &send_counts[0], &send_offsets[0], row,
+            pencils.empty() ? NULL : &pencils[0], &recv_counts[0], &recv_offsets[0], row, comm) != MPI_SUCCESS){
+        MPI_Type_free(&row);
+        return combineStatus(DTT_ERROR_MPI, comm);
+    }
+
+    //--------------------------------------------
+    // Z TRANSFORMS
+    //--------------------------------------------
+
+    if (local_ny > 0){
+        ptrdiff_t pencil[3] = {nx, local_ny, nz};
+        status = transformLocalDim(&pencils[0], &pencils[0], pencil, 2, dtt_types[2], &local);
+    }
+    status = combineStatus(status, comm);
+    if (status != DTT_SUCCESS){
+        MPI_Type_free(&row);
+        return status;
+    }
+
+    //--------------------------------------------
+    // TRANSPOSE TO Z-SLABS
+    //--------------------------------------------
+
+    //reverse the transpose, and unpack the rows into the output slab
+    int error = MPI_Alltoallv(pencils.empty() ? NULL : &pencils[0], &recv_counts[0], &recv_offsets[0], row,
+            send.empty() ? NULL : &send[0], &send_counts[0], &send_offsets[0], row, comm);
+    MPI_Type_free(&row);
+    if (error != MPI_SUCCESS){
+        return combineStatus(DTT_ERROR_MPI, comm);
+    }
+    for (int r = 0; r < size; r++){
+        for (ptrdiff_t z = 0; z < local_nz; z++){
+            std::memcpy(out + (z * ny + y_start[r]) * nx, &send[0] + (send_offsets[r] + z * y_count[r]) * nx,
+                    y_count[r] * nx * sizeof(T));
+        }
+    }
+    return DTT_SUCCESS;
+
+}
+
+//--------------------------------------------
+// C INTERFACE
+//--------------------------------------------
+
+extern "C" {
+
+int dtt_mpi_local_size(const ptrdiff_t *dims, MPI_Comm comm, ptrdiff_t *local_nz, ptrdiff_t *local_z_start){
+    int size, rank;
+    if (dims == NULL || local_nz == NULL || local_z_start == NULL || dims[0] < 1 || dims[1] < 1 || dims[2] < 1
+            || comm == MPI_COMM_NULL || MPI_Comm_size(comm, &size) != MPI_SUCCESS || MPI_Comm_rank(comm, &rank) != MPI_SUCCESS){
+        return DTT_ERROR_ARGUMENT;
+    }
+    localRange(dims[2], size, rank, *local_nz, *local_z_start);
+    return DTT_SUCCESS;
+}
+
+int dtt_mpi_transform(const double *in, double *out, const ptrdiff_t *dims,
+        const int *dtt_types, const dtt_options *opts, MPI_Comm comm){
+    return transformMpi(in, out, dims, dtt_types, opts, comm);
+}
+
+int dtt_mpi_transform_f(const float *in, float *out, const ptrdiff_t *dims,
+        const int *dtt_types, const dtt_options *opts, MPI_Comm comm){
+    return transformMpi(in, out, dims, dtt_types, opts, comm);
+}
+
+} // extern "C"
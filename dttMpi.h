@@ -0,0 +1,93 @@
+/**************************************************************************
+ * MPI interface to the DTT library.
+ *
+ * Computes 3D discrete trigonometric transforms of arrays distributed
+ * over the ranks of an MPI communicator, for grids that are too large to
+ * fit in the memory of a single node. The array is distributed in slabs
+ * of xy-planes, where each rank holds local_nz planes starting at plane
+ * local_z_start (given by dtt_mpi_local_size). The local slab is stored
+ * in column-major order with size dims[0] by dims[1] by local_nz.
+ *
+ * Each transform is computed in three steps:
+ *
+ *     1. the x and y transforms of the local slab are computed using
+ *        dtt_transform (as in dtt.h)
+ *     2. the array is transposed using MPI_Alltoallv so each rank holds
+ *        every xz-plane for a range of y, and the z transforms are
+ *        computed along the (now local) z dimension
+ *     3. the array is transposed back to the slab distribution
+ *
+ * The transposed array is received directly in column-major order, so
+ * only the send side of each transpose is packed. The result is returned
+ * with the same distribution as the input, so repeated transforms (e.g.,
+ * within a time-stepping loop) don't need to change the distribution.
+ *
+ * All of the functions are collective, and must be called by every rank
+ * in the communicator with the same dims, dtt_types, and options. Each
+ * rank uses its own plan cache, which is released using dtt_cleanup. If
+ * opts->threads is 0, the hardware threads on each node are divided
+ * between the ranks on that node. The library is built with MPI support
+ * using -DDTT_BUILD_MPI=ON (see CMakeLists.txt).
+ *
+ * Example:
+ *
+ *     ptrdiff_t dims[3] = {512, 512, 512}, local_nz, local_z_start;
+ *     int dtt_types[3] = {2, 2, 2};
+ *     dtt_mpi_local_size(dims, MPI_COMM_WORLD, &local_nz, &local_z_start);
+ *     double *x = malloc(dims[0] * dims[1] * local_nz * sizeof(double));
+ *     ...
+ *     dtt_mpi_transform(x, x, dims, dtt_types, NULL, MPI_COMM_WORLD);
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_MPI_H
+#define DTT_MPI_H
+
+#include <mpi.h>
+#include "dtt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* number of xy-planes held by this rank (local_nz) and the index of the
+ * first plane (local_z_start) for a 3D array of size dims[0] by dims[1]
+ * by dims[2], where the planes are divided as evenly as possible between
+ * the ranks in order (local_nz can be 0 if dims[2] is smaller than the
+ * number of ranks) */
+DTT_API int dtt_mpi_local_size(const ptrdiff_t *dims, MPI_Comm comm, ptrdiff_t *local_nz,
+        ptrdiff_t *local_z_start);
+
+/* transform the 3D array of size dims[0] by dims[1] by dims[2] distributed
+ * over comm, where in and out are the local slabs (see
+ * dtt_mpi_local_size) and can be the same array, and dtt_types[i] is the
+ * DTT type used for dimension i, or 0 if the dimension is not
+ * transformed (returns the same status on every rank) */
+DTT_API int dtt_mpi_transform(const double *in, double *out, const ptrdiff_t *dims,
+        const int *dtt_types, const dtt_options *opts, MPI_Comm comm);
+DTT_API int dtt_mpi_transform_f(const float *in, float *out, const ptrdiff_t *dims,
+        const int *dtt_types, const dtt_options *opts, MPI_Comm comm);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
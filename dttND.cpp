@@ -0,0 +1,179 @@
+/**************************************************************************
+ * MEX file to compute N-dimensional discrete trigonometric transforms in
+ * double or single precision using FFTW. The transform is taken over any
+ * subset of the dimensions of the input array, with the type set
+ * independently for each dimension. See dttND.m for usage notes.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#include <vector>
+#include <matrix.h>
+#include <mex.h>
+#include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttOptions.h"
+#include "dttCore.h"
+#include "dttExecute.h"
+#include "dttStats.h"
+#include "dttMex.h"
+
+DTT_MEX_FUNCTION(dttND)
+{
+
+    //--------------------------------------------
+    // DECLARE VARIABLES
+    //--------------------------------------------
+
+    mxArray *output_mat;
+    mwSize numelements;
+    const mwSize *dims;
+    int numdims, numtypes, numaxes;
+    int i;
+    void *input_ptr, *output_ptr;
+
+    //start timing the call (see dttStats.h)
+    dtt::CallStats stats("dttND");
+    
+    //release cached FFTW plans when the mex file is cleared
+    dtt::atExit(dtt::clearPlanCache);
+
+    //--------------------------------------------
+    // CHECK NUMBER OF INPUTS AND OUTPUTS
+    //--------------------------------------------
+
+    //check for proper number of arguments
+    if(nrhs < 2) {
+        mexErrMsgTxt("At least two inputs are required.");
+	}
+
+    //--------------------------------------------
+    // CHECK AND ALLOCATE DTT TYPE INPUT
+    //--------------------------------------------
+
+    //check DTT_type input is real and double precision
+    if( !(mxIsDouble(prhs[1]) && !mxIsComplex(prhs[1]))) {
+        mexErrMsgTxt("Input for DTT_TYPE must be real, and double precision.");
+    }
+
+    //get pointer to the DTT_TYPE input and check its size
+    double * dtt_type_pointer = mxGetPr(prhs[1]);
+    numtypes = (int) mxGetNumberOfElements(prhs[1]);
+    if (numtypes == 0){
+        mexErrMsgTxt("Input for DTT_TYPE must not be empty.");
+    }
+
+    //--------------------------------------------
+    // CHECK OPTIONAL INPUTS
+    //--------------------------------------------
+
+    //get planner options from name/value pairs and global defaults
+    dtt::Options options = dtt::getOptions(nrhs, prhs, 2);
+    stats.enable(options.stats);
+
+    //check the number of outputs (none for in-place transforms)
+    dtt::checkOutputs(options, nlhs);
+
+    //--------------------------------------------
+    // CHECK AND ALLOCATE INPUT AND OUTPUT ARRAYS
+    //--------------------------------------------
+
+    //check the input matrix is real and double or single precision
+    if( !((mxIsDouble(prhs[0]) || mxIsSingle(prhs[0])) && !mxIsComplex(prhs[0])) ) {
+        mexErrMsgTxt("Input array must be double or single precision and real.");
+    }
+
+    //get the dimensions of the input array
+    numdims = mxGetNumberOfDimensions(prhs[0]);
+    dims = mxGetDimensions(prhs[0]);
+    numelements = mxGetNumberOfElements(prhs[0]);
+
+    //a scalar DTT_TYPE is used for every dimension of the input, otherwise
+    //there is one type per dimension (dimensions beyond numdims are
+    //singleton)
+    numaxes = (numtypes == 1) ? numdims : numtypes;
+    if (numtypes > 1 && numtypes < numdims){
+        mexErrMsgTxt("Input for DTT_TYPE must be scalar or have one element for each dimension of the input array.");
+    }
+
+    //assign DTT types, where a type of 0 means the dimension is not
+    //transformed
+    std::vector<int> axis_kinds(numaxes);
+    for (i = 0; i < numaxes; i++){
+        double dtt_type = dtt_type_pointer[numtypes == 1 ? 0 : i];
+        if (dtt_type != (int) dtt_type){
+            mexErrMsgTxt("Input for DTT_TYPE must contain integers between 0 and 8.");
+        }
+        axis_kinds[i] = (dtt_type == 0) ? -1 : dtt::fftwKind((int) dtt_type);
+        if (dtt_type != 0 && axis_kinds[i] < 0){
+            mexErrMsgTxt("Input for DTT_TYPE must contain integers between 0 and 8.");
+        }
+    }
+
+    stats.mark(DTT_PHASE_VALIDATE);
+
+    //create MATLAB output with the same precision as the input, or for
+    //in-place transforms, write the output to the input array (the output
+    //is not zero-filled as every element is written by FFTW, so the pages
+    //are first touched by the threads executing the transform)
+    input_ptr = mxGetData(prhs[0]);
+    if (options.in_place){
+        output_ptr = input_ptr;
+    } else {
+        output_mat = plhs[0] = mxCreateUninitNumericArray(numdims, dims, mxGetClassID(prhs[0]), mxREAL);
+        output_ptr = mxGetData(output_mat);
+    }
+    stats.mark(DTT_PHASE_ALLOCATE);
+
+    //--------------------------------------------
+    // EXECUTE FFTW PLAN
+    //--------------------------------------------
+
+    //describe the transform using guru64 dimensions, the transformed
+    //dimensions become the transform dimensions, and the remaining
+    //non-singleton dimensions become loop dimensions, so batched lower
+    //rank transforms are executed as a single plan (see dttCore.h)
+    std::vector<ptrdiff_t> sz(numaxes, 1);
+    for (i = 0; i < numdims && i < numaxes; i++){
+        sz[i] = (ptrdiff_t) dims[i];
+    }
+    dtt::Transform transform = dtt::describeAxes(sz, axis_kinds);
+
+    //execute using a cached plan (out of place unless InPlace is set), the plan
+    //is only created on the first call for a given array size, type,
+    //planner rigor, number of threads, precision, and in-place setting
+    //(for the inverse, the output is scaled by 1/M as it is computed, see
+    //dttExecute.h)
+    int threads = dtt::getThreads(options, numelements);
+    bool success;
+    if (mxIsSingle(prhs[0])){
+        success = dtt::execute(transform, (float *) input_ptr, (float *) output_ptr, options, threads);
+    } else {
+        success = dtt::execute(transform, (double *) input_ptr, (double *) output_ptr, options, threads);
+    }
+    if (!success){
+        mexErrMsgTxt("FFTW plan could not be created.");
+    }
+    stats.mark(DTT_PHASE_EXECUTE);
+    stats.addBytes(2.0 * numelements * mxGetElementSize(prhs[0]));
+    stats.finish();
+
+    return;
+}
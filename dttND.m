@@ -0,0 +1,124 @@
+function varargout = dttND(varargin)
+%DTTND N-dimensional discrete trigonometric transform.
+%
+% DESCRIPTION:
+%     dttND computes the discrete trigonometric transform (DTT) of the
+%     input array x over any subset of its dimensions using FFTW
+%     (http://www.fftw.org). The type of transform is set independently
+%     for each dimension, and dimensions with a type of 0 are not
+%     transformed.
+%
+%     This allows batched lower-rank transforms to be computed over
+%     higher-rank arrays as a single FFTW plan, without looping over
+%     slices in MATLAB. For example, for an Nx by Ny by Nt stack of 2D
+%     images, the 2D DCT-II of every page is given by
+%
+%         X = dttND(x, [2, 2, 0]);
+%
+%     and for a 4D array, the 3D DST-I of each time slice is given by
+%
+%         X = dttND(x, [5, 5, 5, 0]);
+%
+%     The type of DTT is specified by the input dtt_type, where 1 to 4
+%     corresponds to DCTs, and 5 to 8 to DSTs. The input array can be
+%     double or single precision, and the output has the same precision
+%     as the input.
+%
+%     As with the other DTT functions, the FFTW plan is created the first
+%     time a given array size and dtt_type is used, and then cached and
+%     re-used by later calls.
+%
+%     For compilation instructions, see compileDttMex.
+%
+% USAGE:
+%     X = dttND(x, dtt_type)
+%     X = dttND(x, dtt_type, 'Planner', 'measure')
+%     dttND(x, dtt_type, 'InPlace', true)
+%     x = dttND(X, dtt_type, 'Inverse', true)
+%
+% INPUTS:
+%     x             - Array to transform in double or single precision.
+%                     The array can have any number of dimensions.
+%     dtt_type      - Type of discrete trigonometric transform for each
+%                     dimension of x, specified as an integer between 0
+%                     and 8:
+%
+%                         0: not transformed
+%                         1: DCT-I    WSWS
+%                         2: DCT-II   HSHS
+%                         3: DCT-III  WSWA
+%                         4: DCT-IV   HSHA
+%                         5: DST-I    WAWA
+%                         6: DST-II   HAHA
+%                         7: DST-III  WAWS
+%                         8: DST-IV   HAHS
+%
+%                     If dtt_type is a scalar, the same transform is
+%                     taken over every dimension of x. Otherwise, dtt_type
+%                     must have (at least) one element for each dimension
+%                     of x, where additional elements correspond to
+%                     trailing singleton dimensions.
+%
+% OPTIONAL INPUTS:
+%     Optional inputs are given as name/value pairs after the other
+%     inputs. Default values for all calls can be set using dttOptions.
+%
+%     'Planner'     - Rigor used by the FFTW planner when a new plan is
+%                     created: 'estimate' (default), 'measure', 'patient',
+%                     or 'exhaustive'.
+%     'TimeLimit'   - Approximate upper bound on the time in seconds
+%                     spent creating each plan (default = Inf).
+%     'Threads'     - Number of threads used by FFTW (default =
+%                     maxNumCompThreads for arrays with at least 65536
+%                     elements, and 1 otherwise).
+%     'InPlace'     - Boolean controlling whether the transform overwrites
+%                     the input array instead of allocating an output
+%                     (default = false), which halves the peak memory
+%                     for large arrays. The function must be called
+%                     without an output argument, and x must be a
+%                     variable that doesn't share its data with another
+%                     variable (for example, after y = x, both x and y
+%                     would be overwritten). This option can't be set
+%                     using dttOptions.
+%     'Inverse'     - Boolean controlling whether the normalised inverse
+%                     of the given dtt_type is computed (default = false),
+%                     so that dttND(dttND(x, dtt_type), dtt_type, 'Inverse',
+%                     true) returns x. The inverse uses the matching
+%                     inverse DTT (e.g., DCT-III for DCT-II), and the 1/M
+%                     normalisation (where M is the logical period of the
+%                     transform, 2(N - 1) for DCT-I, 2(N + 1) for DST-I,
+%                     and 2N otherwise, multiplied over each
+%                     transformed dimension) is applied as the output is
+%                     computed, rather than as a separate pass in MATLAB.
+%                     This option can't be set using dttOptions.
+%
+% OUTPUTS:
+%     X             - Discrete trigonometric transform of the input array
+%                     x, returned with the same precision as x.
+%
+% ABOUT:
+%     author        - Bradley Treeby
+%     date          - 16 October 2026
+%     last update   - 16 October 2026
+%
+% Copyright (C) 2026 Bradley Treeby
+%
+% See also dtt1D, dtt2D, dtt3D, dttOptions, dttWisdom
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+%
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+% call the function in the unified dttmex binary (if dttND has been
+% compiled as a separate mex function, the mex function is called
+% instead of this file, see compileDttMex)
+[varargout{1:nargout}] = dttmex('ND', varargin{:});
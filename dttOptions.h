@@ -0,0 +1,335 @@
+/**************************************************************************
+ * Option handling shared by the dtt mex functions.
+ *
+ * Options can be set for a single call by appending name/value pairs to
+ * the inputs of dtt1D, dtt2D, dtt3D, and dttND, or for all calls using
+ * dttOptions, which stores the values in the global variable DTT_OPTIONS.
+ * Options given per call take precedence over the global values. See
+ * dttOptions.m for the list of supported options. The Options struct and
+ * the defaults are defined in dttCore.h, which has no dependency on
+ * MATLAB.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_OPTIONS_H
+#define DTT_OPTIONS_H
+
+#include <cstring>
+#include <vector>
+#include <matrix.h>
+#include <mex.h>
+#include "fftw3.h"
+#include "dttCore.h"
+
+//array sizes are passed to FFTW as 64-bit guru64 dimensions, which
+//requires a 64-bit mwSize (the default since MATLAB R2018a)
+#ifdef MX_COMPAT_32
+#error "The DTT mex functions must be compiled with -largeArrayDims."
+#endif
+
+//name of the global variable used to store the default options
+#define DTT_OPTIONS_GLOBAL "DTT_OPTIONS"
+
+namespace dtt {
+
+//case insensitive string comparison
+inline bool equalsIgnoreCase(const char *a, const char *b){
+    while (*a && *b){
+        char ca = (*a >= 'A' && *a <= 'Z') ? *a - 'A' + 'a' : *a;
+        char cb = (*b >= 'A' && *b <= 'Z') ? *b - 'A' + 'a' : *b;
+        if (ca != cb) return false;
+        a++;
+        b++;
+    }
+    return *a == *b;
+}
+
+//copy a MATLAB string into buffer, returns false if not a string or too long
+inline bool getString(const mxArray *value, char *buffer, mwSize length){
+    return mxIsChar(value) && (mxGetString(value, buffer, length) == 0);
+}
+
+//get the value of a real scalar numeric or logical input
+inline bool getScalar(const mxArray *value, double &scalar){
+    if (!((mxIsNumeric(value) || mxIsLogical(value)) && !mxIsComplex(value) && mxGetNumberOfElements(value) == 1)){
+        return false;
+    }
+    scalar = mxGetScalar(value);
+    return true;
+}
+
+//convert the name of the planner rigor to the FFTW flag
+inline void setPlanner(Options &options, const mxArray *value){
+    char name[32];
+    if (!getString(value, name, sizeof(name))){
+        mexErrMsgTxt("Value for PLANNER must be 'estimate', 'measure', 'patient', or 'exhaustive'.");
+    }
+    if (equalsIgnoreCase(name, "estimate")){
+        options.planner = FFTW_ESTIMATE;
+    } else if (equalsIgnoreCase(name, "measure")){
+        options.planner = FFTW_MEASURE;
+    } else if (equalsIgnoreCase(name, "patient")){
+        options.planner = FFTW_PATIENT;
+    } else if (equalsIgnoreCase(name, "exhaustive")){
+        options.planner = FFTW_EXHAUSTIVE;
+    } else {
+        mexErrMsgTxt("Value for PLANNER must be 'estimate', 'measure', 'patient', or 'exhaustive'.");
+    }
+}
+
+//set the planner time limit, Inf is used to remove the limit
+inline void setTimeLimit(Options &options, const mxArray *value){
+    double limit;
+    if (!getScalar(value, limit) || !(limit > 0)){
+        mexErrMsgTxt("Value for TIMELIMIT must be a positive scalar (or Inf for no limit).");
+    }
+    options.time_limit = mxIsInf(limit) ? FFTW_NO_TIMELIMIT : limit;
+}
+
+//set the number of threads
+inline void setThreads(Options &options, const mxArray *value){
+    double threads;
+    if (!getScalar(value, threads) || !(threads >= 1) || threads != (int) threads){
+        mexErrMsgTxt("Value for THREADS must be a positive integer.");
+    }
+    options.threads = (int) threads;
+}
+
+//set whether the input array is transformed in place
+inline void setInPlace(Options &options, const mxArray *value){
+    double in_place;
+    if (!getScalar(value, in_place)){
+        mexErrMsgTxt("Value for INPLACE must be true or false.");
+    }
+    options.in_place = (in_place != 0);
+}
+
+//set whether the normalised inverse transform is computed
+inline void setInverse(Options &options, const mxArray *value){
+    double inverse;
+    if (!getScalar(value, inverse)){
+        mexErrMsgTxt("Value for INVERSE must be true or false.");
+    }
+    options.inverse = (inverse != 0);
+}
+
+//set whether the timing of each phase of the call is recorded
+inline void setStats(Options &options, const mxArray *value){
+    double stats;
+    if (!getScalar(value, stats)){
+        mexErrMsgTxt("Value for STATS must be true or false.");
+    }
+    options.stats = (stats != 0);
+}
+
+//set the execution strategy used by dtt1D
+inline void setStrategy(Options &options, const mxArray *value){
+    char name[32];
+    if (!getString(value, name, sizeof(name))){
+        mexErrMsgTxt("Value for STRATEGY must be 'auto', 'strided', 'transpose', 'small', 'chirp', or 'gemm'.");
+    }
+    if (equalsIgnoreCase(name, "auto")){
+        options.strategy = DTT_STRATEGY_AUTO;
+    } else if (equalsIgnoreCase(name, "strided")){
+        options.strategy = DTT_STRATEGY_STRIDED;
+    } else if (equalsIgnoreCase(name, "transpose")){
+        options.strategy = DTT_STRATEGY_TRANSPOSE;
+    } else if (equalsIgnoreCase(name, "small")){
+        options.strategy = DTT_STRATEGY_SMALL;
+    } else if (equalsIgnoreCase(name, "chirp")){
+        options.strategy = DTT_STRATEGY_CHIRP;
+    } else if (equalsIgnoreCase(name, "gemm")){
+        options.strategy = DTT_STRATEGY_GEMM;
+    } else {
+        mexErrMsgTxt("Value for STRATEGY must be 'auto', 'strided', 'transpose', 'small', 'chirp', or 'gemm'.");
+    }
+}
+
+//set a single option given its name
+inline void setOption(Options &options, const char *name, const mxArray *value){
+    if (equalsIgnoreCase(name, "Planner")){
+        setPlanner(options, value);
+    } else if (equalsIgnoreCase(name, "TimeLimit")){
+        setTimeLimit(options, value);
+    } else if (equalsIgnoreCase(name, "Threads")){
+        setThreads(options, value);
+    } else if (equalsIgnoreCase(name, "InPlace")){
+        setInPlace(options, value);
+    } else if (equalsIgnoreCase(name, "Strategy")){
+        setStrategy(options, value);
+    } else if (equalsIgnoreCase(name, "Inverse")){
+        setInverse(options, value);
+    } else if (equalsIgnoreCase(name, "Stats")){
+        setStats(options, value);
+    } else {
+        mexErrMsgTxt("Unknown option name. Supported options are 'Planner', 'TimeLimit', 'Threads', 'InPlace', 'Strategy', 'Inverse', and 'Stats'.");
+    }
+}
+
+//returns true if the option only applies to a single call, so can only be
+//given as a name/value pair (an in-place or inverse default would change
+//the meaning of every other call, including those made by other functions)
+inline bool isCallOption(const char *name){
+    return equalsIgnoreCase(name, "InPlace") || equalsIgnoreCase(name, "Inverse");
+}
+
+//get the options for the current call, starting from the defaults, then
+//the global values set using dttOptions, and finally the name/value pairs
+//given in prhs[first] onwards
+inline Options getOptions(int nrhs, const mxArray *prhs[], int first){
+
+    //defaults
+    Options options = defaultOptions();
+
+    //global values (stored as a struct with one field per option)
+    const mxArray *global = mexGetVariablePtr("global", DTT_OPTIONS_GLOBAL);
+    if (global != NULL && mxIsStruct(global) && mxGetNumberOfElements(global) == 1){
+        int num_fields = mxGetNumberOfFields(global);
+        for (int i = 0; i < num_fields; i++){
+            const char *name = mxGetFieldNameByNumber(global, i);
+            const mxArray *value = mxGetFieldByNumber(global, 0, i);
+            if (value != NULL && !mxIsEmpty(value)){
+                if (isCallOption(name)){
+                    mexErrMsgTxt("The InPlace and Inverse options can only be given as name/value pairs, remove them from the global DTT_OPTIONS.");
+                }
+                setOption(options, name, value);
+            }
+        }
+    }
+
+    //name/value pairs
+    if ((nrhs - first) % 2 != 0){
+        mexErrMsgTxt("Optional inputs must be given as name/value pairs.");
+    }
+    for (int i = first; i < nrhs; i += 2){
+        char name[32];
+        if (!getString(prhs[i], name, sizeof(name))){
+            mexErrMsgTxt("Option names must be given as strings.");
+        }
+        setOption(options, name, prhs[i + 1]);
+    }
+
+    return options;
+
+}
+
+//returns true if the option is given as one of the name/value pairs in
+//prhs[first] onwards (used to reject options that a function doesn't
+//implement, as the Strategy option can also be set as a default for the
+//functions that do)
+inline bool hasOption(int nrhs, const mxArray *prhs[], int first, const char *name){
+    for (int i = first; i + 1 < nrhs; i += 2){
+        char option[32];
+        if (getString(prhs[i], option, sizeof(option)) && equalsIgnoreCase(option, name)){
+            return true;
+        }
+    }
+    return false;
+}
+
+//check the number of outputs, in-place transforms overwrite the input
+//array, so must be called without an output, otherwise one output is
+//required
+inline void checkOutputs(const Options &options, int nlhs){
+    if (options.in_place && nlhs != 0){
+        mexErrMsgTxt("In-place transforms must be called without an output argument.");
+    } else if (!options.in_place && nlhs != 1){
+        mexErrMsgTxt("One output is required.");
+    }
+}
+
+//number of threads used to transform an array with the given number of
+//elements, if not given explicitly this is 1 for small arrays, and
+//otherwise the value returned by maxNumCompThreads
+inline int getThreads(const Options &options, size_t numel){
+    if (options.threads > 0){
+        return options.threads;
+    }
+    if (numel < DTT_MIN_THREADED_SIZE){
+        return 1;
+    }
+    mxArray *max_threads = NULL;
+    if (mexCallMATLAB(1, &max_threads, 0, NULL, "maxNumCompThreads") != 0 || max_threads == NULL){
+        return 1;
+    }
+    int threads = (int) mxGetScalar(max_threads);
+    mxDestroyArray(max_threads);
+    return threads > 1 ? threads : 1;
+}
+
+//get the DTT type for each dimension of x (as for dttND), where a scalar
+//DTT_TYPE is used for every dimension (or only DIM if DIM > 0), otherwise
+//there is one type per dimension (dimensions beyond the number of
+//dimensions of x are singleton), returns the size, DTT type, and FFTW
+//kind (-1 if not transformed) of each axis
+inline void getAxisKinds(const mxArray *x, const mxArray *dtt_type, int DIM, std::vector<ptrdiff_t> &sz,
+        std::vector<double> &dtt_types, std::vector<int> &axis_kinds){
+
+    //check DTT_type input is real and double precision
+    if( !(mxIsDouble(dtt_type) && !mxIsComplex(dtt_type) && !mxIsEmpty(dtt_type)) ) {
+        mexErrMsgTxt("Input for DTT_TYPE must be real, double precision, and not empty.");
+    }
+    const double *dtt_type_pointer = mxGetPr(dtt_type);
+    int numtypes = (int) mxGetNumberOfElements(dtt_type);
+    int numdims = (int) mxGetNumberOfDimensions(x);
+    const mwSize *dims = mxGetDimensions(x);
+
+    //number of axes
+    int numaxes;
+    if (DIM > 0){
+        if (numtypes != 1){
+            mexErrMsgTxt("Input for DTT_TYPE must be scalar when DIM is given.");
+        }
+        numaxes = (DIM > numdims) ? DIM : numdims;
+    } else {
+        numaxes = (numtypes == 1) ? numdims : numtypes;
+        if (numtypes > 1 && numtypes < numdims){
+            mexErrMsgTxt("Input for DTT_TYPE must be scalar or have one element for each dimension of the input array.");
+        }
+    }
+
+    //size and type of each axis
+    sz.assign(numaxes, 1);
+    dtt_types.assign(numaxes, 0);
+    axis_kinds.assign(numaxes, -1);
+    for (int i = 0; i < numaxes; i++){
+        if (i < numdims){
+            sz[i] = (ptrdiff_t) dims[i];
+        }
+        if (DIM > 0 && i != DIM - 1){
+            continue;
+        }
+        double type = dtt_type_pointer[numtypes == 1 ? 0 : i];
+        if (type != (int) type){
+            mexErrMsgTxt("Input for DTT_TYPE must contain integers between 0 and 8.");
+        }
+        axis_kinds[i] = (type == 0) ? -1 : fftwKind((int) type);
+        if (type != 0 && axis_kinds[i] < 0){
+            mexErrMsgTxt("Input for DTT_TYPE must contain integers between 0 and 8.");
+        }
+        dtt_types[i] = type;
+    }
+
+}
+
+} // namespace dtt
+
+#endif
@@ -0,0 +1,140 @@
+function options = dttOptions(varargin)
+%DTTOPTIONS Get or set the default options used by the DTT functions.
+%
+% DESCRIPTION:
+%     dttOptions sets the default values of the optional inputs used by
+%     dtt1D, dtt2D, dtt3D, and dttND. The defaults are stored in the global
+%     variable DTT_OPTIONS, and are used by every subsequent call to the
+%     DTT functions. Options given as name/value pairs when calling a DTT
+%     function take precedence over the values set using dttOptions. The
+%     'InPlace' and 'Inverse' options change the result of a call, so they
+%     can't be set as defaults, and must be given as name/value pairs to
+%     each call that uses them.
+%
+%     Calling dttOptions with no inputs returns the current options.
+%     Calling dttOptions('reset') restores the default values.
+%
+%     When the planner rigor is set to 'measure', 'patient', or
+%     'exhaustive', FFTW times several possible algorithms the first time
+%     each array size and DTT type is used, and the fastest plan is then
+%     cached and re-used by later calls. The results of this planning
+%     (FFTW wisdom) can be saved to disk and loaded in later MATLAB
+%     sessions using dttWisdom.
+%
+% USAGE:
+%     dttOptions('Planner', 'measure')
+%     dttOptions('Planner', 'patient', 'TimeLimit', 60)
+%     dttOptions('Threads', 8)
+%     dttOptions('Strategy', 'transpose')
+%     dttOptions('Stats', true)
+%     options = dttOptions
+%     dttOptions('reset')
+%
+% OPTIONAL INPUTS:
+%     'Planner'     - Rigor used by the FFTW planner when a new plan is
+%                     created, given as one of the following (default =
+%                     'estimate'):
+%
+%                         'estimate'   - FFTW_ESTIMATE
+%                         'measure'    - FFTW_MEASURE
+%                         'patient'    - FFTW_PATIENT
+%                         'exhaustive' - FFTW_EXHAUSTIVE
+%
+%     'TimeLimit'   - Approximate upper bound on the time in seconds
+%                     spent creating each plan, set using
+%                     fftw_set_timelimit (default = Inf).
+%
+%     'Threads'     - Number of threads used by FFTW. If empty (the
+%                     default), arrays with at least 65536 elements use
+%                     maxNumCompThreads threads, and smaller arrays use a
+%                     single thread.
+%
+%     'Strategy'    - Execution strategy used by dtt1D, given as 'auto',
+%                     'strided', 'transpose', 'small', 'chirp', or
+%                     'gemm' (default = 'auto'). See dtt1D.
+%
+%     'Stats'       - Boolean controlling whether the time spent in each
+%                     phase of every call is recorded (default = false).
+%                     See dttStats.
+%
+% OUTPUTS:
+%     options       - Structure containing the current options.
+%
+% ABOUT:
+%     author        - Bradley Treeby
+%     date          - 16 October 2026
+%     last update   - 16 October 2026
+%
+% Copyright (C) 2026 Bradley Treeby
+%
+% See also dtt1D, dtt2D, dtt3D, dttND, dttStats, dttWisdom
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+%
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+% the defaults are stored in a global variable so they can be read by
+% each of the mex functions
+global DTT_OPTIONS
+
+% default values
+defaults = struct('Planner', 'estimate', 'TimeLimit', Inf, 'Threads', [], 'Strategy', 'auto', 'Stats', false);
+
+% restore defaults
+if (nargin == 1) && ischar(varargin{1}) && strcmpi(varargin{1}, 'reset')
+    DTT_OPTIONS = defaults;
+    options = DTT_OPTIONS;
+    return
+end
+
+% initialise the global options if they haven't been set
+if ~isstruct(DTT_OPTIONS)
+    DTT_OPTIONS = defaults;
+end
+
+% check name/value pairs
+if rem(nargin, 2)
+    error('Optional inputs must be given as name/value pairs.');
+end
+
+% assign each option
+for input_ind = 1:2:nargin
+
+    name  = varargin{input_ind};
+    value = varargin{input_ind + 1};
+
+    switch lower(name)
+        case 'planner'
+            value = validatestring(value, {'estimate', 'measure', 'patient', 'exhaustive'}, 'dttOptions', 'Planner');
+            DTT_OPTIONS.Planner = value;
+        case 'timelimit'
+            validateattributes(value, {'numeric'}, {'real', 'scalar', 'positive'}, 'dttOptions', 'TimeLimit');
+            DTT_OPTIONS.TimeLimit = double(value);
+        case 'threads'
+            if ~isempty(value)
+                validateattributes(value, {'numeric'}, {'integer', 'scalar', 'positive'}, 'dttOptions', 'Threads');
+            end
+            DTT_OPTIONS.Threads = double(value);
+        case 'strategy'
+            value = validatestring(value, {'auto', 'strided', 'transpose', 'small', 'chirp', 'gemm'}, 'dttOptions', 'Strategy');
+            DTT_OPTIONS.Strategy = value;
+        case 'stats'
+            validateattributes(value, {'logical', 'numeric'}, {'scalar', 'binary'}, 'dttOptions', 'Stats');
+            DTT_OPTIONS.Stats = logical(value);
+        otherwise
+            error(['Unknown option ''' name '''.']);
+    end
+
+end
+
+% return the current options
+options = DTT_OPTIONS;
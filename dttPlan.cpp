@@ -0,0 +1,411 @@
+/**************************************************************************
+ * MEX file to create, execute, and destroy explicit FFTW plan handles for
+ * discrete trigonometric transforms. A handle stores the description of
+ * the transform (array size, DTT type for each dimension, precision,
+ * planner rigor, number of threads, in-place setting, and normalisation
+ * for inverse transforms), together with
+ * the FFTW plan, so each execution is a single handle lookup followed by
+ * fftw_execute_r2r. Unlike the implicit plan cache used by the other dtt
+ * mex functions, plans held by a handle are never evicted, and are only
+ * destroyed when requested (or when the mex file is cleared). See
+ * dttPlan.m for usage notes.
+ *
+ * FFTW only allows a plan to be executed on arrays with the same
+ * alignment as the arrays used for planning. MATLAB arrays of the same
+ * size normally have the same alignment, so a handle normally holds one
+ * plan, but a plan is added for each new alignment encountered.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#include <algorithm>
+#include <map>
+#include <vector>
+#include <matrix.h>
+#include <mex.h>
+#include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttOptions.h"
+#include "dttCore.h"
+#include "dttInverse.h"
+#include "dttStats.h"
+#include "dttMex.h"
+
+//alignment in bytes that must match between the arrays used to create
+//and execute a plan (16 bytes for the SSE2 and AVX versions of FFTW)
+#ifndef DTT_FFTW_ALIGNMENT
+#define DTT_FFTW_ALIGNMENT 16
+#endif
+
+//--------------------------------------------
+// PLAN HANDLES
+//--------------------------------------------
+
+//FFTW plan for a given alignment of the input and output arrays
+struct PlanVariant {
+    int in_align;
+    int out_align;
+    void *plan;                     // fftw_plan or fftwf_plan
+};
+
+//description of the transform and its plans
+struct PlanHandle {
+    mxClassID class_id;             // precision of the arrays
+    std::vector<mwSize> dims;       // size of the arrays
+    std::vector<double> dtt_types;  // DTT type for each dimension (0 if not transformed)
+    dtt::PlanKey key;               // FFTW description (alignment is set for each variant)
+    double time_limit;              // planner time limit
+    double scale;                   // normalisation (1/M for inverse transforms, otherwise 1)
+    bool stats;                     // record the timing of each call using the handle
+    std::vector<PlanVariant> variants;
+};
+
+//handles indexed by the value returned to MATLAB
+static std::map<unsigned long long, PlanHandle> handles;
+static unsigned long long next_handle = 1;
+
+//return the plan for the alignment of the given arrays, creating it if
+//needed (returns NULL if FFTW cannot create the plan), plans are matched
+//using the alignment required by FFTW, so a new plan is only created if
+//FFTW requires it
+template <typename T>
+static typename dtt::FftwApi<T>::plan getPlan(PlanHandle &handle, T *in, T *out){
+    int in_align = (int) (((size_t) in) % DTT_FFTW_ALIGNMENT);
+    int out_align = (int) (((size_t) out) % DTT_FFTW_ALIGNMENT);
+    for (size_t i = 0; i < handle.variants.size(); i++){
+        if (handle.variants[i].in_align == in_align && handle.variants[i].out_align == out_align){
+            return (typename dtt::FftwApi<T>::plan) handle.variants[i].plan;
+        }
+    }
+    dtt::PlanKey key = handle.key;
+    key.in_align = dtt::alignmentOf(in);
+    key.out_align = dtt::alignmentOf(out);
+    typename dtt::FftwApi<T>::plan plan = dtt::planCache<T>().createPlan(key, in, out, handle.time_limit);
+    if (plan != NULL){
+        PlanVariant variant;
+        variant.in_align = in_align;
+        variant.out_align = out_align;
+        variant.plan = (void *) plan;
+        handle.variants.push_back(variant);
+    }
+    return plan;
+}
+
+//destroy the plans held by a handle
+static void destroyPlans(PlanHandle &handle){
+    for (size_t i = 0; i < handle.variants.size(); i++){
+        if (handle.class_id == mxSINGLE_CLASS){
+            dtt::FftwApi<float>::destroyPlan((dtt::FftwApi<float>::plan) handle.variants[i].plan);
+        } else {
+            dtt::FftwApi<double>::destroyPlan((dtt::FftwApi<double>::plan) handle.variants[i].plan);
+        }
+    }
+    handle.variants.clear();
+}
+
+//destroy all handles (called by dttPlan('clear'), which leaves the
+//implicit plan cache used by the other functions unchanged)
+static void clearHandles(){
+    for (std::map<unsigned long long, PlanHandle>::iterator it = handles.begin(); it != handles.end(); ++it){
+        destroyPlans(it->second);
+    }
+    handles.clear();
+}
+
+//destroy all handles and cached plans (registered with dtt::atExit)
+static void clearAll(){
+    clearHandles();
+    dtt::clearPlanCache();
+}
+
+//find the handle given as a MATLAB input
+static PlanHandle &getHandle(const mxArray *value, std::map<unsigned long long, PlanHandle>::iterator &it){
+    if (!(mxIsUint64(value) && mxGetNumberOfElements(value) == 1)){
+        mexErrMsgTxt("Input for PLAN must be a plan handle returned by dttPlan('create', ...).");
+    }
+    it = handles.find(*((unsigned long long *) mxGetData(value)));
+    if (it == handles.end()){
+        mexErrMsgTxt("Input for PLAN is not a valid plan handle (it may have been destroyed).");
+    }
+    return it->second;
+}
+
+//name of the planner rigor
+static const char *plannerName(unsigned flags){
+    if (flags & FFTW_ESTIMATE) return "estimate";
+    if (flags & FFTW_EXHAUSTIVE) return "exhaustive";
+    if (flags & FFTW_PATIENT) return "patient";
+    return "measure";
+}
+
+//--------------------------------------------
+// COMMANDS
+//--------------------------------------------
+
+//create a handle: plan = dttPlan('create', x, dtt_type, [dim], options...)
+static void createHandle(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]){
+
+    int numdims;
+    int DIM = 0;            // only set if the transform is along a single dimension
+    int first_option = 3;   // index of the first optional name/value input
+
+    //start timing the call (see dttStats.h)
+    dtt::CallStats stats("dttPlanCreate");
+
+    //check for proper number of arguments
+    if (nrhs < 3){
+        mexErrMsgTxt("At least three inputs are required to create a plan.");
+    } else if (nlhs > 1){
+        mexErrMsgTxt("Too many output arguments.");
+    }
+
+    //check the input matrix is real and double or single precision
+    if( !((mxIsDouble(prhs[1]) || mxIsSingle(prhs[1])) && !mxIsComplex(prhs[1])) ) {
+        mexErrMsgTxt("Input array must be double or single precision and real.");
+    }
+    if (mxIsEmpty(prhs[1])){
+        mexErrMsgTxt("Input array must not be empty.");
+    }
+    numdims = mxGetNumberOfDimensions(prhs[1]);
+    const mwSize *dims = mxGetDimensions(prhs[1]);
+
+    //optional dimension for a 1D transform
+    if (nrhs > 3 && !mxIsChar(prhs[3])){
+        double value;
+        if (!dtt::getScalar(prhs[3], value) || !(value >= 1) || value != (int) value){
+            mexErrMsgTxt("Input for DIM must be a positive integer.");
+        }
+        DIM = (int) value;
+        first_option = 4;
+    }
+
+    //get planner options from name/value pairs and global defaults
+    dtt::Options options = dtt::getOptions(nrhs, prhs, first_option);
+    stats.enable(options.stats);
+
+    //DTT type for each dimension (see dttOptions.h)
+    std::vector<ptrdiff_t> sz;
+    std::vector<double> dtt_types;
+    std::vector<int> axis_kinds;
+    dtt::getAxisKinds(prhs[1], prhs[2], DIM, sz, dtt_types, axis_kinds);
+
+    //describe the transform using guru64 dimensions (as in dttND, see
+    //dttCore.h)
+    PlanHandle handle;
+    handle.class_id = mxGetClassID(prhs[1]);
+    handle.dims.assign(dims, dims + numdims);
+    handle.dtt_types = dtt_types;
+    handle.time_limit = options.time_limit;
+    dtt::Transform transform = dtt::describeAxes(sz, axis_kinds);
+    handle.key.dims = transform.dims;
+    handle.key.howmany = transform.howmany;
+    handle.key.kinds = transform.kinds;
+    handle.scale = options.inverse ? dtt::invertKinds(handle.key.dims, handle.key.kinds) : 1.0;
+    handle.key.in_place = options.in_place;
+    handle.key.flags = options.planner;
+    handle.key.threads = dtt::getThreads(options, mxGetNumberOfElements(prhs[1]));
+    handle.stats = options.stats;
+    stats.mark(DTT_PHASE_VALIDATE);
+
+    //create the plan for the alignment of the input array, and an output
+    //array allocated by MATLAB (x is not modified)
+    mxArray *output_mat = options.in_place ? NULL : mxCreateUninitNumericArray(numdims, dims, handle.class_id, mxREAL);
+    void *input_ptr = mxGetData(prhs[1]);
+    void *output_ptr = options.in_place ? input_ptr : mxGetData(output_mat);
+    stats.mark(DTT_PHASE_ALLOCATE);
+    bool success;
+    if (handle.class_id == mxSINGLE_CLASS){
+        success = getPlan(handle, (float *) input_ptr, (float *) output_ptr) != NULL;
+    } else {
+        success = getPlan(handle, (double *) input_ptr, (double *) output_ptr) != NULL;
+    }
+    stats.mark(DTT_PHASE_PLAN);
+    if (output_mat != NULL){
+        mxDestroyArray(output_mat);
+    }
+    if (!success){
+        mexErrMsgTxt("FFTW plan could not be created.");
+    }
+
+    //store the handle and return its value
+    unsigned long long value = next_handle++;
+    handles[value] = handle;
+    plhs[0] = mxCreateNumericMatrix(1, 1, mxUINT64_CLASS, mxREAL);
+    *((unsigned long long *) mxGetData(plhs[0])) = value;
+    stats.finish();
+
+}
+
+//execute a handle: X = dttPlan('execute', plan, x)
+static void executeHandle(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]){
+
+    std::map<unsigned long long, PlanHandle>::iterator it;
+
+    //start timing the call, which is recorded if the Stats option was
+    //set when the handle was created (see dttStats.h)
+    dtt::CallStats stats("dttPlanExecute");
+
+    //check for proper number of arguments
+    if (nrhs != 3){
+        mexErrMsgTxt("Three inputs are required to execute a plan.");
+    }
+    PlanHandle &handle = getHandle(prhs[1], it);
+    stats.enable(handle.stats);
+    if (handle.key.in_place && nlhs != 0){
+        mexErrMsgTxt("In-place plans must be executed without an output argument.");
+    } else if (!handle.key.in_place && nlhs > 1){
+        mexErrMsgTxt("Too many output arguments.");
+    }
+
+    //check the input array matches the plan
+    if (mxGetClassID(prhs[2]) != handle.class_id || mxIsComplex(prhs[2])){
+        mexErrMsgTxt("Input array must be real and have the same precision as the plan.");
+    }
+    int numdims = mxGetNumberOfDimensions(prhs[2]);
+    const mwSize *dims = mxGetDimensions(prhs[2]);
+    if (numdims != (int) handle.dims.size() || !std::equal(dims, dims + numdims, handle.dims.begin())){
+        mexErrMsgTxt("Input array must have the same size as the plan.");
+    }
+
+    //create MATLAB output, or for in-place plans, write the output to the
+    //input array (the output is not zero-filled as every element is
+    //written by FFTW)
+    stats.mark(DTT_PHASE_VALIDATE);
+    void *input_ptr = mxGetData(prhs[2]);
+    void *output_ptr = input_ptr;
+    if (!handle.key.in_place){
+        plhs[0] = mxCreateUninitNumericArray(numdims, dims, handle.class_id, mxREAL);
+        output_ptr = mxGetData(plhs[0]);
+    }
+    stats.mark(DTT_PHASE_ALLOCATE);
+
+    //execute the plan for the alignment of the arrays
+    bool success = false;
+    if (handle.class_id == mxSINGLE_CLASS){
+        dtt::FftwApi<float>::plan plan = getPlan(handle, (float *) input_ptr, (float *) output_ptr);
+        stats.mark(DTT_PHASE_PLAN);
+        if (plan != NULL){
+            dtt::FftwApi<float>::executeR2r(plan, (float *) input_ptr, (float *) output_ptr);
+            if (handle.scale != 1.0){
+                dtt::scaleArray((float *) output_ptr, (ptrdiff_t) mxGetNumberOfElements(prhs[2]), (float) handle.scale, handle.key.threads);
+            }
+            success = true;
+        }
+    } else {
+        dtt::FftwApi<double>::plan plan = getPlan(handle, (double *) input_ptr, (double *) output_ptr);
+        stats.mark(DTT_PHASE_PLAN);
+        if (plan != NULL){
+            dtt::FftwApi<double>::executeR2r(plan, (double *) input_ptr, (double *) output_ptr);
+            if (handle.scale != 1.0){
+                dtt::scaleArray((double *) output_ptr, (ptrdiff_t) mxGetNumberOfElements(prhs[2]), handle.scale, handle.key.threads);
+            }
+            success = true;
+        }
+    }
+    if (!success){
+        mexErrMsgTxt("FFTW plan could not be created.");
+    }
+    stats.mark(DTT_PHASE_EXECUTE);
+    stats.addBytes(2.0 * mxGetNumberOfElements(prhs[2]) * mxGetElementSize(prhs[2]));
+    stats.finish();
+
+}
+
+//destroy a handle: dttPlan('destroy', plan)
+static void destroyHandle(int nlhs, int nrhs, const mxArray *prhs[]){
+    std::map<unsigned long long, PlanHandle>::iterator it;
+    if (nrhs != 2){
+        mexErrMsgTxt("Two inputs are required to destroy a plan.");
+    } else if (nlhs > 0){
+        mexErrMsgTxt("Too many output arguments.");
+    }
+    PlanHandle &handle = getHandle(prhs[1], it);
+    dtt::CallStats stats("dttPlanDestroy");
+    stats.enable(handle.stats);
+    stats.mark(DTT_PHASE_VALIDATE);
+    destroyPlans(handle);
+    handles.erase(it);
+    stats.finish();
+}
+
+//describe a handle: info = dttPlan('info', plan)
+static void describeHandle(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]){
+
+    std::map<unsigned long long, PlanHandle>::iterator it;
+    if (nrhs != 2){
+        mexErrMsgTxt("Two inputs are required to describe a plan.");
+    } else if (nlhs > 1){
+        mexErrMsgTxt("Too many output arguments.");
+    }
+    PlanHandle &handle = getHandle(prhs[1], it);
+
+    const char *field_names[] = {"Size", "DttType", "Precision", "Planner", "Threads", "InPlace", "Inverse", "NumPlans"};
+    plhs[0] = mxCreateStructMatrix(1, 1, 8, field_names);
+    mxArray *size_mat = mxCreateDoubleMatrix(1, handle.dims.size(), mxREAL);
+    for (size_t i = 0; i < handle.dims.size(); i++){
+        mxGetPr(size_mat)[i] = (double) handle.dims[i];
+    }
+    mxArray *type_mat = mxCreateDoubleMatrix(1, handle.dtt_types.size(), mxREAL);
+    for (size_t i = 0; i < handle.dtt_types.size(); i++){
+        mxGetPr(type_mat)[i] = handle.dtt_types[i];
+    }
+    mxSetField(plhs[0], 0, "Size", size_mat);
+    mxSetField(plhs[0], 0, "DttType", type_mat);
+    mxSetField(plhs[0], 0, "Precision", mxCreateString(handle.class_id == mxSINGLE_CLASS ? "single" : "double"));
+    mxSetField(plhs[0], 0, "Planner", mxCreateString(plannerName(handle.key.flags)));
+    mxSetField(plhs[0], 0, "Threads", mxCreateDoubleScalar(handle.key.threads));
+    mxSetField(plhs[0], 0, "InPlace", mxCreateLogicalScalar(handle.key.in_place));
+    mxSetField(plhs[0], 0, "Inverse", mxCreateLogicalScalar(handle.scale != 1.0));
+    mxSetField(plhs[0], 0, "NumPlans", mxCreateDoubleScalar((double) handle.variants.size()));
+
+}
+
+DTT_MEX_FUNCTION(dttPlan)
+{
+
+    //release plan handles and cached FFTW plans when the mex file is
+    //cleared
+    dtt::atExit(clearAll);
+
+    //get the command
+    char command[16];
+    if (nrhs < 1 || !dtt::getString(prhs[0], command, sizeof(command))){
+        mexErrMsgTxt("The first input must be 'create', 'execute', 'destroy', 'info', or 'clear'.");
+    }
+
+    if (dtt::equalsIgnoreCase(command, "execute")){
+        executeHandle(nlhs, plhs, nrhs, prhs);
+    } else if (dtt::equalsIgnoreCase(command, "create")){
+        createHandle(nlhs, plhs, nrhs, prhs);
+    } else if (dtt::equalsIgnoreCase(command, "destroy")){
+        destroyHandle(nlhs, nrhs, prhs);
+    } else if (dtt::equalsIgnoreCase(command, "info")){
+        describeHandle(nlhs, plhs, nrhs, prhs);
+    } else if (dtt::equalsIgnoreCase(command, "clear")){
+        if (nrhs != 1 || nlhs > 0){
+            mexErrMsgTxt("dttPlan('clear') doesn't take any other inputs or outputs.");
+        }
+        clearHandles();
+    } else {
+        mexErrMsgTxt("The first input must be 'create', 'execute', 'destroy', 'info', or 'clear'.");
+    }
+
+    return;
+}
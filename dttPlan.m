@@ -0,0 +1,109 @@
+function varargout = dttPlan(varargin)
+%DTTPLAN Create, execute, and destroy explicit DTT plan handles.
+%
+% DESCRIPTION:
+%     dttPlan gives explicit control over the FFTW plans used to compute
+%     discrete trigonometric transforms (DTTs). A plan is created once for
+%     a given array size, precision, and DTT type, and returned as an
+%     opaque handle. The handle can then be executed repeatedly on arrays
+%     of the same size and precision, so the cost of each execution is a
+%     single handle lookup followed by the FFTW execution. This is
+%     intended for use in time-stepping loops, where the plans are created
+%     before the loop and destroyed afterwards.
+%
+%     The other DTT functions (dtt1D, dtt2D, dtt3D, and dttND) use an
+%     implicit cache of plans, which may evict plans if many different
+%     transforms are used. Plans held by a handle are never evicted, and
+%     are only destroyed by dttPlan('destroy', plan), dttPlan('clear'), or
+%     clearing the mex function (e.g., using clear mex). dttPlan('clear')
+%     destroys every plan handle, but doesn't affect the implicit cache
+%     used by the other functions.
+%
+%     The DTT type is given in the same way as dttND, with one type for
+%     each dimension of x (where 0 means the dimension is not
+%     transformed), or a scalar to transform every dimension. If dim is
+%     given, the transform is only taken along dim, equivalent to dtt1D.
+%
+%     For compilation instructions, see compileDttMex.
+%
+% USAGE:
+%     plan = dttPlan('create', x, dtt_type)
+%     plan = dttPlan('create', x, dtt_type, dim)
+%     plan = dttPlan('create', ..., 'Planner', 'measure')
+%     X = dttPlan('execute', plan, x)
+%     dttPlan('execute', plan, x)    (for plans created with 'InPlace')
+%     info = dttPlan('info', plan)
+%     dttPlan('destroy', plan)
+%     dttPlan('clear')
+%
+% INPUTS:
+%     x             - Array in double or single precision. When creating
+%                     a plan, x defines the size and precision of the
+%                     arrays the plan can be executed on (the values of x
+%                     are not modified).
+%     dtt_type      - Type of discrete trigonometric transform for each
+%                     dimension of x, specified as an integer between 0
+%                     and 8:
+%
+%                         0: not transformed
+%                         1: DCT-I    WSWS
+%                         2: DCT-II   HSHS
+%                         3: DCT-III  WSWA
+%                         4: DCT-IV   HSHA
+%                         5: DST-I    WAWA
+%                         6: DST-II   HAHA
+%                         7: DST-III  WAWS
+%                         8: DST-IV   HAHS
+%
+%                     If dtt_type is a scalar, the same transform is
+%                     taken over every dimension of x (or only dim if
+%                     given).
+%     plan          - Plan handle returned by dttPlan('create', ...).
+%
+% OPTIONAL INPUTS:
+%     dim           - Dimension over which a 1D transform is taken.
+%
+%     The options 'Planner', 'TimeLimit', 'Threads', 'InPlace', and
+%     'Inverse' can be given as name/value pairs when creating a plan, and
+%     are stored in the handle (see dtt1D). Plans created with 'InPlace'
+%     set to true overwrite the input array, and must be executed without
+%     an output argument. Plans created with 'Inverse' set to true compute
+%     the normalised inverse of the given DTT type.
+%
+% OUTPUTS:
+%     plan          - Plan handle (uint64 scalar).
+%     X             - Discrete trigonometric transform of x, returned
+%                     with the same precision as x.
+%     info          - Structure describing the plan, with the fields
+%                     Size, DttType, Precision, Planner, Threads, InPlace,
+%                     Inverse, and NumPlans (the number of FFTW plans held by the
+%                     handle, where an extra plan is created if the
+%                     handle is executed on an array with a different
+%                     memory alignment).
+%
+% ABOUT:
+%     author        - Bradley Treeby
+%     date          - 16 October 2026
+%     last update   - 16 October 2026
+%
+% Copyright (C) 2026 Bradley Treeby
+%
+% See also dtt1D, dttND, dttOptions, dttWisdom
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+%
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+% call the function in the unified dttmex binary (if dttPlan has been
+% compiled as a separate mex function, the mex function is called
+% instead of this file, see compileDttMex)
+[varargout{1:nargout}] = dttmex('plan', varargin{:});
@@ -0,0 +1,423 @@
+/**************************************************************************
+ * Process-lifetime cache of FFTW plans used by the dtt mex functions.
+ *
+ * Each transform is described using the FFTW guru64 interface (transform
+ * dimensions, loop dimensions, and r2r kinds) together with the alignment
+ * of the input and output arrays and whether the transform is in place.
+ * The first call for a given description creates the plan, and later
+ * calls with a matching description re-use the same plan on new arrays
+ * via fftw_execute_r2r. Plans are kept until clearPlanCache is called,
+ * which the mex functions register using dtt::atExit (see dttMex.h). When
+ * the functions are compiled into the unified dttmex binary, there is a
+ * single cache shared by all of the functions.
+ *
+ * Plans created using FFTW_ESTIMATE are planned directly on the arrays
+ * being transformed. The other planner flags (FFTW_MEASURE, FFTW_PATIENT,
+ * and FFTW_EXHAUSTIVE) overwrite the arrays during planning, so these
+ * plans are created using scratch arrays with the same alignment.
+ *
+ * Plans can use multiple threads via the FFTW threads library, which is
+ * initialised the first time a multi-threaded plan is created. The number
+ * of threads is part of the cache key.
+ *
+ * The cache is templated on the floating point type. FftwApi<double> and
+ * FftwApi<float> map to the fftw_ and fftwf_ interfaces, and each
+ * precision has its own cache of plans. Complex plans used by the chirp
+ * path are cached separately (see dttChirp.h), and are also destroyed by
+ * clearPlanCache.
+ *
+ * The number of cache hits and misses is always counted, and while
+ * timing is enabled (see dttStats.h), the time spent looking up and
+ * creating plans is also accumulated.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_PLAN_CACHE_H
+#define DTT_PLAN_CACHE_H
+
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <vector>
+#include "fftw3.h"
+
+//maximum number of plans kept before the least recently used is destroyed
+#ifndef DTT_PLAN_CACHE_SIZE
+#define DTT_PLAN_CACHE_SIZE 128
+#endif
+
+namespace dtt {
+
+//--------------------------------------------
+// PRECISION
+//--------------------------------------------
+
+//FFTW interface for each floating point type
+template <typename T> struct FftwApi;
+
+template <> struct FftwApi<double> {
+    typedef fftw_plan plan;
+    static plan planGuru64R2r(int rank, const fftw_iodim64 *dims, int howmany_rank, const fftw_iodim64 *howmany_dims,
+            double *in, double *out, const fftw_r2r_kind *kinds, unsigned flags){
+        return fftw_plan_guru64_r2r(rank, dims, howmany_rank, howmany_dims, in, out, kinds, flags);
+    }
+    static void executeR2r(const plan p, double *in, double *out) { fftw_execute_r2r(p, in, out); }
+    static void destroyPlan(plan p) { fftw_destroy_plan(p); }
+    static int initThreads() { return fftw_init_threads(); }
+    static void planWithNThreads(int threads) { fftw_plan_with_nthreads(threads); }
+    static void setTimeLimit(double time_limit) { fftw_set_timelimit(time_limit); }
+    static void *allocate(size_t n) { return fftw_malloc(n); }
+    static void deallocate(void *p) { fftw_free(p); }
+    typedef fftw_complex complex;
+    static plan planGuru64Dft(int rank, const fftw_iodim64 *dims, int howmany_rank, const fftw_iodim64 *howmany_dims,
+            complex *in, complex *out, int sign, unsigned flags){
+        return fftw_plan_guru64_dft(rank, dims, howmany_rank, howmany_dims, in, out, sign, flags);
+    }
+    static void executeDft(const plan p, complex *in, complex *out) { fftw_execute_dft(p, in, out); }
+};
+
+template <> struct FftwApi<float> {
+    typedef fftwf_plan plan;
+    static plan planGuru64R2r(int rank, const fftw_iodim64 *dims, int howmany_rank, const fftw_iodim64 *howmany_dims,
+            float *in, float *out, const fftw_r2r_kind *kinds, unsigned flags){
+        return fftwf_plan_guru64_r2r(rank, dims, howmany_rank, howmany_dims, in, out, kinds, flags);
+    }
+    static void executeR2r(const plan p, float *in, float *out) { fftwf_execute_r2r(p, in, out); }
+    static void destroyPlan(plan p) { fftwf_destroy_plan(p); }
+    static int initThreads() { return fftwf_init_threads(); }
+    static void planWithNThreads(int threads) { fftwf_plan_with_nthreads(threads); }
+    static void setTimeLimit(double time_limit) { fftwf_set_timelimit(time_limit); }
+    static void *allocate(size_t n) { return fftwf_malloc(n); }
+    static void deallocate(void *p) { fftwf_free(p); }
+    typedef fftwf_complex complex;
+    static plan planGuru64Dft(int rank, const fftw_iodim64 *dims, int howmany_rank, const fftw_iodim64 *howmany_dims,
+            complex *in, complex *out, int sign, unsigned flags){
+        return fftwf_plan_guru64_dft(rank, dims, howmany_rank, howmany_dims, in, out, sign, flags);
+    }
+    static void executeDft(const plan p, complex *in, complex *out) { fftwf_execute_dft(p, in, out); }
+};
+
+//--------------------------------------------
+// PLAN DESCRIPTION
+//--------------------------------------------
+
+//description of a real-to-real transform, used as the cache key
+struct PlanKey {
+    std::vector<fftw_iodim64> dims;     // transform dimensions
+    std::vector<fftw_iodim64> howmany;  // loop dimensions
+    std::vector<int> kinds;             // fftw_r2r_kind for each transform dimension
+    int in_align;                       // alignment of the input array
+    int out_align;                      // alignment of the output array
+    bool in_place;                      // input and output arrays are the same
+    unsigned flags;                     // planner flags
+    int threads;                        // number of threads used by the plan
+};
+
+//lexicographic comparison of iodims
+inline int compareDims(const std::vector<fftw_iodim64> &a, const std::vector<fftw_iodim64> &b){
+    if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+    for (size_t i = 0; i < a.size(); i++){
+        if (a[i].n  != b[i].n)  return a[i].n  < b[i].n  ? -1 : 1;
+        if (a[i].is != b[i].is) return a[i].is < b[i].is ? -1 : 1;
+        if (a[i].os != b[i].os) return a[i].os < b[i].os ? -1 : 1;
+    }
+    return 0;
+}
+
+inline bool operator<(const PlanKey &a, const PlanKey &b){
+    int c = compareDims(a.dims, b.dims);
+    if (c != 0) return c < 0;
+    c = compareDims(a.howmany, b.howmany);
+    if (c != 0) return c < 0;
+    if (a.kinds != b.kinds) return a.kinds < b.kinds;
+    if (a.in_align != b.in_align) return a.in_align < b.in_align;
+    if (a.out_align != b.out_align) return a.out_align < b.out_align;
+    if (a.in_place != b.in_place) return a.in_place < b.in_place;
+    if (a.flags != b.flags) return a.flags < b.flags;
+    return a.threads < b.threads;
+}
+
+//alignment of an array in bytes; FFTW only requires plans to be executed
+//on arrays with the same alignment (modulo 16 bytes) as the planning
+//arrays, so using a larger modulus is always safe
+inline int alignmentOf(const void *ptr){
+    return (int)(((size_t) ptr) % 64);
+}
+
+//helper to fill a guru64 iodim
+inline fftw_iodim64 iodim(ptrdiff_t n, ptrdiff_t is, ptrdiff_t os){
+    fftw_iodim64 dim;
+    dim.n = n;
+    dim.is = is;
+    dim.os = os;
+    return dim;
+}
+
+//number of elements spanned by an array with the given dimensions and
+//loop dimensions (strides are always positive)
+inline ptrdiff_t arrayExtent(const std::vector<fftw_iodim64> &dims, const std::vector<fftw_iodim64> &howmany, bool input){
+    ptrdiff_t extent = 1;
+    for (size_t i = 0; i < dims.size(); i++){
+        extent += (dims[i].n - 1) * (input ? dims[i].is : dims[i].os);
+    }
+    for (size_t i = 0; i < howmany.size(); i++){
+        extent += (howmany[i].n - 1) * (input ? howmany[i].is : howmany[i].os);
+    }
+    return extent;
+}
+
+//create a key for the given arrays
+inline PlanKey makePlanKey(const std::vector<fftw_iodim64> &dims, const std::vector<fftw_iodim64> &howmany,
+        const std::vector<int> &kinds, const void *in, const void *out, unsigned flags, int threads){
+    PlanKey key;
+    key.dims = dims;
+    key.howmany = howmany;
+    key.kinds = kinds;
+    key.in_align = alignmentOf(in);
+    key.out_align = alignmentOf(out);
+    key.in_place = (in == out);
+    key.flags = flags;
+    key.threads = threads;
+    return key;
+}
+
+//--------------------------------------------
+// COUNTERS
+//--------------------------------------------
+
+//wall clock time in seconds
+inline double wallTime(){
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//plan cache hits and misses for both precisions, and the time spent in
+//PlanCache::get while timing is set
+struct PlanCounters {
+    bool timing;                // accumulate the time spent in get
+    unsigned long long hits;    // plans found in the cache
+    unsigned long long misses;  // plans created
+    double time;                // time spent looking up and creating plans in seconds
+};
+
+inline PlanCounters &planCounters(){
+    static PlanCounters counters = {false, 0, 0, 0.0};
+    return counters;
+}
+
+//--------------------------------------------
+// PLAN CACHE
+//--------------------------------------------
+
+template <typename T>
+class PlanCache {
+
+public:
+
+    typedef FftwApi<T> Api;
+    typedef typename Api::plan Plan;
+
+    PlanCache() : tick_(0), threads_initialised_(false) {}
+    ~PlanCache() { clear(); }
+
+    //return a plan matching the key, creating it if it doesn't already
+    //exist (returns NULL if FFTW cannot create the plan), the time limit
+    //is only used if a new plan is created
+    Plan get(const PlanKey &key, T *in, T *out, double time_limit){
+        PlanCounters &counters = planCounters();
+        if (!counters.timing){
+            return lookup(key, in, out, time_limit, counters);
+        }
+        double start = wallTime();
+        Plan plan = lookup(key, in, out, time_limit, counters);
+        counters.time += wallTime() - start;
+        return plan;
+    }
+
+    //create a plan matching the key without adding it to the cache, the
+    //caller is responsible for destroying the plan (returns NULL if FFTW
+    //cannot create the plan)
+    Plan createPlan(const PlanKey &key, T *in, T *out, double time_limit){
+
+        //the r2r kinds are stored as int in the key
+        std::vector<fftw_r2r_kind> kinds(key.kinds.size());
+        for (size_t i = 0; i < kinds.size(); i++){
+            kinds[i] = (fftw_r2r_kind) key.kinds[i];
+        }
+
+        //set the number of threads, initialising the threads library the
+        //first time it is needed
+        if (!threads_initialised_ && key.threads > 1){
+            threads_initialised_ = (Api::initThreads() != 0);
+        }
+        if (threads_initialised_){
+            Api::planWithNThreads(key.threads > 1 ? key.threads : 1);
+        }
+
+        Api::setTimeLimit(time_limit);
+        if (key.flags & FFTW_ESTIMATE){
+            return create(key, kinds, in, out);
+        } else {
+            return createWithScratch(key, kinds);
+        }
+
+    }
+
+    //destroy all plans
+    void clear(){
+        for (typename std::map<PlanKey, Entry>::iterator it = plans_.begin(); it != plans_.end(); ++it){
+            Api::destroyPlan(it->second.plan);
+        }
+        plans_.clear();
+    }
+
+    size_t size() const { return plans_.size(); }
+
+private:
+
+    struct Entry {
+        Plan plan;
+        unsigned long long last_used;
+    };
+
+    //find the plan matching the key, or create and store a new plan
+    Plan lookup(const PlanKey &key, T *in, T *out, double time_limit, PlanCounters &counters){
+
+        //re-use existing plan
+        typename std::map<PlanKey, Entry>::iterator it = plans_.find(key);
+        if (it != plans_.end()){
+            it->second.last_used = ++tick_;
+            counters.hits++;
+            return it->second.plan;
+        }
+
+        //create a new plan
+        counters.misses++;
+        Plan plan = createPlan(key, in, out, time_limit);
+        if (plan == NULL){
+            return NULL;
+        }
+
+        //make space if needed and store
+        if (plans_.size() >= DTT_PLAN_CACHE_SIZE){
+            evictOldest();
+        }
+        Entry entry;
+        entry.plan = plan;
+        entry.last_used = ++tick_;
+        plans_[key] = entry;
+        return plan;
+
+    }
+
+    Plan create(const PlanKey &key, const std::vector<fftw_r2r_kind> &kinds, T *in, T *out){
+        return Api::planGuru64R2r((int) key.dims.size(), key.dims.empty() ? NULL : &key.dims[0],
+                (int) key.howmany.size(), key.howmany.empty() ? NULL : &key.howmany[0],
+                in, out, kinds.empty() ? NULL : &kinds[0], key.flags);
+    }
+
+    //plan using scratch arrays offset to match the alignment in the key
+    Plan createWithScratch(const PlanKey &key, const std::vector<fftw_r2r_kind> &kinds){
+        ptrdiff_t in_extent = arrayExtent(key.dims, key.howmany, true);
+        ptrdiff_t out_extent = arrayExtent(key.dims, key.howmany, false);
+        char *in_buffer = (char *) Api::allocate(in_extent * sizeof(T) + 64);
+        char *out_buffer = key.in_place ? NULL : (char *) Api::allocate(out_extent * sizeof(T) + 64);
+        if (in_buffer == NULL || (!key.in_place && out_buffer == NULL)){
+            if (in_buffer != NULL) Api::deallocate(in_buffer);
+            if (out_buffer != NULL) Api::deallocate(out_buffer);
+            return NULL;
+        }
+        T *in = (T *) (in_buffer + (key.in_align - alignmentOf(in_buffer) + 64) % 64);
+        T *out = key.in_place ? in : (T *) (out_buffer + (key.out_align - alignmentOf(out_buffer) + 64) % 64);
+        Plan plan = create(key, kinds, in, out);
+        Api::deallocate(in_buffer);
+        if (out_buffer != NULL) Api::deallocate(out_buffer);
+        return plan;
+    }
+
+    void evictOldest(){
+        typename std::map<PlanKey, Entry>::iterator oldest = plans_.begin();
+        for (typename std::map<PlanKey, Entry>::iterator it = plans_.begin(); it != plans_.end(); ++it){
+            if (it->second.last_used < oldest->second.last_used){
+                oldest = it;
+            }
+        }
+        Api::destroyPlan(oldest->second.plan);
+        plans_.erase(oldest);
+    }
+
+    std::map<PlanKey, Entry> plans_;
+    unsigned long long tick_;
+    bool threads_initialised_;
+
+};
+
+//cache instance for each precision (one per mex binary)
+template <typename T>
+inline PlanCache<T> &planCache(){
+    static PlanCache<T> cache;
+    return cache;
+}
+
+//functions that destroy plans cached outside the plan cache (e.g., the
+//complex plans used by dttChirp.h), called by clearPlanCache
+typedef void (*ClearFunction)();
+
+inline std::vector<ClearFunction> &clearFunctions(){
+    static std::vector<ClearFunction> functions;
+    return functions;
+}
+
+inline void addClearFunction(ClearFunction fn){
+    std::vector<ClearFunction> &functions = clearFunctions();
+    for (size_t i = 0; i < functions.size(); i++){
+        if (functions[i] == fn) return;
+    }
+    functions.push_back(fn);
+}
+
+//destroy all cached plans (registered with dtt::atExit)
+inline void clearPlanCache(){
+    planCache<double>().clear();
+    planCache<float>().clear();
+    std::vector<ClearFunction> &functions = clearFunctions();
+    for (size_t i = 0; i < functions.size(); i++){
+        functions[i]();
+    }
+}
+
+//execute the transform described by dims, howmany, and kinds from in to
+//out using a cached plan created with the given planner flags and number
+//of threads, returns false if the plan could not be created
+template <typename T>
+inline bool executeTransform(const std::vector<fftw_iodim64> &dims, const std::vector<fftw_iodim64> &howmany,
+        const std::vector<int> &kinds, T *in, T *out, unsigned flags, double time_limit, int threads){
+    PlanKey key = makePlanKey(dims, howmany, kinds, in, out, flags, threads);
+    typename FftwApi<T>::plan plan = planCache<T>().get(key, in, out, time_limit);
+    if (plan == NULL){
+        return false;
+    }
+    FftwApi<T>::executeR2r(plan, in, out);
+    return true;
+}
+
+} // namespace dtt
+
+#endif
@@ -0,0 +1,192 @@
+/**************************************************************************
+ * Poisson and Helmholtz solver using discrete trigonometric transforms.
+ *
+ * The equation (d^2/dx^2 + d^2/dy^2 + ... + shift) u = f is solved on a
+ * regular grid with a Neumann (N) or Dirichlet (D) boundary condition on
+ * each face. Each combination of boundary conditions on a dimension
+ * corresponds to one of the 8 DTTs, whose basis functions are the
+ * eigenfunctions of the second derivative with those boundary conditions.
+ * For a cell-centred grid (where the boundaries lie half a grid point
+ * outside the first and last points), the half-sample symmetric DTTs are
+ * used:
+ *
+ *     NN: DCT-II   HSHS        DD: DST-II   HAHA
+ *     ND: DCT-IV   HSHA        DN: DST-IV   HAHS
+ *
+ * and for a node-centred grid (where Neumann boundaries lie on the first
+ * or last point, and Dirichlet boundaries lie one grid point outside the
+ * array, where u = 0), the whole-sample symmetric DTTs are used:
+ *
+ *     NN: DCT-I    WSWS        DD: DST-I    WAWA
+ *     ND: DCT-III  WSWA        DN: DST-III  WAWS
+ *
+ * The solution is computed by taking the forward transform of f,
+ * multiplying by 1 / (lambda + shift), where lambda is the sum of the
+ * eigenvalues of the second derivative along each dimension, and taking
+ * the inverse transform. The eigenvalues are either spectral (-k^2), or
+ * those of the second-order finite difference Laplacian
+ * (-(2 sin(k dx / 2) / dx)^2), which is diagonalised exactly by the same
+ * transforms. The multiplier also includes the 1/M normalisation of the
+ * inverse transform, so the solve is two transforms and a single
+ * multiplication. Modes where lambda + shift is zero (e.g., the mean for
+ * the pure Neumann Poisson problem) are set to zero. Both transforms are
+ * computed by dtt::execute with the auto strategy, so badly factored
+ * lengths use the chirp path in dttChirp.h.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_POISSON_H
+#define DTT_POISSON_H
+
+#include <cmath>
+#include <vector>
+#include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttExecute.h"
+#include "dttInverse.h"
+
+//grid types
+#define DTT_GRID_CELL 0
+#define DTT_GRID_NODE 1
+
+//eigenvalues used for the Laplacian
+#define DTT_EIGENVALUES_SPECTRAL 0
+#define DTT_EIGENVALUES_FD 1
+
+namespace dtt {
+
+//FFTW kind of the forward transform for the boundary conditions on each
+//face of a dimension (true for Dirichlet, false for Neumann)
+inline int poissonKind(bool dirichlet_start, bool dirichlet_end, int grid){
+    if (grid == DTT_GRID_NODE){
+        if (dirichlet_start){
+            return dirichlet_end ? FFTW_RODFT00 : FFTW_RODFT01;
+        }
+        return dirichlet_end ? FFTW_REDFT01 : FFTW_REDFT00;
+    }
+    if (dirichlet_start){
+        return dirichlet_end ? FFTW_RODFT10 : FFTW_RODFT11;
+    }
+    return dirichlet_end ? FFTW_REDFT11 : FFTW_REDFT10;
+}
+
+//wavenumber of mode m (counting from zero) of a transform of length n
+//with grid spacing dx
+inline double poissonWavenumber(int kind, ptrdiff_t m, ptrdiff_t n, double dx){
+    const double pi = 3.14159265358979323846;
+    switch (kind) {
+        case FFTW_REDFT00: return pi * (double) m / ((double) (n - 1) * dx);
+        case FFTW_RODFT00: return pi * (double) (m + 1) / ((double) (n + 1) * dx);
+        case FFTW_REDFT10: return pi * (double) m / ((double) n * dx);
+        case FFTW_RODFT10: return pi * (double) (m + 1) / ((double) n * dx);
+        default: return pi * ((double) m + 0.5) / ((double) n * dx);
+    }
+}
+
+//eigenvalues of the second derivative for each mode of a dimension
+inline void poissonEigenvalues(int kind, ptrdiff_t n, double dx, int eigenvalues, std::vector<double> &lambda){
+    lambda.resize(n);
+    for (ptrdiff_t m = 0; m < n; m++){
+        double k = poissonWavenumber(kind, m, n, dx);
+        if (eigenvalues == DTT_EIGENVALUES_FD){
+            double s = 2.0 * std::sin(0.5 * k * dx) / dx;
+            lambda[m] = -s * s;
+        } else {
+            lambda[m] = -k * k;
+        }
+    }
+}
+
+//compute the multiplier applied to the transform of f for an array with
+//the given size (fastest varying dimension first), where the transform
+//is taken along the dimensions with kinds[d] >= 0 (other dimensions have
+//eigenvalue zero), and scale is the normalisation of the inverse
+template <typename T>
+inline void poissonMultiplier(const std::vector<ptrdiff_t> &sz, const std::vector<int> &kinds, const std::vector<double> &dx,
+        double shift, int eigenvalues, double scale, std::vector<T> &multiplier){
+
+    //eigenvalues along each dimension
+    size_t numdims = sz.size();
+    std::vector<std::vector<double> > lambda(numdims);
+    ptrdiff_t numel = 1;
+    for (size_t d = 0; d < numdims; d++){
+        if (kinds[d] >= 0){
+            poissonEigenvalues(kinds[d], sz[d], dx[d], eigenvalues, lambda[d]);
+        } else {
+            lambda[d].assign(sz[d], 0.0);
+        }
+        numel *= sz[d];
+    }
+
+    //sum the eigenvalues over the dimensions, stepping through the array
+    //in memory order using a counter for each dimension
+    multiplier.resize(numel);
+    std::vector<ptrdiff_t> index(numdims, 0);
+    for (ptrdiff_t i = 0; i < numel; i++){
+        double sum = shift;
+        for (size_t d = 0; d < numdims; d++){
+            sum += lambda[d][index[d]];
+        }
+        multiplier[i] = (sum == 0.0) ? (T) 0 : (T) (scale / sum);
+        for (size_t d = 0; d < numdims && ++index[d] == sz[d]; d++){
+            index[d] = 0;
+        }
+    }
+
+}
+
+//solve for u given f (which can be the same array), where t describes
+//the forward transform (as in dtt::execute), and multiplier is computed
+//by poissonMultiplier
+template <typename T>
+inline bool poissonSolve(const Transform &t, const std::vector<T> &multiplier, T *f, T *u, const Options &options,
+        int threads){
+
+    //the transforms are unnormalised (the normalisation is included in
+    //the multiplier), and use the auto strategy
+    Options transform_options = options;
+    transform_options.strategy = DTT_STRATEGY_AUTO;
+    transform_options.inverse = false;
+
+    //forward transform
+    if (!execute(t, f, u, transform_options, threads)){
+        return false;
+    }
+
+    //divide by the eigenvalues (including the normalisation)
+    ptrdiff_t numel = (ptrdiff_t) multiplier.size();
+    const T *m = &multiplier[0];
+    for (ptrdiff_t i = 0; i < numel; i++){
+        u[i] *= m[i];
+    }
+
+    //inverse transform (in place)
+    Transform inverse = t;
+    for (size_t i = 0; i < inverse.kinds.size(); i++){
+        inverse.kinds[i] = inverseKind(inverse.kinds[i]);
+    }
+    return execute(inverse, u, u, transform_options, threads);
+
+}
+
+} // namespace dtt
+
+#endif
@@ -0,0 +1,282 @@
+/**************************************************************************
+ * MEX file to solve the Poisson or Helmholtz equation on a regular grid
+ * with Neumann or Dirichlet boundary conditions on each face using
+ * discrete trigonometric transforms. The forward transform, division by
+ * the eigenvalues of the Laplacian, and inverse transform are computed in
+ * a single call using cached FFTW plans, and the eigenvalue multiplier is
+ * cached so repeated solves with the same grid and boundary conditions
+ * (e.g., within a time-stepping loop) only compute the transforms (see
+ * dttPoisson.h). See dttPoissonSolve.m for usage notes.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#include <cstring>
+#include <vector>
+#include <matrix.h>
+#include <mex.h>
+#include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttOptions.h"
+#include "dttCore.h"
+#include "dttInverse.h"
+#include "dttPoisson.h"
+#include "dttStats.h"
+#include "dttMex.h"
+
+//--------------------------------------------
+// EIGENVALUES
+//--------------------------------------------
+
+//description of the last multiplier that was computed
+struct MultiplierKey {
+    std::vector<ptrdiff_t> sz;
+    std::vector<int> kinds;
+    std::vector<double> dx;
+    double shift;
+    int eigenvalues;
+    bool operator==(const MultiplierKey &other) const {
+        return sz == other.sz && kinds == other.kinds && dx == other.dx
+            && shift == other.shift && eigenvalues == other.eigenvalues;
+    }
+};
+
+//multiplier for the last solve in each precision (only recomputed if the
+//size, grid spacing, boundary conditions, shift, or eigenvalues change)
+static MultiplierKey key_double, key_float;
+static std::vector<double> multiplier_double;
+static std::vector<float> multiplier_float;
+
+//return the multiplier for the given key
+template <typename T>
+static const std::vector<T> &getMultiplier(const MultiplierKey &key, MultiplierKey &cached_key, std::vector<T> &multiplier){
+    if (multiplier.empty() || !(key == cached_key)){
+        std::vector<fftw_iodim64> dims;
+        std::vector<int> kinds;
+        for (size_t d = 0; d < key.sz.size(); d++){
+            if (key.kinds[d] >= 0){
+                dims.push_back(dtt::iodim(key.sz[d], 1, 1));
+                kinds.push_back(key.kinds[d]);
+            }
+        }
+        double scale = dtt::invertKinds(dims, kinds);
+        dtt::poissonMultiplier(key.sz, key.kinds, key.dx, key.shift, key.eigenvalues, scale, multiplier);
+        cached_key = key;
+    }
+    return multiplier;
+}
+
+//release cached FFTW plans and multipliers when the mex file is cleared
+static void clearPoisson(){
+    dtt::clearPlanCache();
+    std::vector<double>().swap(multiplier_double);
+    std::vector<float>().swap(multiplier_float);
+}
+
+DTT_MEX_FUNCTION(dttPoissonSolve)
+{
+
+    //--------------------------------------------
+    // DECLARE VARIABLES
+    //--------------------------------------------
+
+    const mwSize *dims;
+    mwSize numelements;
+    int numdims;
+    int i;
+    double shift = 0;                               // Poisson equation by default
+    int grid = DTT_GRID_CELL;                       // cell-centred grid by default
+    int eigenvalues = DTT_EIGENVALUES_SPECTRAL;     // spectral Laplacian by default
+    int first_option = 3;                           // index of the first optional name/value input
+    void *input_ptr, *output_ptr;
+
+    //start timing the call (see dttStats.h)
+    dtt::CallStats stats("dttPoissonSolve");
+
+    //release cached FFTW plans and multipliers when the mex file is
+    //cleared
+    dtt::atExit(clearPoisson);
+
+    //--------------------------------------------
+    // CHECK INPUTS
+    //--------------------------------------------
+
+    //check for proper number of input arguments
+    if (nrhs < 3) {
+        mexErrMsgTxt("At least three inputs are required.");
+    }
+
+    //check the input matrix is real and double or single precision
+    if( !((mxIsDouble(prhs[0]) || mxIsSingle(prhs[0])) && !mxIsComplex(prhs[0])) ) {
+        mexErrMsgTxt("Input array must be double or single precision and real.");
+    }
+    if (mxIsEmpty(prhs[0])){
+        mexErrMsgTxt("Input array must not be empty.");
+    }
+    numdims = mxGetNumberOfDimensions(prhs[0]);
+    dims = mxGetDimensions(prhs[0]);
+    numelements = mxGetNumberOfElements(prhs[0]);
+
+    //grid spacing, given as a scalar or one value per dimension
+    size_t num_dx = mxGetNumberOfElements(prhs[1]);
+    if( !(mxIsDouble(prhs[1]) && !mxIsComplex(prhs[1]) && (num_dx == 1 || num_dx == (size_t) numdims)) ) {
+        mexErrMsgTxt("Input for DX must be a real scalar, or have one element for each dimension of the input array.");
+    }
+    std::vector<double> dx(numdims);
+    for (i = 0; i < numdims; i++){
+        dx[i] = mxGetPr(prhs[1])[num_dx == 1 ? 0 : i];
+        if (!(dx[i] > 0)){
+            mexErrMsgTxt("Input for DX must be positive.");
+        }
+    }
+
+    //boundary conditions, given as one character for each face ('N' or
+    //'D'), either for every dimension, or a single pair used for all
+    //dimensions
+    char bc[64];
+    size_t num_bc = 0;
+    if (dtt::getString(prhs[2], bc, sizeof(bc))){
+        num_bc = strlen(bc);
+    }
+    if (num_bc != 2 && num_bc != 2 * (size_t) numdims){
+        mexErrMsgTxt("Input for BC must be a string with two characters ('N' or 'D') for each dimension of the input array, or two characters used for every dimension.");
+    }
+    for (size_t j = 0; j < num_bc; j++){
+        if (bc[j] == 'n') bc[j] = 'N';
+        if (bc[j] == 'd') bc[j] = 'D';
+        if (bc[j] != 'N' && bc[j] != 'D'){
+            mexErrMsgTxt("Input for BC must only contain the characters 'N' (Neumann) and 'D' (Dirichlet).");
+        }
+    }
+
+    //optional positional input for the Helmholtz shift, which can be empty
+    //to use the default value, and is followed by the name/value pairs
+    if (nrhs > 3 && !mxIsChar(prhs[3])){
+        first_option = 4;
+        if (!mxIsEmpty(prhs[3]) && !dtt::getScalar(prhs[3], shift)){
+            mexErrMsgTxt("Input for SHIFT must be a real scalar.");
+        }
+    }
+
+    //options for the solver ('Grid' and 'Laplacian') are removed from the
+    //name/value pairs, and the remaining pairs are used for the planner
+    //options
+    std::vector<const mxArray *> planner_inputs;
+    for (i = first_option; i < nrhs; i += 2){
+        char name[32], option[16];
+        if (i + 1 < nrhs && dtt::getString(prhs[i], name, sizeof(name))){
+            bool has_option = dtt::getString(prhs[i + 1], option, sizeof(option));
+            if (dtt::equalsIgnoreCase(name, "Grid")){
+                if (has_option && dtt::equalsIgnoreCase(option, "cell")){
+                    grid = DTT_GRID_CELL;
+                } else if (has_option && dtt::equalsIgnoreCase(option, "node")){
+                    grid = DTT_GRID_NODE;
+                } else {
+                    mexErrMsgTxt("Value for GRID must be 'cell' or 'node'.");
+                }
+                continue;
+            } else if (dtt::equalsIgnoreCase(name, "Laplacian")){
+                if (has_option && dtt::equalsIgnoreCase(option, "spectral")){
+                    eigenvalues = DTT_EIGENVALUES_SPECTRAL;
+                } else if (has_option && dtt::equalsIgnoreCase(option, "fd")){
+                    eigenvalues = DTT_EIGENVALUES_FD;
+                } else {
+                    mexErrMsgTxt("Value for LAPLACIAN must be 'spectral' or 'fd'.");
+                }
+                continue;
+            }
+        }
+        planner_inputs.push_back(prhs[i]);
+        if (i + 1 < nrhs){
+            planner_inputs.push_back(prhs[i + 1]);
+        }
+    }
+
+    //get planner options from name/value pairs and global defaults
+    dtt::Options options = dtt::getOptions((int) planner_inputs.size(), planner_inputs.data(), 0);
+    stats.enable(options.stats);
+    if (options.inverse || dtt::hasOption((int) planner_inputs.size(), planner_inputs.data(), 0, "Strategy")){
+        mexErrMsgTxt("The Inverse and Strategy options are not supported by dttPoissonSolve.");
+    }
+    dtt::checkOutputs(options, nlhs);
+
+    //--------------------------------------------
+    // DESCRIBE THE SOLVE
+    //--------------------------------------------
+
+    //forward transform for each dimension, where singleton dimensions are
+    //not transformed
+    MultiplierKey key;
+    key.sz.resize(numdims);
+    key.kinds.resize(numdims);
+    key.dx = dx;
+    key.shift = shift;
+    key.eigenvalues = eigenvalues;
+    for (i = 0; i < numdims; i++){
+        const char *face = (num_bc == 2) ? bc : bc + 2 * i;
+        key.sz[i] = (ptrdiff_t) dims[i];
+        key.kinds[i] = (dims[i] > 1) ? dtt::poissonKind(face[0] == 'D', face[1] == 'D', grid) : -1;
+    }
+
+    //describe the transform using guru64 dimensions (as in dttND, see
+    //dttCore.h)
+    dtt::Transform transform = dtt::describeAxes(key.sz, key.kinds);
+
+    stats.mark(DTT_PHASE_VALIDATE);
+
+    //create MATLAB output with the same precision as the input, or for
+    //in-place solves, write the output to the input array (the output is
+    //not zero-filled as every element is written by FFTW)
+    input_ptr = mxGetData(prhs[0]);
+    if (options.in_place){
+        output_ptr = input_ptr;
+    } else {
+        plhs[0] = mxCreateUninitNumericArray(numdims, dims, mxGetClassID(prhs[0]), mxREAL);
+        output_ptr = mxGetData(plhs[0]);
+    }
+    stats.mark(DTT_PHASE_ALLOCATE);
+
+    //--------------------------------------------
+    // SOLVE
+    //--------------------------------------------
+
+    //solve using cached plans for the forward and inverse transforms, and
+    //the cached multiplier (if no dimensions are transformed, the solve
+    //reduces to dividing by the shift)
+    int threads = dtt::getThreads(options, numelements);
+    bool success;
+    if (mxIsSingle(prhs[0])){
+        const std::vector<float> &multiplier = getMultiplier(key, key_float, multiplier_float);
+        stats.mark(DTT_PHASE_PLAN);
+        success = dtt::poissonSolve(transform, multiplier, (float *) input_ptr, (float *) output_ptr, options, threads);
+    } else {
+        const std::vector<double> &multiplier = getMultiplier(key, key_double, multiplier_double);
+        stats.mark(DTT_PHASE_PLAN);
+        success = dtt::poissonSolve(transform, multiplier, (double *) input_ptr, (double *) output_ptr, options, threads);
+    }
+    if (!success){
+        mexErrMsgTxt("FFTW plan could not be created.");
+    }
+    stats.mark(DTT_PHASE_EXECUTE);
+    stats.addBytes(2.0 * numelements * mxGetElementSize(prhs[0]));
+    stats.finish();
+
+    return;
+}
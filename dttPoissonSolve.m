@@ -0,0 +1,126 @@
+function varargout = dttPoissonSolve(varargin)
+%DTTPOISSONSOLVE Solve Poisson or Helmholtz equation using DTTs.
+%
+% DESCRIPTION:
+%     dttPoissonSolve solves the Poisson equation
+%
+%         d^2u/dx^2 + d^2u/dy^2 + ... = f
+%
+%     or the Helmholtz equation
+%
+%         d^2u/dx^2 + d^2u/dy^2 + ... + shift * u = f
+%
+%     on a regular grid using discrete trigonometric transforms (DTTs).
+%     Each face of the domain can have a Neumann (du/dn = 0) or Dirichlet
+%     (u = 0) boundary condition. The combination of boundary conditions
+%     on each dimension selects the DTT whose basis functions are the
+%     eigenfunctions of the second derivative. The solution is computed
+%     by taking the forward transform of f, dividing by the eigenvalues of
+%     the Laplacian (plus the shift), and taking the inverse transform.
+%
+%     The three steps are computed in a single mex call using cached FFTW
+%     plans, without creating any temporary arrays in MATLAB. The
+%     eigenvalues (combined with the normalisation of the inverse
+%     transform) are computed on the first call and cached, so repeated
+%     solves with the same grid size, spacing, boundary conditions, and
+%     shift (e.g., for a new right-hand side at each time step) only
+%     compute the two transforms and a single multiplication. The cache
+%     holds the values for the last solve in each precision, and uses the
+%     same amount of memory as f.
+%
+%     The boundaries are located depending on the 'Grid' option. For
+%     'cell' (default), the grid points are cell centres, and the
+%     boundaries lie half a grid point outside the first and last points
+%     (using DCT-II, DST-II, DCT-IV, and DST-IV). For 'node', Neumann
+%     boundaries lie on the first or last grid point, and Dirichlet
+%     boundaries lie one grid point outside the array, where u = 0 (using
+%     DCT-I, DST-I, DCT-III, and DST-III).
+%
+%     Modes where the eigenvalue plus the shift is zero are set to zero.
+%     For example, with Neumann conditions on every face and no shift,
+%     the mean of u is zero (in this case, f should also have zero mean
+%     for the solution to exist).
+%
+%     For compilation instructions, see compileDttMex.
+%
+% USAGE:
+%     u = dttPoissonSolve(f, dx, bc)
+%     u = dttPoissonSolve(f, dx, bc, shift)
+%     u = dttPoissonSolve(..., 'Grid', 'node')
+%     u = dttPoissonSolve(..., 'Laplacian', 'fd')
+%     dttPoissonSolve(f, dx, bc, 'InPlace', true)
+%
+% INPUTS:
+%     f            - Right-hand side in double or single precision. The
+%                    array can have any number of dimensions, where
+%                    singleton dimensions are not transformed.
+%     dx           - Grid point spacing, given as a scalar, or with one
+%                    element for each dimension of f.
+%     bc           - Boundary conditions, given as a string with two
+%                    characters for each dimension of f (the conditions at
+%                    the start and end of the dimension), or two
+%                    characters used for every dimension, where 'N' is a
+%                    Neumann condition, and 'D' is a Dirichlet condition.
+%                    For example, 'NNDD' for a 2D array has Neumann
+%                    conditions on the faces normal to the first
+%                    dimension, and Dirichlet conditions on the faces
+%                    normal to the second. The DTT used for each dimension
+%                    is:
+%
+%                                 'cell'      'node'
+%                        'NN':    DCT-II      DCT-I
+%                        'DD':    DST-II      DST-I
+%                        'ND':    DCT-IV      DCT-III
+%                        'DN':    DST-IV      DST-III
+%
+% OPTIONAL INPUTS:
+%     shift        - Helmholtz shift (default = 0), e.g., k^2 for the
+%                    Helmholtz equation with wavenumber k, or a negative
+%                    value for the screened Poisson equation. This can be
+%                    set to [] to use the default value.
+%     'Grid'       - Location of the grid points relative to the
+%                    boundaries: 'cell' (default) or 'node'.
+%     'Laplacian'  - Eigenvalues used for the Laplacian: 'spectral'
+%                    (default), where the eigenvalue of each mode is -k^2,
+%                    or 'fd', where the eigenvalues are those of the
+%                    second-order finite difference Laplacian,
+%                    -(2 sin(k dx / 2) / dx)^2. The 'fd' solution
+%                    satisfies the three-point finite difference equation
+%                    exactly.
+%
+%     Options used by the DTT functions (e.g., 'Planner', 'Threads', and
+%     'InPlace') can also be given as name/value pairs after the other
+%     inputs. If 'InPlace' is true, the solution overwrites f, and the
+%     function must be called without an output argument (see dtt1D).
+%     The 'Inverse' and 'Strategy' options are not supported.
+%
+% OUTPUTS:
+%     u            - Solution, returned with the same size and precision
+%                    as f.
+%
+% ABOUT:
+%     author       - Bradley Treeby
+%     date         - 16 October 2026
+%     last update  - 16 October 2026
+%
+% Copyright (C) 2026 Bradley Treeby
+%
+% See also dtt2D, dtt3D, dttND, gradientDtt, dttOptions
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+%
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+% call the function in the unified dttmex binary (if dttPoissonSolve has been
+% compiled as a separate mex function, the mex function is called
+% instead of this file, see compileDttMex)
+[varargout{1:nargout}] = dttmex('poisson', varargin{:});
@@ -0,0 +1,517 @@
+/**************************************************************************
+ * Batched kernels for small discrete trigonometric transforms.
+ *
+ * For batches of short transforms (e.g., blocks of 8 to 32 points), the
+ * time spent looking up the plan and dispatching the FFTW codelets is
+ * comparable to the transform itself. For these sizes, each DTT is
+ * instead computed as a product with the N by N transform matrix (built
+ * once for each type and length, using the unnormalised FFTW
+ * definitions). The kernels are templates on N, so a fully specialised
+ * kernel is generated at compile time for each length up to
+ * DTT_SMALL_KERNEL_MAX.
+ *
+ * Two layouts are supported: contiguous columns (dim = 1), where the
+ * output column is accumulated in registers as the sum of the columns of
+ * the matrix weighted by the input, and strided lines (dim > 1), where a
+ * panel of adjacent lines is transformed together and each row of the
+ * output panel is accumulated in registers. Both load the input before
+ * writing the output, so the input and output can be the same array.
+ * The columns, or the panels of each [pre, n] slab, are divided into
+ * blocks that are computed by the threads in dttThreads.h.
+ *
+ * With GCC or Clang, the accumulators are written using the vector
+ * extensions of the compiler (as in dttGemm.h) rather than relying on
+ * auto-vectorisation, which GCC only applies to these loops at -O3. On
+ * x86, each kernel is compiled three times, for the baseline instruction
+ * set (16-byte vectors), AVX2 with FMA (32-byte vectors), and AVX-512
+ * (64-byte vectors), and the version used is selected at run time based
+ * on the CPU. Other compilers use scalar loops. Dispatch can be disabled
+ * at compile time using -DDTT_SMALL_NO_DISPATCH.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_SMALL_H
+#define DTT_SMALL_H
+
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <utility>
+#include <vector>
+#include "fftw3.h"
+#include "dttCore.h"
+#include "dttThreads.h"
+
+//largest transform length with a specialised kernel
+#ifndef DTT_SMALL_KERNEL_MAX
+#define DTT_SMALL_KERNEL_MAX 64
+#endif
+
+//transforms up to this length use the small kernels automatically,
+//longer transforms are faster using FFTW
+#ifndef DTT_SMALL_MAX_N
+#define DTT_SMALL_MAX_N 32
+#endif
+
+//number of adjacent lines transformed together for strided transforms
+#ifndef DTT_SMALL_PANEL
+#define DTT_SMALL_PANEL 32
+#endif
+
+//approximate size in bytes of the input of each block of lines computed
+//by one thread
+#ifndef DTT_SMALL_BLOCK_BYTES
+#define DTT_SMALL_BLOCK_BYTES 65536
+#endif
+
+//run-time selection of the instruction set
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(DTT_SMALL_NO_DISPATCH)
+#define DTT_SMALL_DISPATCH
+#define DTT_SMALL_INLINE inline __attribute__((always_inline))
+#else
+#define DTT_SMALL_INLINE inline
+#endif
+
+namespace dtt {
+
+//--------------------------------------------
+// TRANSFORM MATRICES
+//--------------------------------------------
+
+//cos(pi * m / d) and sin(pi * m / d) with the integer m reduced to a
+//single period first, so large arguments don't lose accuracy
+inline double cosPi(long long m, long long d){
+    const double pi = 3.14159265358979323846;
+    m %= 2 * d;
+    return std::cos(pi * (double) m / (double) d);
+}
+inline double sinPi(long long m, long long d){
+    const double pi = 3.14159265358979323846;
+    m %= 2 * d;
+    return std::sin(pi * (double) m / (double) d);
+}
+
+//element (k, j) of the matrix for the given FFTW kind, so the output is
+//Y_k = sum_j C(k, j) X_j (using the same definitions as FFTW)
+inline double smallMatrixElement(int kind, long long k, long long j, long long n){
+    double sign = (k % 2) ? -1.0 : 1.0;
+    switch (kind) {
+        case FFTW_REDFT00:
+            if (j == 0) return 1.0;
+            if (j == n - 1) return sign;
+            return 2.0 * cosPi(j * k, n - 1);
+        case FFTW_REDFT10:
+            return 2.0 * cosPi((2 * j + 1) * k, 2 * n);
+        case FFTW_REDFT01:
+            if (j == 0) return 1.0;
+            return 2.0 * cosPi(j * (2 * k + 1), 2 * n);
+        case FFTW_REDFT11:
+            return 2.0 * cosPi((2 * j + 1) * (2 * k + 1), 4 * n);
+        case FFTW_RODFT00:
+            return 2.0 * sinPi((j + 1) * (k + 1), n + 1);
+        case FFTW_RODFT10:
+            return 2.0 * sinPi((2 * j + 1) * (k + 1), 2 * n);
+        case FFTW_RODFT01:
+            if (j == n - 1) return sign;
+            return 2.0 * sinPi((j + 1) * (2 * k + 1), 2 * n);
+        default:
+            return 2.0 * sinPi((2 * j + 1) * (2 * k + 1), 4 * n);
+    }
+}
+
+//matrices built for each kind and length, which are kept until
+//clearPlanCache is called
+template <typename T>
+inline std::map<std::pair<int, ptrdiff_t>, std::vector<T> > &smallMatrices(){
+    static std::map<std::pair<int, ptrdiff_t>, std::vector<T> > matrices;
+    return matrices;
+}
+
+//free the matrices for both precisions (called by clearPlanCache)
+inline void clearSmallMatrices(){
+    smallMatrices<double>().clear();
+    smallMatrices<float>().clear();
+}
+
+//return the matrix for the given kind and length, stored by columns
+//(C(k, j) at index k + n * j), which is built on the first use
+template <typename T>
+inline const T *smallMatrix(int kind, ptrdiff_t n){
+    addClearFunction(clearSmallMatrices);
+    std::vector<T> &C = smallMatrices<T>()[std::make_pair(kind, n)];
+    if (C.empty()){
+        C.resize(n * n);
+        for (ptrdiff_t j = 0; j < n; j++){
+            for (ptrdiff_t k = 0; k < n; k++){
+                C[k + n * j] = (T) smallMatrixElement(kind, k, j, n);
+            }
+        }
+    }
+    return &C[0];
+}
+
+//--------------------------------------------
+// KERNELS
+//--------------------------------------------
+
+//size in bytes of the vectors used for a column of the given size in
+//bytes, where the largest vector size up to max is used that fits in the
+//column (at least 16 bytes)
+constexpr int smallVectorBytes(int bytes, int max){
+    return (bytes >= max || max <= 16) ? max : smallVectorBytes(bytes, max / 2);
+}
+
+//transform count contiguous columns of length N, where column b starts
+//at in + b * N, and multiply the output by scale (with GCC or Clang, the
+//output column is accumulated in vectors of up to V bytes held in
+//registers, with any remaining elements accumulated separately)
+template <typename T, int N, int V>
+DTT_SMALL_INLINE void smallColumnsImpl(const T *C, const T *in, T *out, ptrdiff_t count, T scale){
+    T x[N];
+#ifdef __GNUC__
+    typedef T Vector __attribute__((vector_size(smallVectorBytes(N * sizeof(T), V))));
+    const int W = sizeof(Vector) / sizeof(T);
+    const int NV = N / W;
+    const int F = NV * W;
+    Vector y[(NV > 0) ? NV : 1];
+    T rest[W];
+    for (ptrdiff_t b = 0; b < count; b++){
+        std::memcpy(x, in + b * N, sizeof(x));
+        for (int v = 0; v < NV; v++){
+            y[v] = Vector();
+        }
+        for (int k = F; k < N; k++){
+            rest[k - F] = 0;
+        }
+        for (int j = 0; j < N; j++){
+            const T *c = C + j * N;
+            T xj = x[j];
+        #pragma GCC unroll 16
+            for (int v = 0; v < NV; v++){
+                Vector cv;
+                std::memcpy(&cv, c + v * W, sizeof(Vector));
+                y[v] += cv * xj;
+            }
+            for (int k = F; k < N; k++){
+                rest[k - F] += c[k] * xj;
+            }
+        }
+        T *dst = out + b * N;
+        for (int v = 0; v < NV; v++){
+            Vector yv = y[v] * scale;
+            std::memcpy(dst + v * W, &yv, sizeof(Vector));
+        }
+        for (int k = F; k < N; k++){
+            dst[k] = rest[k - F] * scale;
+        }
+    }
+#else
+    T y[N];
+    for (ptrdiff_t b = 0; b < count; b++){
+        const T *src = in + b * N;
+        for (int j = 0; j < N; j++){
+            x[j] = src[j];
+        }
+        for (int k = 0; k < N; k++){
+            y[k] = 0;
+        }
+        for (int j = 0; j < N; j++){
+            const T *c = C + j * N;
+            T xj = x[j];
+            for (int k = 0; k < N; k++){
+                y[k] += c[k] * xj;
+            }
+        }
+        T *dst = out + b * N;
+        for (int k = 0; k < N; k++){
+            dst[k] = y[k] * scale;
+        }
+    }
+#endif
+}
+
+//transform the lines of one panel of w lines, where x holds the input
+//(line p of row j at x[j * DTT_SMALL_PANEL + p]) and dst is the first
+//line of the output (with the given stride)
+template <typename T>
+DTT_SMALL_INLINE void smallPanel(const T *C, ptrdiff_t n, const T *x, T *dst, ptrdiff_t stride, ptrdiff_t w, T scale){
+    T y[DTT_SMALL_PANEL];
+    for (ptrdiff_t k = 0; k < n; k++){
+        for (ptrdiff_t p = 0; p < w; p++){
+            y[p] = 0;
+        }
+        for (ptrdiff_t j = 0; j < n; j++){
+            T c = C[k + n * j];
+            const T *xj = x + j * DTT_SMALL_PANEL;
+            for (ptrdiff_t p = 0; p < w; p++){
+                y[p] += c * xj[p];
+            }
+        }
+        for (ptrdiff_t p = 0; p < w; p++){
+            dst[p + k * stride] = y[p] * scale;
+        }
+    }
+}
+
+//transform count adjacent lines of length n with the given stride (i.e.,
+//rows of an array of size [stride, n]) in panels of DTT_SMALL_PANEL
+//lines, and multiply the output by scale (with GCC or Clang, each row of a full panel is
+//accumulated in vectors of V bytes held in registers, and the last panel
+//is computed element by element if it is not full)
+template <typename T, int V>
+DTT_SMALL_INLINE void smallLinesImpl(const T *C, ptrdiff_t n, const T *in, T *out, ptrdiff_t count, ptrdiff_t stride, T scale){
+    T x[DTT_SMALL_KERNEL_MAX * DTT_SMALL_PANEL];
+#ifdef __GNUC__
+    typedef T Vector __attribute__((vector_size(V)));
+    const int W = V / sizeof(T);
+    const int NV = DTT_SMALL_PANEL / W;
+    const bool vectorised = (NV > 0 && NV * W == DTT_SMALL_PANEL);
+#endif
+    for (ptrdiff_t p0 = 0; p0 < count; p0 += DTT_SMALL_PANEL){
+        ptrdiff_t w = (p0 + DTT_SMALL_PANEL < count) ? DTT_SMALL_PANEL : count - p0;
+        for (ptrdiff_t j = 0; j < n; j++){
+            std::memcpy(x + j * DTT_SMALL_PANEL, in + p0 + j * stride, w * sizeof(T));
+        }
+#ifdef __GNUC__
+        if (vectorised && w == DTT_SMALL_PANEL){
+            for (ptrdiff_t k = 0; k < n; k++){
+                Vector y[(NV > 0) ? NV : 1];
+                for (int v = 0; v < NV; v++){
+                    y[v] = Vector();
+                }
+                for (ptrdiff_t j = 0; j < n; j++){
+                    T c = C[k + n * j];
+                    const T *xj = x + j * DTT_SMALL_PANEL;
+                #pragma GCC unroll 16
+                    for (int v = 0; v < NV; v++){
+                        Vector xv;
+                        std::memcpy(&xv, xj + v * W, sizeof(Vector));
+                        y[v] += xv * c;
+                    }
+                }
+                T *dst = out + p0 + k * stride;
+                for (int v = 0; v < NV; v++){
+                    Vector yv = y[v] * scale;
+                    std::memcpy(dst + v * W, &yv, sizeof(Vector));
+                }
+            }
+            continue;
+        }
+#endif
+        smallPanel<T>(C, n, x, out + p0, stride, w, scale);
+    }
+}
+
+//kernel signatures
+template <typename T>
+struct SmallKernels {
+    typedef void (*columns)(const T *C, const T *in, T *out, ptrdiff_t count, T scale);
+    typedef void (*lines)(const T *C, ptrdiff_t n, const T *in, T *out, ptrdiff_t count, ptrdiff_t stride, T scale);
+};
+
+//compiled versions of each kernel for the baseline instruction set, and
+//(if dispatch is enabled) AVX2 and AVX-512
+template <typename T, int N>
+void smallColumns(const T *C, const T *in, T *out, ptrdiff_t count, T scale){
+    smallColumnsImpl<T, N, 16>(C, in, out, count, scale);
+}
+template <typename T>
+void smallLines(const T *C, ptrdiff_t n, const T *in, T *out, ptrdiff_t count, ptrdiff_t stride, T scale){
+    smallLinesImpl<T, 16>(C, n, in, out, count, stride, scale);
+}
+
+#ifdef DTT_SMALL_DISPATCH
+template <typename T, int N>
+__attribute__((target("avx2,fma"))) void smallColumnsAvx2(const T *C, const T *in, T *out, ptrdiff_t count, T scale){
+    smallColumnsImpl<T, N, 32>(C, in, out, count, scale);
+}
+template <typename T, int N>
+__attribute__((target("avx512f"))) void smallColumnsAvx512(const T *C, const T *in, T *out, ptrdiff_t count, T scale){
+    smallColumnsImpl<T, N, 64>(C, in, out, count, scale);
+}
+template <typename T>
+__attribute__((target("avx2,fma"))) void smallLinesAvx2(const T *C, ptrdiff_t n, const T *in, T *out, ptrdiff_t count, ptrdiff_t stride, T scale){
+    smallLinesImpl<T, 32>(C, n, in, out, count, stride, scale);
+}
+template <typename T>
+__attribute__((target("avx512f"))) void smallLinesAvx512(const T *C, ptrdiff_t n, const T *in, T *out, ptrdiff_t count, ptrdiff_t stride, T scale){
+    smallLinesImpl<T, 64>(C, n, in, out, count, stride, scale);
+}
+#endif
+
+//instruction sets
+#define DTT_ISA_BASELINE 0
+#define DTT_ISA_AVX2 1
+#define DTT_ISA_AVX512 2
+
+//instruction set supported by the CPU (detected once)
+inline int smallIsa(){
+#ifdef DTT_SMALL_DISPATCH
+    static int isa = -1;
+    if (isa < 0){
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")){
+            isa = DTT_ISA_AVX512;
+        } else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")){
+            isa = DTT_ISA_AVX2;
+        } else {
+            isa = DTT_ISA_BASELINE;
+        }
+    }
+    return isa;
+#else
+    return DTT_ISA_BASELINE;
+#endif
+}
+
+//table of column kernels indexed by length, filled by recursion over N
+template <typename T, int N>
+struct SmallTable {
+    static void fill(std::vector<typename SmallKernels<T>::columns> &table, int isa){
+        table[N] = &smallColumns<T, N>;
+#ifdef DTT_SMALL_DISPATCH
+        if (isa == DTT_ISA_AVX512){
+            table[N] = &smallColumnsAvx512<T, N>;
+        } else if (isa == DTT_ISA_AVX2){
+            table[N] = &smallColumnsAvx2<T, N>;
+        }
+#endif
+        SmallTable<T, N - 1>::fill(table, isa);
+    }
+};
+template <typename T>
+struct SmallTable<T, 0> {
+    static void fill(std::vector<typename SmallKernels<T>::columns> &, int){}
+};
+
+//return the column kernel for length n, and the lines kernel
+template <typename T>
+inline typename SmallKernels<T>::columns smallColumnsKernel(ptrdiff_t n){
+    static std::vector<typename SmallKernels<T>::columns> table;
+    if (table.empty()){
+        table.resize(DTT_SMALL_KERNEL_MAX + 1);
+        SmallTable<T, DTT_SMALL_KERNEL_MAX>::fill(table, smallIsa());
+    }
+    return table[n];
+}
+template <typename T>
+inline typename SmallKernels<T>::lines smallLinesKernel(){
+#ifdef DTT_SMALL_DISPATCH
+    if (smallIsa() == DTT_ISA_AVX512){
+        return &smallLinesAvx512<T>;
+    } else if (smallIsa() == DTT_ISA_AVX2){
+        return &smallLinesAvx2<T>;
+    }
+#endif
+    return &smallLines<T>;
+}
+
+//--------------------------------------------
+// EXECUTION
+//--------------------------------------------
+
+//returns true if the transform of length n should use the small kernels
+//(DCT-I requires at least two points, as in FFTW)
+inline bool useSmall(const Options &options, ptrdiff_t n){
+    if (n < 2 || n > DTT_SMALL_KERNEL_MAX){
+        return false;
+    }
+    if (options.strategy == DTT_STRATEGY_SMALL){
+        return true;
+    }
+    return options.strategy == DTT_STRATEGY_AUTO && n <= DTT_SMALL_MAX_N;
+}
+
+//blocks of lines for a transform along the middle dimension of an array
+//of size [pre, n, post], where each block is either a range of columns
+//(pre = 1) or a range of panels of one [pre, n] slab (pre > 1), as in
+//dttGemm.h
+template <typename T>
+struct SmallBlocks {
+    const T *C;
+    ptrdiff_t n, pre, post;
+    const T *in;
+    T *out;
+    T scale;
+    ptrdiff_t block;        // lines in each block
+    ptrdiff_t per_slab;     // blocks in each slab (pre > 1)
+    typename SmallKernels<T>::columns columns;
+    typename SmallKernels<T>::lines kernel;
+
+    //transform blocks first to last - 1
+    void execute(ptrdiff_t first, ptrdiff_t last) const {
+        if (pre == 1){
+            ptrdiff_t b0 = first * block;
+            ptrdiff_t b1 = (last * block < post) ? last * block : post;
+            columns(C, in + b0 * n, out + b0 * n, b1 - b0, scale);
+            return;
+        }
+        for (ptrdiff_t b = first; b < last; b++){
+            ptrdiff_t o = b / per_slab, p0 = (b % per_slab) * block;
+            ptrdiff_t h = (p0 + block < pre) ? block : pre - p0;
+            ptrdiff_t offset = o * pre * n + p0;
+            kernel(C, n, in + offset, out + offset, h, pre, scale);
+        }
+    }
+};
+
+template <typename T>
+inline void executeSmallBlocks(const void *blocks, int, ptrdiff_t first, ptrdiff_t last){
+    static_cast<const SmallBlocks<T> *>(blocks)->execute(first, last);
+}
+
+//transform along the middle dimension of an array of size [pre, n, post]
+//using the small kernels, and multiply the output by scale (in and out
+//can be the same), where the blocks are divided between up to the given
+//number of threads (see dttThreads.h)
+template <typename T>
+inline void executeSmall(ptrdiff_t n, ptrdiff_t pre, ptrdiff_t post, int kind, const T *in, T *out, double scale, int threads){
+    SmallBlocks<T> blocks;
+    blocks.C = smallMatrix<T>(kind, n);
+    blocks.n = n;
+    blocks.pre = pre;
+    blocks.post = post;
+    blocks.in = in;
+    blocks.out = out;
+    blocks.scale = (T) scale;
+
+    //the kernels are selected by the calling thread, as the tables are
+    //filled on the first use
+    blocks.columns = smallColumnsKernel<T>(n);
+    blocks.kernel = smallLinesKernel<T>();
+
+    //size the blocks to fit in cache, where the blocks of each slab are
+    //whole panels
+    ptrdiff_t lines = (pre == 1) ? post : pre;
+    blocks.block = DTT_SMALL_BLOCK_BYTES / (n * (ptrdiff_t) sizeof(T));
+    if (pre > 1){
+        blocks.block = (blocks.block / DTT_SMALL_PANEL) * DTT_SMALL_PANEL;
+    }
+    if (blocks.block < DTT_SMALL_PANEL) blocks.block = DTT_SMALL_PANEL;
+    if (blocks.block > lines) blocks.block = lines;
+    blocks.per_slab = (lines + blocks.block - 1) / blocks.block;
+    ptrdiff_t count = (pre == 1) ? blocks.per_slab : blocks.per_slab * post;
+    parallelFor(executeSmallBlocks<T>, &blocks, count, threads);
+}
+
+} // namespace dtt
+
+#endif
@@ -0,0 +1,195 @@
+/**************************************************************************
+ * Timing of each phase of the calls to the dtt mex functions.
+ *
+ * When the 'Stats' option is set (per call, or for all calls using
+ * dttOptions), each mex function records the time spent in each phase of
+ * the call:
+ *
+ *     Validate    checking the inputs and options
+ *     Allocate    creating the output arrays
+ *     Plan        looking up and creating FFTW plans (and other cached
+ *                 data, such as the Poisson multipliers)
+ *     Execute     computing the transforms
+ *     Cleanup     releasing temporary arrays before returning
+ *
+ * together with the number of plan cache hits and misses, and the number
+ * of bytes read from the input arrays and written to the output arrays.
+ * The totals are accumulated for each function in the global variable
+ * DTT_STATS, which is returned by dttStats.
+ *
+ * The phases are timed by calling mark at the end of each phase, which
+ * adds the time since the previous mark to that phase. The time spent
+ * inside the plan cache (see PlanCounters in dttPlanCache.h) is moved to
+ * the plan phase, so the plan lookup is separated from the execution
+ * even when the two are interleaved (e.g., for the transpose path). When
+ * the option is not set, each call only reads the clock once, and mark
+ * returns immediately.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_STATS_H
+#define DTT_STATS_H
+
+#include <matrix.h>
+#include <mex.h>
+#include "dttPlanCache.h"
+
+//name of the global variable used to store the statistics
+#define DTT_STATS_GLOBAL "DTT_STATS"
+
+//phases of each call
+#define DTT_PHASE_VALIDATE  0
+#define DTT_PHASE_ALLOCATE  1
+#define DTT_PHASE_PLAN      2
+#define DTT_PHASE_EXECUTE   3
+#define DTT_PHASE_CLEANUP   4
+#define DTT_NUM_PHASES      5
+
+namespace dtt {
+
+//add value to a scalar field of a struct, creating the field if needed
+inline void addToField(mxArray *s, const char *name, double value){
+    mxArray *field = mxGetField(s, 0, name);
+    if (field != NULL && mxIsDouble(field) && mxGetNumberOfElements(field) == 1){
+        *mxGetPr(field) += value;
+        return;
+    }
+    if (field == NULL && mxGetFieldNumber(s, name) < 0){
+        mxAddField(s, name);
+    }
+    if (field != NULL){
+        mxDestroyArray(field);
+    }
+    mxSetField(s, 0, name, mxCreateDoubleScalar(value));
+}
+
+class CallStats {
+
+public:
+
+    //start timing a call to the named function (the validation phase
+    //starts here, before the options are known)
+    explicit CallStats(const char *name) : name_(name), enabled_(false), bytes_(0) {
+        last_ = wallTime();
+    }
+
+    //enable or disable the statistics for the rest of the call, given by
+    //the Stats option
+    void enable(bool enabled){
+        PlanCounters &counters = planCounters();
+        counters.timing = enabled;
+        enabled_ = enabled;
+        if (enabled){
+            for (int i = 0; i < DTT_NUM_PHASES; i++){
+                phases_[i] = 0;
+            }
+            hits_ = counters.hits;
+            misses_ = counters.misses;
+            plan_time_ = counters.time;
+        }
+    }
+
+    //add the time since the previous mark to the given phase, where the
+    //time spent in the plan cache is added to the plan phase
+    void mark(int phase){
+        if (!enabled_){
+            return;
+        }
+        double now = wallTime();
+        double plan_time = planCounters().time - plan_time_;
+        plan_time_ += plan_time;
+        phases_[DTT_PHASE_PLAN] += plan_time;
+        phases_[phase] += (now - last_) - plan_time;
+        last_ = now;
+    }
+
+    //add the bytes read or written by the call
+    void addBytes(double bytes){
+        bytes_ += bytes;
+    }
+
+    //end the call, the time since the last mark is added to the cleanup
+    //phase, and the totals are added to the global statistics
+    void finish(){
+        if (!enabled_){
+            return;
+        }
+        mark(DTT_PHASE_CLEANUP);
+        PlanCounters &counters = planCounters();
+        counters.timing = false;
+        enabled_ = false;
+
+        //global statistics (stored as a struct with one field per
+        //function)
+        mxArray *global = mexGetVariable("global", DTT_STATS_GLOBAL);
+        if (global == NULL || !mxIsStruct(global) || mxGetNumberOfElements(global) != 1){
+            if (global != NULL){
+                mxDestroyArray(global);
+            }
+            global = mxCreateStructMatrix(1, 1, 0, NULL);
+        }
+        mxArray *entry = mxGetField(global, 0, name_);
+        if (entry == NULL || !mxIsStruct(entry) || mxGetNumberOfElements(entry) != 1){
+            if (mxGetFieldNumber(global, name_) < 0){
+                mxAddField(global, name_);
+            }
+            if (entry != NULL){
+                mxDestroyArray(entry);
+            }
+            entry = mxCreateStructMatrix(1, 1, 0, NULL);
+            mxSetField(global, 0, name_, entry);
+        }
+
+        //accumulate the totals for this function
+        double total = 0;
+        for (int i = 0; i < DTT_NUM_PHASES; i++){
+            total += phases_[i];
+        }
+        addToField(entry, "Calls", 1);
+        addToField(entry, "Validate", phases_[DTT_PHASE_VALIDATE]);
+        addToField(entry, "Allocate", phases_[DTT_PHASE_ALLOCATE]);
+        addToField(entry, "Plan", phases_[DTT_PHASE_PLAN]);
+        addToField(entry, "Execute", phases_[DTT_PHASE_EXECUTE]);
+        addToField(entry, "Cleanup", phases_[DTT_PHASE_CLEANUP]);
+        addToField(entry, "Total", total);
+        addToField(entry, "PlanHits", (double) (counters.hits - hits_));
+        addToField(entry, "PlanMisses", (double) (counters.misses - misses_));
+        addToField(entry, "Bytes", bytes_);
+
+        mexPutVariable("global", DTT_STATS_GLOBAL, global);
+        mxDestroyArray(global);
+    }
+
+private:
+
+    const char *name_;
+    bool enabled_;
+    double last_;                       // time of the previous mark
+    double phases_[DTT_NUM_PHASES];     // time spent in each phase
+    double plan_time_;                  // plan cache time at the previous mark
+    unsigned long long hits_, misses_;  // plan cache counts at the start of the call
+    double bytes_;
+
+};
+
+} // namespace dtt
+
+#endif
@@ -0,0 +1,101 @@
+function stats = dttStats(command)
+%DTTSTATS Get or reset the timing statistics recorded by the DTT functions.
+%
+% DESCRIPTION:
+%     dttStats returns the time spent in each phase of the calls to the
+%     DTT mex functions (dtt1D, dtt2D, dtt3D, dtt3DFile, dttAsync, dttND,
+%     dttPlan, dttPoissonSolve, gradientDtt, and pstd2D). The statistics are only
+%     recorded when the 'Stats' option is set, either for a single call
+%     using the name/value pair 'Stats', true, or for all calls using
+%     dttOptions('Stats', true). When the option is not set, the overhead
+%     of each call is a single read of the clock.
+%
+%     The output is a structure with one field for each function that
+%     has been called with the option set (calls to dttPlan are recorded
+%     as dttPlanCreate, dttPlanExecute, and dttPlanDestroy, using the
+%     option given when the plan was created, and calls to dttAsync are
+%     recorded as dttAsyncSubmit and dttAsyncWait). Each field is a
+%     structure containing the totals over all recorded calls:
+%
+%         Calls       - number of calls
+%         Validate    - time in seconds spent checking the inputs and
+%                       options
+%         Allocate    - time in seconds spent creating the outputs
+%         Plan        - time in seconds spent looking up and creating
+%                       FFTW plans (and other cached data, such as the
+%                       multipliers used by dttPoissonSolve)
+%         Execute     - time in seconds spent computing the transforms
+%         Cleanup     - time in seconds spent releasing temporary arrays
+%         Total       - sum of the above
+%         PlanHits    - number of plans found in the plan cache
+%         PlanMisses  - number of plans created
+%         Bytes       - bytes read from the inputs and written to the
+%                       outputs
+%
+%     The statistics are stored in the global variable DTT_STATS, and are
+%     accumulated until dttStats('reset') is called. When the functions
+%     are compiled into the single dttmex binary, the number of plans held
+%     in the shared plan cache is returned by dttmex('stats').
+%
+% USAGE:
+%     dttStats('enable')
+%     X = dtt3D(x, 2);
+%     stats = dttStats
+%     dttStats('reset')
+%     dttStats('disable')
+%
+% OPTIONAL INPUTS:
+%     command       - One of the following:
+%
+%                         'enable'  - record the statistics for all calls
+%                                     (equivalent to dttOptions('Stats',
+%                                     true))
+%                         'disable' - stop recording the statistics
+%                         'reset'   - clear the recorded statistics
+%
+% OUTPUTS:
+%     stats         - Structure containing the recorded statistics.
+%
+% ABOUT:
+%     author        - Bradley Treeby
+%     date          - 16 October 2026
+%     last update   - 16 October 2026
+%
+% Copyright (C) 2026 Bradley Treeby
+%
+% See also dtt1D, dtt2D, dtt3D, dttmex, dttND, dttOptions, dttPlan
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+%
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+% the statistics are accumulated in a global variable by each of the mex
+% functions
+global DTT_STATS
+
+if nargin == 1
+    command = validatestring(command, {'enable', 'disable', 'reset'}, 'dttStats', 'COMMAND');
+    switch command
+        case 'enable'
+            dttOptions('Stats', true);
+        case 'disable'
+            dttOptions('Stats', false);
+        case 'reset'
+            DTT_STATS = struct();
+    end
+end
+
+% return the current statistics
+if ~isstruct(DTT_STATS)
+    DTT_STATS = struct();
+end
+stats = DTT_STATS;
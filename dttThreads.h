@@ -0,0 +1,168 @@
+/**************************************************************************
+ * Persistent worker threads for the paths that divide a transform between
+ * threads themselves, rather than through a multi-threaded FFTW plan (the
+ * GEMM path in dttGemm.h, and the tile transpose in dttTranspose.h).
+ *
+ * dtt::parallelFor splits a range of blocks into one contiguous part for
+ * each thread, where the calling thread computes the first part, and the
+ * others are computed by worker threads that are started the first time
+ * they are needed, and then wait for the next call (so no threads are
+ * created or destroyed per call). The workers are stopped by
+ * clearPlanCache (see dttPlanCache.h). If a worker can't be started, its
+ * part is computed by the calling thread.
+ *
+ * As for the plan cache, the pool is used from one thread at a time (the
+ * MATLAB thread, or the thread calling the C API).
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_THREADS_H
+#define DTT_THREADS_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "dttPlanCache.h"
+
+namespace dtt {
+
+//function computing blocks first to last - 1 of the work described by
+//data, where part is the index of the part (0 for the calling thread), so
+//each part can use its own workspace
+typedef void (*RangeFunction)(const void *data, int part, ptrdiff_t first, ptrdiff_t last);
+
+class ThreadPool {
+public:
+    ThreadPool() : fn(NULL), data(NULL), count(0), parts(1), pending(0), generation(0), stopping(false) {}
+    ~ThreadPool() { stop(); }
+
+    //compute blocks 0 to count - 1 using up to the given number of threads
+    //(each part has an index less than threads)
+    void run(RangeFunction range_fn, const void *range_data, ptrdiff_t range_count, int threads){
+        if (threads > range_count) threads = (int) range_count;
+        if (threads <= 1){
+            range_fn(range_data, 0, 0, range_count);
+            return;
+        }
+
+        //start any extra workers needed, and hand out the parts
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            while ((int) workers.size() < threads - 1){
+                try {
+                    workers.push_back(std::thread(&ThreadPool::workerLoop, this, (int) workers.size() + 1, generation));
+                } catch (const std::system_error &){
+                    break;
+                }
+            }
+            fn = range_fn;
+            data = range_data;
+            count = range_count;
+            parts = ((int) workers.size() + 1 < threads) ? (int) workers.size() + 1 : threads;
+            pending = parts - 1;
+            generation++;
+        }
+        started.notify_all();
+
+        //compute the first part, then wait for the workers
+        range_fn(range_data, 0, 0, range_count / parts);
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this]{ return pending == 0; });
+    }
+
+    //stop and join the workers
+    void stop(){
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        started.notify_all();
+        for (size_t i = 0; i < workers.size(); i++){
+            workers[i].join();
+        }
+        workers.clear();
+        stopping = false;
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable started;        // signalled when a call hands out its parts
+    std::condition_variable finished;       // signalled when a worker finishes its part
+    std::vector<std::thread> workers;
+    RangeFunction fn;
+    const void *data;
+    ptrdiff_t count;
+    int parts;                              // number of parts in the current call
+    int pending;                            // parts still being computed by the workers
+    unsigned long long generation;          // incremented for each call
+    bool stopping;
+
+    //compute part index of each call that has at least index + 1 parts
+    void workerLoop(int index, unsigned long long seen){
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true){
+            started.wait(lock, [this, seen]{ return stopping || generation != seen; });
+            if (stopping){
+                return;
+            }
+            seen = generation;
+            if (index >= parts){
+                continue;
+            }
+            RangeFunction range_fn = fn;
+            const void *range_data = data;
+            ptrdiff_t first = count * index / parts, last = count * (index + 1) / parts;
+            lock.unlock();
+            range_fn(range_data, index, first, last);
+            lock.lock();
+            if (--pending == 0){
+                finished.notify_one();
+            }
+        }
+    }
+};
+
+inline ThreadPool &threadPool(){
+    static ThreadPool pool;
+    return pool;
+}
+
+//stop the worker threads (called by clearPlanCache)
+inline void stopThreadPool(){
+    threadPool().stop();
+}
+
+//compute blocks 0 to count - 1 of the work described by data, divided
+//between up to the given number of threads (where the number of parts is
+//at most the number of threads, and at most count)
+inline void parallelFor(RangeFunction fn, const void *data, ptrdiff_t count, int threads){
+    if (threads > 1 && count > 1){
+        addClearFunction(stopThreadPool);
+    }
+    threadPool().run(fn, data, count, threads);
+}
+
+} // namespace dtt
+
+#endif
@@ -0,0 +1,227 @@
+/**************************************************************************
+ * Transpose execution path for strided 1D transforms.
+ *
+ * When dtt1D transforms along a dimension other than the first, each
+ * transform walks memory with a stride equal to the product of the
+ * preceding dimensions. For large strides, every element is on a
+ * different cache line (and often a different page), so the transform is
+ * limited by cache and TLB misses rather than arithmetic. In this case,
+ * the array is instead processed in tiles: each tile of lines is copied
+ * into a contiguous buffer using a cache-blocked transpose, transformed
+ * using a batched contiguous plan (cached as usual), scaled if needed
+ * (for inverse transforms), and copied back to the output using the
+ * reverse transpose. The tile size is chosen so the buffer stays in cache,
+ * and the copies are divided between the persistent worker threads in
+ * dttThreads.h (the contiguous plan uses the same number of threads).
+ *
+ * The path can be forced using the 'Strategy' option, and is selected
+ * automatically only where benchmarks/benchmark_transpose.m shows it is
+ * faster than the strided plan. Measured against FFTW 3.3 on a single
+ * thread (DCT-II of double arrays, 64 to 16384 rows), the transpose path
+ * was 1.1 to 2x faster for transform lengths of 256 or more when the
+ * stride was at least 8 kB, using either FFTW_ESTIMATE or FFTW_MEASURE,
+ * but up to 1.6x slower for shorter lengths or smaller strides. With
+ * several threads, each thread copies and transforms its own part of
+ * each tile, and walks memory with the same stride as a single thread,
+ * so the same thresholds are used, provided each thread has at least one
+ * full tile of work. The thresholds below can be changed at compile time
+ * after running the benchmark on a given machine.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_TRANSPOSE_H
+#define DTT_TRANSPOSE_H
+
+#include <vector>
+#include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttCore.h"
+#include "dttThreads.h"
+
+//strided transforms use the transpose path automatically when the
+//stride between elements is at least this many bytes (i.e., at least
+//two pages), and the transform length is at least
+//DTT_TRANSPOSE_MIN_LENGTH
+#ifndef DTT_TRANSPOSE_MIN_STRIDE
+#define DTT_TRANSPOSE_MIN_STRIDE 8192
+#endif
+#ifndef DTT_TRANSPOSE_MIN_LENGTH
+#define DTT_TRANSPOSE_MIN_LENGTH 256
+#endif
+
+//target size of the contiguous buffer for each thread in bytes (sized to
+//fit in the L2 cache)
+#ifndef DTT_TRANSPOSE_TILE_BYTES
+#define DTT_TRANSPOSE_TILE_BYTES 262144
+#endif
+
+//size of the square blocks used by the transpose (the inner loop over a
+//block is contiguous in the source, and is vectorised by the compiler)
+#ifndef DTT_TRANSPOSE_BLOCK
+#define DTT_TRANSPOSE_BLOCK 16
+#endif
+
+namespace dtt {
+
+//returns true if the transform along the middle dimension of an array of
+//size [pre, n, post] should use the transpose path with the given number
+//of threads, where the thresholds measured on a single thread are used
+//when each thread has at least one full tile of the array, and at least
+//one block of lines of each tile
+inline bool useTranspose(const Options &options, ptrdiff_t n, ptrdiff_t pre, ptrdiff_t post, size_t element_bytes, int threads){
+    if (pre <= 1 || options.strategy == DTT_STRATEGY_STRIDED){
+        return false;
+    }
+    if (options.strategy == DTT_STRATEGY_TRANSPOSE){
+        return true;
+    }
+    ptrdiff_t bytes_per_thread = pre * n * post * (ptrdiff_t) element_bytes / (threads > 1 ? threads : 1);
+    return (pre * (ptrdiff_t) element_bytes >= DTT_TRANSPOSE_MIN_STRIDE) && (n >= DTT_TRANSPOSE_MIN_LENGTH)
+            && (bytes_per_thread >= DTT_TRANSPOSE_TILE_BYTES) && (pre >= (ptrdiff_t) threads * DTT_TRANSPOSE_BLOCK);
+}
+
+//copy a rows by cols matrix stored in src with column stride src_ld to
+//its transpose in dst with column stride dst_ld, i.e., element (r, c) at
+//src[r + c * src_ld] is copied to dst[c + r * dst_ld]
+template <typename T>
+inline void transposeTile(const T *src, ptrdiff_t src_ld, T *dst, ptrdiff_t dst_ld, ptrdiff_t rows, ptrdiff_t cols){
+    const ptrdiff_t block = DTT_TRANSPOSE_BLOCK;
+    for (ptrdiff_t c0 = 0; c0 < cols; c0 += block){
+        ptrdiff_t c1 = (c0 + block < cols) ? c0 + block : cols;
+        for (ptrdiff_t r0 = 0; r0 < rows; r0 += block){
+            ptrdiff_t r1 = (r0 + block < rows) ? r0 + block : rows;
+            for (ptrdiff_t c = c0; c < c1; c++){
+                const T *s = src + c * src_ld;
+                T *d = dst + c;
+                for (ptrdiff_t r = r0; r < r1; r++){
+                    d[r * dst_ld] = s[r];
+                }
+            }
+        }
+    }
+}
+
+//a tile of lines copied between the array and the contiguous buffer,
+//where the copies are divided between the threads in blocks of
+//DTT_TRANSPOSE_BLOCK lines
+template <typename T>
+struct TransposeTile {
+    T *array;               // first line of the tile in the array (stride pre)
+    T *buffer;              // contiguous buffer (stride n)
+    ptrdiff_t n, pre;
+    ptrdiff_t num_lines;    // lines in the tile
+    T scale;
+
+    //first line of block b (or num_lines for b = number of blocks)
+    ptrdiff_t line(ptrdiff_t b) const {
+        ptrdiff_t l = b * DTT_TRANSPOSE_BLOCK;
+        return (l < num_lines) ? l : num_lines;
+    }
+
+    //copy the lines in blocks first to last - 1 into the buffer
+    void gather(ptrdiff_t first, ptrdiff_t last) const {
+        ptrdiff_t l0 = line(first), l1 = line(last);
+        transposeTile((const T *) array + l0, pre, buffer + l0 * n, n, l1 - l0, n);
+    }
+
+    //scale the lines in blocks first to last - 1 of the buffer, and copy
+    //them back to the array
+    void scatter(ptrdiff_t first, ptrdiff_t last) const {
+        ptrdiff_t l0 = line(first), l1 = line(last);
+        if (scale != (T) 1){
+            for (ptrdiff_t i = l0 * n; i < l1 * n; i++){
+                buffer[i] *= scale;
+            }
+        }
+        transposeTile((const T *) buffer + l0 * n, n, array + l0, pre, n, l1 - l0);
+    }
+};
+
+template <typename T>
+inline void gatherTile(const void *tile, int, ptrdiff_t first, ptrdiff_t last){
+    static_cast<const TransposeTile<T> *>(tile)->gather(first, last);
+}
+
+template <typename T>
+inline void scatterTile(const void *tile, int, ptrdiff_t first, ptrdiff_t last){
+    static_cast<const TransposeTile<T> *>(tile)->scatter(first, last);
+}
+
+//transform along the middle dimension of an array of size [pre, n, post]
+//using the transpose path, and multiply the output by scale, returns
+//false if the buffer could not be allocated or the plan could not be
+//created (in and out can be the same)
+template <typename T>
+inline bool executeTransposed(ptrdiff_t n, ptrdiff_t pre, ptrdiff_t post, int kind, T *in, T *out, double scale,
+        const Options &options, int threads){
+
+    //number of lines in each tile, rounded to a multiple of the block
+    //size, where each thread is given a full tile
+    ptrdiff_t lines = DTT_TRANSPOSE_TILE_BYTES / (n * (ptrdiff_t) sizeof(T));
+    lines = (lines / DTT_TRANSPOSE_BLOCK) * DTT_TRANSPOSE_BLOCK;
+    if (lines < DTT_TRANSPOSE_BLOCK) lines = DTT_TRANSPOSE_BLOCK;
+    lines *= threads;
+    if (lines > pre) lines = pre;
+
+    //allocate the contiguous buffer
+    T *buffer = (T *) FftwApi<T>::allocate(lines * n * sizeof(T));
+    if (buffer == NULL){
+        return false;
+    }
+
+    //each tile is transformed in place in the buffer, with the lines
+    //stored contiguously
+    std::vector<fftw_iodim64> plan_dims(1, iodim(n, 1, 1));
+    std::vector<fftw_iodim64> howmany_dims(1);
+    std::vector<int> kinds(1, kind);
+
+    bool success = true;
+    for (ptrdiff_t o = 0; success && o < post; o++){
+        for (ptrdiff_t p0 = 0; success && p0 < pre; p0 += lines){
+
+            //number of lines in this tile
+            ptrdiff_t num_lines = (p0 + lines < pre) ? lines : pre - p0;
+            ptrdiff_t offset = o * pre * n + p0;
+
+            //gather the lines into the buffer, transform, and scatter,
+            //where the copies are divided between the worker threads (see
+            //dttThreads.h)
+            ptrdiff_t num_blocks = (num_lines + DTT_TRANSPOSE_BLOCK - 1) / DTT_TRANSPOSE_BLOCK;
+            TransposeTile<T> tile = {in + offset, buffer, n, pre, num_lines, (T) scale};
+            parallelFor(gatherTile<T>, &tile, num_blocks, threads);
+            howmany_dims[0] = iodim(num_lines, n, n);
+            success = executeTransform(plan_dims, howmany_dims, kinds, buffer, buffer, options.planner, options.time_limit, threads);
+            if (success){
+                tile.array = out + offset;
+                parallelFor(scatterTile<T>, &tile, num_blocks, threads);
+            }
+
+        }
+    }
+
+    FftwApi<T>::deallocate(buffer);
+    return success;
+
+}
+
+} // namespace dtt
+
+#endif
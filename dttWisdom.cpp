@@ -0,0 +1,182 @@
+/**************************************************************************
+ * MEX file to import, export, and forget FFTW wisdom used by the dtt mex
+ * functions. See dttWisdom.m for usage notes.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#include <cstdio>
+#include <string>
+#include <matrix.h>
+#include <mex.h>
+#include "fftw3.h"
+#include "dttOptions.h"
+#include "dttMex.h"
+
+//read the contents of a file into a string, returns false if the file
+//cannot be read
+static bool readFile(const char *filename, std::string &contents){
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL){
+        return false;
+    }
+    char buffer[4096];
+    size_t num_read;
+    contents.clear();
+    while ((num_read = fread(buffer, 1, sizeof(buffer), file)) > 0){
+        contents.append(buffer, num_read);
+    }
+    bool success = !ferror(file);
+    fclose(file);
+    return success;
+}
+
+//write a string to a file, returns false if the file cannot be written
+static bool writeFile(const char *filename, const char *contents){
+    FILE *file = fopen(filename, "wb");
+    if (file == NULL){
+        return false;
+    }
+    size_t length = strlen(contents);
+    bool success = (fwrite(contents, 1, length, file) == length);
+    success = (fclose(file) == 0) && success;
+    return success;
+}
+
+DTT_MEX_FUNCTION(dttWisdom)
+{
+
+    //--------------------------------------------
+    // DECLARE VARIABLES
+    //--------------------------------------------
+
+    char command[16];
+    char precision[16];
+    char *filename = NULL;
+    bool single = false;
+
+    //--------------------------------------------
+    // CHECK INPUTS
+    //--------------------------------------------
+
+    //check for proper number of arguments
+    if( !(nrhs >= 1 && nrhs <= 3) ) {
+        mexErrMsgTxt("One to three inputs are required.");
+	} else if(nlhs > 1) {
+        mexErrMsgTxt("Too many output arguments.");
+	}
+
+    //get the command
+    if (!dtt::getString(prhs[0], command, sizeof(command))){
+        mexErrMsgTxt("Input for COMMAND must be 'import', 'export', or 'forget'.");
+    }
+
+    //get the precision (double and single precision wisdom are stored
+    //separately by FFTW)
+    if (nrhs == 3){
+        if (!dtt::getString(prhs[2], precision, sizeof(precision))){
+            mexErrMsgTxt("Input for PRECISION must be 'double' or 'single'.");
+        } else if (dtt::equalsIgnoreCase(precision, "single")){
+            single = true;
+        } else if (!dtt::equalsIgnoreCase(precision, "double")){
+            mexErrMsgTxt("Input for PRECISION must be 'double' or 'single'.");
+        }
+    }
+
+    //get the filename (an empty filename is the same as no filename)
+    if (nrhs >= 2 && !mxIsEmpty(prhs[1])){
+        if (!mxIsChar(prhs[1])){
+            mexErrMsgTxt("Input for FILENAME must be a string.");
+        }
+        filename = mxArrayToString(prhs[1]);
+    }
+
+    //--------------------------------------------
+    // RUN COMMAND
+    //--------------------------------------------
+
+    if (dtt::equalsIgnoreCase(command, "import")){
+
+        //import wisdom from file
+        if (filename == NULL){
+            mexErrMsgTxt("Input for FILENAME is required to import wisdom.");
+        }
+        std::string wisdom;
+        bool success = readFile(filename, wisdom) &&
+                (single ? fftwf_import_wisdom_from_string(wisdom.c_str()) : fftw_import_wisdom_from_string(wisdom.c_str()));
+        mxFree(filename);
+
+        //return success flag, otherwise throw an error on failure
+        if (nlhs == 1){
+            plhs[0] = mxCreateLogicalScalar(success);
+        } else if (!success){
+            mexErrMsgTxt("FFTW wisdom could not be imported from file.");
+        }
+
+    } else if (dtt::equalsIgnoreCase(command, "export")){
+
+        //export wisdom to a string
+        char *wisdom = single ? fftwf_export_wisdom_to_string() : fftw_export_wisdom_to_string();
+        if (wisdom == NULL){
+            mexErrMsgTxt("FFTW wisdom could not be exported.");
+        }
+
+        //write to file, or return as a string if no filename is given
+        bool success = true;
+        bool to_file = (filename != NULL);
+        if (to_file){
+            success = writeFile(filename, wisdom);
+            mxFree(filename);
+        }
+        if (nlhs == 1){
+            plhs[0] = to_file ? mxCreateLogicalScalar(success) : mxCreateString(wisdom);
+        }
+        if (single){
+            fftwf_free(wisdom);
+        } else {
+            fftw_free(wisdom);
+        }
+        if (!success && nlhs == 0){
+            mexErrMsgTxt("FFTW wisdom could not be written to file.");
+        }
+
+    } else if (dtt::equalsIgnoreCase(command, "forget")){
+
+        //forget accumulated wisdom (existing plans are not affected), both
+        //precisions are forgotten unless the precision is given
+        if (filename != NULL){
+            mxFree(filename);
+        }
+        if (single || nrhs < 3){
+            fftwf_forget_wisdom();
+        }
+        if (!single){
+            fftw_forget_wisdom();
+        }
+
+    } else {
+        if (filename != NULL){
+            mxFree(filename);
+        }
+        mexErrMsgTxt("Input for COMMAND must be 'import', 'export', or 'forget'.");
+    }
+
+    return;
+}
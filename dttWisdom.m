@@ -0,0 +1,95 @@
+function varargout = dttWisdom(varargin)
+%DTTWISDOM Import, export, or forget FFTW wisdom.
+%
+% DESCRIPTION:
+%     dttWisdom saves and loads the FFTW wisdom accumulated when plans are
+%     created by dtt1D, dtt2D, dtt3D, and dttND using the 'measure',
+%     'patient', or 'exhaustive' planner (see dttOptions). Wisdom records
+%     the fastest algorithm found for each transform, so plans for the
+%     same sizes can be created almost instantly in a later MATLAB session
+%     after the wisdom file is imported, instead of being measured again.
+%
+%     Wisdom is stored by the FFTW library. When the mex functions are
+%     compiled against the shared FFTW library (the default used by
+%     compileDttMex), wisdom imported using dttWisdom is used by all of
+%     the DTT functions.
+%
+%     For example, a production job can tune and save the plans once:
+%
+%         dttOptions('Planner', 'patient');
+%         dtt3D(zeros(256, 256, 256), 1);
+%         dttWisdom('export', 'dtt_wisdom.txt');
+%
+%     and then load the tuned plans at startup:
+%
+%         dttWisdom('import', 'dtt_wisdom.txt');
+%         dttOptions('Planner', 'patient');
+%
+%     Note, the planner rigor must be set to the same (or a lower) value
+%     used when the wisdom was created for it to be re-used.
+%
+%     FFTW stores the wisdom for double and single precision transforms
+%     separately. The wisdom for single precision inputs is imported and
+%     exported by setting the precision input to 'single'.
+%
+% USAGE:
+%     dttWisdom('import', filename)
+%     success = dttWisdom('import', filename)
+%     dttWisdom('export', filename)
+%     wisdom = dttWisdom('export')
+%     dttWisdom('forget')
+%     dttWisdom(..., precision)
+%     wisdom = dttWisdom('export', [], 'single')
+%
+% INPUTS:
+%     command       - One of the following:
+%
+%                         'import' - Import wisdom from filename. If the
+%                                    success output is not requested, an
+%                                    error is thrown if the import fails.
+%                         'export' - Export the current wisdom to
+%                                    filename, or return it as a string
+%                                    if no filename is given.
+%                         'forget' - Forget all current wisdom. Plans
+%                                    already cached by the DTT functions
+%                                    are not affected.
+%
+%     filename      - Name of the wisdom file (may be empty when exporting
+%                     to a string or forgetting wisdom).
+%
+% OPTIONAL INPUTS:
+%     precision     - Precision of the wisdom, given as 'double' or
+%                     'single' (default = 'double'). If not given,
+%                     'forget' forgets the wisdom for both precisions.
+%
+% OUTPUTS:
+%     success       - Boolean indicating whether the wisdom was imported
+%                     (or exported) successfully.
+%     wisdom        - Current wisdom as a string.
+%
+% ABOUT:
+%     author        - Bradley Treeby
+%     date          - 16 October 2026
+%     last update   - 16 October 2026
+%
+% Copyright (C) 2026 Bradley Treeby
+%
+% See also dttOptions, dtt1D, dtt2D, dtt3D, dttND
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+%
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+% call the function in the unified dttmex binary (if dttWisdom has been
+% compiled as a separate mex function, the mex function is called
+% instead of this file, see compileDttMex)
+[varargout{1:nargout}] = dttmex('wisdom', varargin{:});
@@ -0,0 +1,125 @@
+/**************************************************************************
+ * MEX file combining all of the dtt mex functions into a single binary,
+ * so the functions share one FFTW plan cache, one FFTW thread pool, and
+ * the same FFTW wisdom. See dttmex.m for usage notes.
+ *
+ * The first input selects the function, and the remaining inputs are
+ * passed to the function unchanged. This file must be compiled together
+ * with the source of each function with DTT_UNIFIED_MEX defined (see
+ * dttMex.h and compileDttMex.m).
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#ifndef DTT_UNIFIED_MEX
+#error "dttmex.cpp must be compiled with DTT_UNIFIED_MEX defined (see compileDttMex.m)."
+#endif
+
+#include <matrix.h>
+#include <mex.h>
+#include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttOptions.h"
+#include "dttMex.h"
+
+//entry point of each subcommand
+typedef void (*EntryPoint)(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]);
+
+struct Subcommand {
+    const char *name;
+    EntryPoint entry;
+};
+
+static const Subcommand subcommands[] = {
+    {"1D",       dtt1DMex},
+    {"2D",       dtt2DMex},
+    {"3D",       dtt3DMex},
+    {"3Dfile",   dtt3DFileMex},
+    {"ND",       dttNDMex},
+    {"async",    dttAsyncMex},
+    {"plan",     dttPlanMex},
+    {"poisson",  dttPoissonSolveMex},
+    {"gradient", gradientDttMex},
+    {"pstd2D",   pstd2DMex},
+    {"wisdom",   dttWisdomMex},
+};
+
+static const int num_subcommands = sizeof(subcommands) / sizeof(subcommands[0]);
+
+//return the state of the shared plan cache
+static void cacheStats(int nlhs, mxArray *plhs[], int nrhs){
+
+    if (nrhs != 1){
+        mexErrMsgTxt("The stats subcommand does not take any inputs.");
+    }
+    if (nlhs > 1){
+        mexErrMsgTxt("Too many outputs.");
+    }
+
+    const char *fields[] = {"DoublePlans", "SinglePlans", "PlanHits", "PlanMisses"};
+    plhs[0] = mxCreateStructMatrix(1, 1, 4, fields);
+    dtt::PlanCounters &counters = dtt::planCounters();
+    mxSetField(plhs[0], 0, "DoublePlans", mxCreateDoubleScalar((double) dtt::planCache<double>().size()));
+    mxSetField(plhs[0], 0, "SinglePlans", mxCreateDoubleScalar((double) dtt::planCache<float>().size()));
+    mxSetField(plhs[0], 0, "PlanHits", mxCreateDoubleScalar((double) counters.hits));
+    mxSetField(plhs[0], 0, "PlanMisses", mxCreateDoubleScalar((double) counters.misses));
+
+}
+
+void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[])
+{
+
+    //--------------------------------------------
+    // CHECK SUBCOMMAND
+    //--------------------------------------------
+
+    char command[16];
+
+    //check for proper number of arguments
+    if (nrhs < 1) {
+        mexErrMsgTxt("At least one input is required.");
+    }
+
+    //get the subcommand
+    if (!dtt::getString(prhs[0], command, sizeof(command))){
+        mexErrMsgTxt("Input for COMMAND must be one of '1D', '2D', '3D', '3Dfile', 'ND', 'async', 'plan', 'poisson', 'gradient', 'pstd2D', 'wisdom', or 'stats'.");
+    }
+
+    //--------------------------------------------
+    // DISPATCH
+    //--------------------------------------------
+
+    //the statistics of the shared plan cache are handled here, as they
+    //are not part of any one function
+    if (dtt::equalsIgnoreCase(command, "stats")){
+        cacheStats(nlhs, plhs, nrhs);
+        return;
+    }
+
+    //pass the remaining inputs to the selected function
+    for (int i = 0; i < num_subcommands; i++){
+        if (dtt::equalsIgnoreCase(command, subcommands[i].name)){
+            subcommands[i].entry(nlhs, plhs, nrhs - 1, prhs + 1);
+            return;
+        }
+    }
+    mexErrMsgTxt("Input for COMMAND must be one of '1D', '2D', '3D', '3Dfile', 'ND', 'async', 'plan', 'poisson', 'gradient', 'pstd2D', 'wisdom', or 'stats'.");
+
+}
@@ -0,0 +1,76 @@
+%DTTMEX Single mex binary containing all of the DTT functions.
+%
+% DESCRIPTION:
+%     dttmex contains all of the DTT mex functions in a single binary, so
+%     the functions share one FFTW plan cache, one FFTW thread pool, and
+%     the same FFTW wisdom for the lifetime of the MATLAB process (or
+%     until clear dttmex is called). The first input selects the
+%     function, and the remaining inputs are passed to the function
+%     unchanged. dttmex is not normally called directly, as the .m files
+%     for each function (dtt1D.m, dtt2D.m, etc.) call dttmex with the
+%     matching command.
+%
+%     dttmex is compiled by compileDttMex (the default), or using CMake
+%     with -DDTT_BUILD_MEX=ON. If a function has also been compiled as a
+%     separate mex function, the separate mex function is called instead
+%     of the .m file, and does not share the plan cache.
+%
+% USAGE:
+%     X = dttmex('1D', x, DTT_type)
+%     X = dttmex('3D', x, DTT_type, 'Threads', 4)
+%     stats = dttmex('stats')
+%
+% INPUTS:
+%     command       - One of the following:
+%
+%                         '1D'       - dtt1D
+%                         '2D'       - dtt2D
+%                         '3D'       - dtt3D
+%                         '3Dfile'   - dtt3DFile
+%                         'ND'       - dttND
+%                         'async'    - dttAsync
+%                         'plan'     - dttPlan
+%                         'poisson'  - dttPoissonSolve
+%                         'gradient' - gradientDtt
+%                         'pstd2D'   - pstd2D
+%                         'wisdom'   - dttWisdom
+%                         'stats'    - return the state of the shared
+%                                      plan cache
+%
+%     varargin      - Inputs for the selected function.
+%
+% OUTPUTS:
+%     varargout     - Outputs of the selected function. For 'stats', a
+%                     structure with the fields:
+%
+%                         DoublePlans - number of cached double
+%                                       precision plans
+%                         SinglePlans - number of cached single
+%                                       precision plans
+%                         PlanHits    - number of plans found in the
+%                                       cache since dttmex was loaded
+%                         PlanMisses  - number of plans created since
+%                                       dttmex was loaded
+%
+% ABOUT:
+%     author        - Bradley Treeby
+%     date          - 16 October 2026
+%     last update   - 16 October 2026
+%
+% Copyright (C) 2026 Bradley Treeby
+%
+% See also compileDttMex, dtt1D, dtt2D, dtt3D, dtt3DFile, dttAsync, dttND,
+% dttPlan, dttStats
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+%
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
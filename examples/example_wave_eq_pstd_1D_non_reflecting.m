@@ -18,11 +18,11 @@
 % ABOUT:
 %     author      - Bradley Treeby
 %     date        - 19 April 2020
-%     last update - 20 April 2020
+%     last update - 16 October 2026
 %
 % Copyright (C) 2020 Bradley Treeby
 %
-% See also dtt1D, gradientDtt1D
+% See also dtt1D, gradientDtt, gradientDtt1D
 
 % This program is free software: you can redistribute it and/or modify it
 % under the terms of the GNU General Public License as published by the
@@ -43,12 +43,12 @@ clearvars;
 % DEFINE LITERALS
 % =========================================================================
 
-% shift and align variables used by gradientDtt1D (shift = 1 and shift = 2
+% shift and align variables used by gradientDtt (shift = 1 and shift = 2
 % return the same output if align_output = false)
 shift_output = 1;
 align_output = false;
 
-% transform types used by gradientDtt1D
+% transform types used by gradientDtt
 DCT1 = 1;    % WSWS
 DCT2 = 2;    % HSHS
 DCT3 = 3;    % WSWA
@@ -164,16 +164,16 @@ for bc_ind = 1:bc_num
     % run the model backwards for dt/2 to calculate the initial condition
     % for u, to take into account the time staggering between p and u, in
     % this case setting u0 = 0
-    u = (dt / 2) / rho0 * gradientDtt1D(p, dx, T1, shift_output, align_output);
+    u = (dt / 2) / rho0 * gradientDtt(p, dx, T1, shift_output, align_output);
         
     % calculate pressure in a loop
     for time_ind = 1:Nt
 
         % update u
-        u = u - dt / rho0 * gradientDtt1D(p, dx, T1, shift_output, align_output);
+        u = u - dt / rho0 * gradientDtt(p, dx, T1, shift_output, align_output);
 
         % update p
-        p = p - dt * rho0 * c0^2 * gradientDtt1D(u, dx, T2, shift_output, align_output);
+        p = p - dt * rho0 * c0^2 * gradientDtt(u, dx, T2, shift_output, align_output);
         
         % save the pressure field
         if ~rem(time_ind, floor(Nt / waterfall_snapshots))
@@ -0,0 +1,120 @@
+% DESCRIPTION:
+%     This example script solves the 2D wave equation (written as two
+%     coupled first-order equations) using a DTT-based PSTD method subject
+%     to Neumann and then Dirichlet boundary conditions on each side of the
+%     domain.
+%
+%     The simulations are the same as example_wave_eq_pstd_2D_neumann and
+%     example_wave_eq_pstd_2D_dirichlet, but the time loop is run in
+%     native code using pstd2D. The boundary condition is set by the DTT
+%     type of the pressure (DCT-I for Neumann, DST-I for Dirichlet), and
+%     the particle velocity is computed on a staggered grid. Snapshots of
+%     the pressure field are returned by pstd2D and plotted after the
+%     simulation.
+%
+%     Further details are given in [1].
+%
+%     [1] E. Wise, J. Jaros, B. Cox, and B. Treeby, "Pseudospectral
+%     time-domain (PSTD) methods for the wave equation: Realising boundary
+%     conditions with discrete sine and cosine transforms", 2020.
+%
+% ABOUT:
+%     author      - Bradley Treeby
+%     date        - 16 October 2026
+%     last update - 16 October 2026
+%
+% Copyright (C) 2026 Bradley Treeby
+%
+% See also pstd2D, example_wave_eq_pstd_2D_neumann,
+% example_wave_eq_pstd_2D_dirichlet
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+%
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+clearvars;
+
+% =========================================================================
+% DEFINE LITERALS
+% =========================================================================
+
+% transform types used by pstd2D
+DCT1 = 1;    % WSWS
+DST1 = 5;    % WAWA
+
+% plot frequency for snapshots of the field (time steps)
+plot_freq = 250;
+
+% =========================================================================
+% DEFINE SIMULATION SETTINGS
+% =========================================================================
+
+% set the grid size (assuming grid is square)
+Nx   = 256;     % grid size [m]
+dx   = 1/Nx;    % grid spacing [m]
+
+% set the medium properties
+c0   = 1500;    % sound speed [m/s]
+rho0 = 1000;    % density [kg/m^3]
+
+% set CFL and number of time steps
+CFL  = 0.2;
+Nt   = 1000;
+
+% calculate the time step
+dt = CFL * dx / c0;
+
+% =========================================================================
+% DEFINE INITIAL CONDITIONS
+% =========================================================================
+
+% spatial grid
+x = (0:Nx - 1) * dx;
+
+% properties of Gaussian initial condition
+width = Nx * dx / 28;
+offset = Nx * dx / 3;
+
+% define initial pressure distribution on regular grid as a Gaussian
+p0 = 0.5 * exp(-((x - offset) / width).^2);
+p0 = p0.' * p0;
+
+% =========================================================================
+% RUN SIMULATIONS USING DTT-BASED PSTD METHOD
+% =========================================================================
+
+% create custom colour map
+cm = [bone(256); flipud(hot(256))];
+
+% loop over boundary conditions
+bc_types  = [DCT1, DST1];
+bc_labels = {'Neumann', 'Dirichlet'};
+for bc_ind = 1:length(bc_types)
+
+    % run the time loop, starting with the particle velocity at zero
+    tic;
+    [p, ux, uy, p_snapshots] = pstd2D(p0, 0, 0, bc_types(bc_ind), dx, dt, c0, rho0, Nt, plot_freq);
+    disp([bc_labels{bc_ind} ' simulation completed in ' num2str(toc) ' seconds']);
+
+    % plot snapshots of pressure field
+    for snapshot_ind = 1:size(p_snapshots, 3)
+        figure;
+        imagesc(x, x, p_snapshots(:, :, snapshot_ind), 0.075 * [-1, 1]);
+        axis image;
+        colormap(cm);
+        box on;
+        set(gca, 'XTick', 0:0.25:1, 'YTick', 0:0.25:1, 'XTickLabel', {}, 'YTickLabel', {});
+        title([bc_labels{bc_ind} ', time step ' num2str(snapshot_ind * plot_freq)]);
+        drawnow;
+    end
+
+end
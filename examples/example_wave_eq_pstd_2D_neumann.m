@@ -24,7 +24,7 @@
 %
 % Copyright (C) 2020 Bradley Treeby
 %
-% See also dtt1D, gradientDtt1D
+% See also dtt1D, gradientDtt1D, pstd2D
 
 % This program is free software: you can redistribute it and/or modify it
 % under the terms of the GNU General Public License as published by the
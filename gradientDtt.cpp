@@ -0,0 +1,270 @@
+/**************************************************************************
+ * MEX file to compute the spectral gradient of an array using discrete
+ * trigonometric transforms. This is a native implementation of
+ * gradientDtt1D that computes the forward transform, wavenumber scaling,
+ * symmetry dictated trim/pad, inverse transform, and normalisation using
+ * two cached FFTW plans and a persistent workspace (see dttGradient.h).
+ * See gradientDtt.m for usage notes.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#include <vector>
+#include <matrix.h>
+#include <mex.h>
+#include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttOptions.h"
+#include "dttGradient.h"
+#include "dttStats.h"
+#include "dttMex.h"
+
+//--------------------------------------------
+// WAVENUMBERS
+//--------------------------------------------
+
+//wavenumbers for the last gradient calculation
+static std::vector<double> scale;
+static ptrdiff_t scale_Nx = 0;
+static double scale_dx = 0;
+static int scale_dtt_type = 0;
+
+//compute the scaling for the given DTT type (only recomputed if the
+//length, spacing, or type changes)
+static void computeScale(int dtt_type, ptrdiff_t Nx, double dx){
+    if (Nx == scale_Nx && dx == scale_dx && dtt_type == scale_dtt_type){
+        return;
+    }
+    dtt::gradientScale(dtt_type, Nx, dx, 1.0, scale);
+    scale_Nx = Nx;
+    scale_dx = dx;
+    scale_dtt_type = dtt_type;
+}
+
+//--------------------------------------------
+// WORKSPACE
+//--------------------------------------------
+
+//persistent workspace used for the forward transform
+static void *workspace = NULL;
+static size_t workspace_bytes = 0;
+
+//return a workspace of at least the given size
+static void *getWorkspace(size_t bytes){
+    if (bytes > workspace_bytes){
+        if (workspace != NULL){
+            fftw_free(workspace);
+        }
+        workspace = fftw_malloc(bytes);
+        workspace_bytes = (workspace == NULL) ? 0 : bytes;
+    }
+    return workspace;
+}
+
+//release cached FFTW plans and the workspace when the mex file is cleared
+static void clearGradient(){
+    dtt::clearPlanCache();
+    if (workspace != NULL){
+        fftw_free(workspace);
+    }
+    workspace = NULL;
+    workspace_bytes = 0;
+}
+
+DTT_MEX_FUNCTION(gradientDtt)
+{
+
+    //--------------------------------------------
+    // DECLARE VARIABLES
+    //--------------------------------------------
+
+    mxArray *output_mat;
+    const mwSize *dims;
+    mwSize numelements;
+    int numdims;
+    int i;
+    double dx;
+    double value;
+    int dtt_type;
+    int shift = 0;              // no shift by default
+    bool align_output = true;   // align output with the input by default
+    int DIM = 0;                // set to the first non-singleton dimension if not given by user
+    ptrdiff_t Nx, pre, post;
+    int first_option = 3;       // index of the first optional name/value input
+
+    //start timing the call (see dttStats.h)
+    dtt::CallStats stats("gradientDtt");
+
+    //release cached FFTW plans and workspace when the mex file is cleared
+    dtt::atExit(clearGradient);
+
+    //--------------------------------------------
+    // CHECK NUMBER OF INPUTS AND OUTPUTS
+    //--------------------------------------------
+
+    //check for proper number of input and output arguments
+    if(nrhs < 3) {
+        mexErrMsgTxt("At least three inputs are required.");
+	} else if(nlhs > 1) {
+        mexErrMsgTxt("Too many output arguments.");
+	}
+
+    //--------------------------------------------
+    // CHECK SCALAR INPUTS
+    //--------------------------------------------
+
+    //grid spacing
+    if (!dtt::getScalar(prhs[1], dx) || !(dx > 0)){
+        mexErrMsgTxt("Input for DX must be a positive real scalar.");
+    }
+
+    //DTT type
+    if (!dtt::getScalar(prhs[2], value) || value != (int) value || value < 1 || value > 8){
+        mexErrMsgTxt("Input for DTT_TYPE must be an integer between 1 and 8.");
+    }
+    dtt_type = (int) value;
+
+    //optional positional inputs (shift, align_output, and dim), which can
+    //be empty to use the default value, and are followed by the name/value
+    //pairs
+    for (i = 3; i < nrhs && i < 6 && !mxIsChar(prhs[i]); i++){
+        first_option = i + 1;
+        if (mxIsEmpty(prhs[i])){
+            continue;
+        }
+        if (!dtt::getScalar(prhs[i], value)){
+            mexErrMsgTxt("Inputs for SHIFT, ALIGN_OUTPUT, and DIM must be real scalars.");
+        }
+        switch (i) {
+            case 3:
+                if (value != 0 && value != 1 && value != 2){
+                    mexErrMsgTxt("Input for SHIFT must be 0, 1, or 2.");
+                }
+                shift = (int) value;
+                break;
+            case 4:
+                align_output = (value != 0);
+                break;
+            default:
+                if (!(value >= 1 && value == (int) value)){
+                    mexErrMsgTxt("Input for DIM must be a positive integer.");
+                }
+                DIM = (int) value;
+                break;
+        }
+    }
+
+    //get planner options from name/value pairs and global defaults
+    dtt::Options options = dtt::getOptions(nrhs, prhs, first_option);
+    stats.enable(options.stats);
+    if (options.in_place || options.inverse || dtt::hasOption(nrhs, prhs, first_option, "Strategy")){
+        mexErrMsgTxt("The InPlace, Inverse, and Strategy options are not supported by gradientDtt.");
+    }
+
+    //--------------------------------------------
+    // CHECK AND ALLOCATE INPUT AND OUTPUT ARRAYS
+    //--------------------------------------------
+
+    //check the input matrix is real and double or single precision
+    if( !((mxIsDouble(prhs[0]) || mxIsSingle(prhs[0])) && !mxIsComplex(prhs[0])) ) {
+        mexErrMsgTxt("Input array must be double or single precision and real.");
+    }
+
+    //get the dimensions of the input array
+    numdims = mxGetNumberOfDimensions(prhs[0]);
+    dims = mxGetDimensions(prhs[0]);
+    numelements = mxGetNumberOfElements(prhs[0]);
+
+    //check if 1D and force the correct DIM (input DIM is not used)
+    if (numdims == 2 && dims[0] == 1) {
+        DIM = 2;
+    }
+    else if (numdims == 2 && dims[1] == 1) {
+        DIM = 1;
+    }
+
+    //if DIM is not given, use the first non-singleton dimension
+    if (DIM == 0) {
+        DIM = 1;
+        for (i = 0; i < numdims; i++) {
+            if (dims[i] != 1) {
+                DIM = i + 1;
+                break;
+            }
+        }
+    }
+
+    //split the array into the dimensions before DIM, the gradient
+    //dimension, and the dimensions after DIM
+    pre = 1;
+    post = 1;
+    Nx = (DIM <= numdims) ? (ptrdiff_t) dims[DIM - 1] : 1;
+    for (i = 0; i < numdims; i++) {
+        if (i < DIM - 1) {
+            pre *= (ptrdiff_t) dims[i];
+        } else if (i > DIM - 1) {
+            post *= (ptrdiff_t) dims[i];
+        }
+    }
+
+    //describe the calculation, and check the length is sufficient
+    dtt::Gradient g = dtt::describeGradient(dtt_type, shift, align_output, Nx);
+    if (Nx < 2 || g.L < 1){
+        mexErrMsgTxt("Input array must have at least 2 elements along DIM (3 for DCT-I without shift).");
+    }
+
+    stats.mark(DTT_PHASE_VALIDATE);
+
+    //create MATLAB output with the same precision as the input, where the
+    //length along DIM is different if the output is not aligned (the
+    //output is not zero-filled as every element is written below)
+    std::vector<mwSize> out_dims(dims, dims + numdims);
+    out_dims[DIM - 1] = (mwSize) g.num_out;
+    output_mat = plhs[0] = mxCreateUninitNumericArray((mwSize) out_dims.size(), &out_dims[0], mxGetClassID(prhs[0]), mxREAL);
+    stats.mark(DTT_PHASE_ALLOCATE);
+
+    //--------------------------------------------
+    // COMPUTE GRADIENT
+    //--------------------------------------------
+
+    //update the wavenumbers
+    computeScale(dtt_type, Nx, dx);
+    stats.mark(DTT_PHASE_PLAN);
+
+    //compute using cached plans for the forward and inverse transforms
+    int threads = dtt::getThreads(options, numelements);
+    bool success;
+    size_t num_work = (size_t) (pre * (Nx + 2) * post);
+    if (mxIsSingle(prhs[0])){
+        float *work = (float *) getWorkspace(num_work * sizeof(float));
+        success = (work != NULL) && dtt::computeGradient(g, scale, (float *) mxGetData(prhs[0]), (float *) mxGetData(output_mat), work, Nx, pre, post, options, threads);
+    } else {
+        double *work = (double *) getWorkspace(num_work * sizeof(double));
+        success = (work != NULL) && dtt::computeGradient(g, scale, (double *) mxGetData(prhs[0]), (double *) mxGetData(output_mat), work, Nx, pre, post, options, threads);
+    }
+    if (!success){
+        mexErrMsgTxt("FFTW plan could not be created.");
+    }
+    stats.mark(DTT_PHASE_EXECUTE);
+    stats.addBytes((double) (numelements + mxGetNumberOfElements(output_mat)) * mxGetElementSize(prhs[0]));
+    stats.finish();
+
+    return;
+}
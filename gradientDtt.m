@@ -0,0 +1,103 @@
+function varargout = gradientDtt(varargin)
+%GRADIENTDTT Calculate gradient using discrete trigonometric transforms.
+%
+% DESCRIPTION:
+%     gradientDtt computes the spectral gradient of the input array f
+%     along the dimension dim using discrete trigonometric transforms
+%     (DTTs). The DTTs used to transform the input to and from the
+%     frequency domain are chosen based on the symmetry of the input f,
+%     defined using dtt_type. The gradient values can also be returned on
+%     a staggered grid.
+%
+%     gradientDtt returns the same values as gradientDtt1D, but is
+%     implemented as a mex function. The forward transform, wavenumber
+%     scaling, trimming and padding of the basis function weights,
+%     inverse transform, and normalisation are computed in native code
+%     using two cached FFTW plans and a persistent workspace, without
+%     creating any temporary arrays in MATLAB. This makes gradientDtt
+%     suitable for use within time-stepping loops. Unlike gradientDtt1D,
+%     the input can be an N-D array, in which case the gradient is
+%     computed over every line along dim, and the output has the same
+%     orientation as the input.
+%
+%     For details on how the DTTs are chosen and the output is aligned
+%     with the input, see gradientDtt1D.
+%
+%     For compilation instructions, see compileDttMex.
+%
+% USAGE:
+%     dfdx = gradientDtt(f, dx, dtt_type)
+%     dfdx = gradientDtt(f, dx, dtt_type, shift)
+%     dfdx = gradientDtt(f, dx, dtt_type, shift, align_output)
+%     dfdx = gradientDtt(f, dx, dtt_type, shift, align_output, dim)
+%     dfdx = gradientDtt(..., 'Planner', 'measure')
+%
+% INPUTS:
+%     f            - Array to find the gradient of in double or single
+%                    precision.
+%     dx           - Grid point spacing.
+%     dtt_type     - Type of discrete trigonometric transform. This should
+%                    correspond to the assumed input symmetry of the input
+%                    function, where:
+%
+%                        1: DCT-I    WSWS
+%                        2: DCT-II   HSHS
+%                        3: DCT-III  WSWA
+%                        4: DCT-IV   HSHA
+%                        5: DST-I    WAWA
+%                        6: DST-II   HAHA
+%                        7: DST-III  WAWS
+%                        8: DST-IV   HAHS
+%
+% OPTIONAL INPUTS:
+%     shift        - Integer controlling whether derivative is shifted to a
+%                    staggered grid (default = 0), where
+%
+%                        0: no shift
+%                        1: shift by + dx/2
+%                        2: shift by - dx/2
+%
+%     align_output - Boolean controlling whether the returned values are
+%                    padded and trimmed based on the implied symmetry so
+%                    the output is the same size as the input (default =
+%                    true). If align_output is false, the size of the
+%                    output along dim can differ from the input.
+%     dim          - Dimension over which the gradient is computed. If not
+%                    given, the gradient is computed over the first
+%                    non-singleton dimension.
+%
+%     The optional inputs can be set to [] to use the default values.
+%     Options used by the DTT functions (e.g., 'Planner' and 'Threads')
+%     can also be given as name/value pairs after the other inputs. The
+%     'InPlace', 'Inverse', and 'Strategy' options are not supported.
+%
+% OUTPUTS:
+%     dfdx         - Gradient of the input function, returned with the
+%                    same precision as f.
+%
+% ABOUT:
+%     author       - Bradley Treeby
+%     date         - 16 October 2026
+%     last update  - 16 October 2026
+%
+% Copyright (C) 2026 Bradley Treeby
+%
+% See also dtt1D, gradientDtt1D, dttOptions
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+%
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+% call the function in the unified dttmex binary (if gradientDtt has been
+% compiled as a separate mex function, the mex function is called
+% instead of this file, see compileDttMex)
+[varargout{1:nargout}] = dttmex('gradient', varargin{:});
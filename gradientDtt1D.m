@@ -21,6 +21,10 @@ function deriv = gradientDtt1D(f, dx, dtt_type, shift, align_output)
 %
 %     For additional details on gradient calculation using DTTs, see [1].
 %
+%     gradientDtt computes the same gradient using a mex function, and
+%     also supports N-D arrays. gradientDtt1D is kept as a reference
+%     implementation of the steps involved.
+%
 %     [1] E. Wise, J. Jaros, B. Cox, and B. Treeby, "Pseudospectral
 %     time-domain (PSTD) methods for the wave equation: Realising boundary
 %     conditions with discrete sine and cosine transforms", 2020.
@@ -62,11 +66,11 @@ function deriv = gradientDtt1D(f, dx, dtt_type, shift, align_output)
 % ABOUT:
 %     author       - Bradley Treeby
 %     date         - 23 April 2013
-%     last update  - 20 April 2020
+%     last update  - 16 October 2026
 %
 % Copyright (C) 2013-2020 Bradley Treeby
 %
-% See also dtt1D
+% See also dtt1D, gradientDtt
 
 % This program is free software: you can redistribute it and/or modify it
 % under the terms of the GNU General Public License as published by the
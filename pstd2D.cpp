@@ -0,0 +1,332 @@
+/**************************************************************************
+ * MEX file to solve the 2D wave equation (written as two coupled
+ * first-order equations) using a DTT-based PSTD method. This is a native
+ * implementation of the time loop in example_wave_eq_pstd_2D_neumann.m
+ * and example_wave_eq_pstd_2D_dirichlet.m, generalised to any
+ * combination of boundary conditions. See pstd2D.m for usage notes.
+ *
+ * Each time step computes four spectral gradients using the shared
+ * gradient calculation (see dttGradient.h) with cached FFTW plans. The
+ * constants multiplying each gradient in the update equations are
+ * combined with the wavenumbers, so the fields are updated in place by
+ * adding the output of each inverse transform.
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#include <cstring>
+#include <vector>
+#include <matrix.h>
+#include <mex.h>
+#include "fftw3.h"
+#include "dttPlanCache.h"
+#include "dttOptions.h"
+#include "dttGradient.h"
+#include "dttStats.h"
+#include "dttMex.h"
+
+//DTT type of the particle velocity for each DTT type of the pressure,
+//given by the symmetry of the gradient on the staggered grid (e.g.,
+//WSWS -> HAHA), the mapping is its own inverse
+static int velocityType(int dtt_type){
+    static const int types[9] = {0, 6, 5, 8, 7, 2, 1, 4, 3};
+    return types[dtt_type];
+}
+
+//add the values of b to a
+template <typename T>
+static void addTo(T *a, const T *b, ptrdiff_t n){
+    for (ptrdiff_t i = 0; i < n; i++){
+        a[i] += b[i];
+    }
+}
+
+//add the values of b and c to a
+template <typename T>
+static void addTo(T *a, const T *b, const T *c, ptrdiff_t n){
+    for (ptrdiff_t i = 0; i < n; i++){
+        a[i] += b[i] + c[i];
+    }
+}
+
+//description of the gradients and wavenumbers used in each time step
+struct Simulation {
+    ptrdiff_t Nx, Ny, Lx, Ly;                   // size of the pressure and velocity grids
+    dtt::Gradient dpdx, dpdy, duxdx, duydy;     // gradient calculations
+    std::vector<double> scale_dpdx, scale_dpdy; // wavenumbers combined with -dt/rho0
+    std::vector<double> scale_duxdx, scale_duydy; // wavenumbers combined with -dt*rho0*c0^2
+};
+
+//run the simulation for Nt time steps, storing the pressure every
+//snapshot_freq steps, returns false if an FFTW plan could not be created
+template <typename T>
+static bool runSimulation(const Simulation &sim, T *p, T *ux, T *uy, T *snapshots, int Nt, int snapshot_freq,
+        const dtt::Options &options, int threads){
+
+    ptrdiff_t Nx = sim.Nx, Ny = sim.Ny, Lx = sim.Lx, Ly = sim.Ly;
+    ptrdiff_t num_p = Nx * Ny;
+
+    //allocate buffers for the scaled gradients, and the workspace used
+    //by the gradient calculation
+    ptrdiff_t num_buffer = num_p;
+    if (Lx * Ny > num_buffer) num_buffer = Lx * Ny;
+    if (Nx * Ly > num_buffer) num_buffer = Nx * Ly;
+    ptrdiff_t num_work = (Nx + 2) * Ny;
+    if ((Lx + 2) * Ny > num_work) num_work = (Lx + 2) * Ny;
+    if (Nx * (Ny + 2) > num_work) num_work = Nx * (Ny + 2);
+    if (Nx * (Ly + 2) > num_work) num_work = Nx * (Ly + 2);
+    T *buffer_a = (T *) dtt::FftwApi<T>::allocate(num_buffer * sizeof(T));
+    T *buffer_b = (T *) dtt::FftwApi<T>::allocate(num_buffer * sizeof(T));
+    T *work = (T *) dtt::FftwApi<T>::allocate(num_work * sizeof(T));
+
+    bool success = (buffer_a != NULL) && (buffer_b != NULL) && (work != NULL);
+    int snapshot_ind = 0;
+    for (int time_ind = 1; success && time_ind <= Nt; time_ind++){
+
+        //update ux using dpdx (on the staggered grid in x)
+        success = success && dtt::computeGradient(sim.dpdx, sim.scale_dpdx, p, buffer_a, work, Nx, 1, Ny, options, threads);
+        if (success) addTo(ux, buffer_a, Lx * Ny);
+
+        //update uy using dpdy (on the staggered grid in y)
+        success = success && dtt::computeGradient(sim.dpdy, sim.scale_dpdy, p, buffer_a, work, Ny, Nx, 1, options, threads);
+        if (success) addTo(uy, buffer_a, Nx * Ly);
+
+        //update p using duxdx and duydy
+        success = success && dtt::computeGradient(sim.duxdx, sim.scale_duxdx, ux, buffer_a, work, Lx, 1, Ny, options, threads);
+        success = success && dtt::computeGradient(sim.duydy, sim.scale_duydy, uy, buffer_b, work, Ly, Nx, 1, options, threads);
+        if (success) addTo(p, buffer_a, buffer_b, num_p);
+
+        //store snapshot of the pressure field
+        if (success && snapshot_freq > 0 && (time_ind % snapshot_freq) == 0){
+            memcpy(snapshots + snapshot_ind * num_p, p, num_p * sizeof(T));
+            snapshot_ind++;
+        }
+
+    }
+
+    if (buffer_a != NULL) dtt::FftwApi<T>::deallocate(buffer_a);
+    if (buffer_b != NULL) dtt::FftwApi<T>::deallocate(buffer_b);
+    if (work != NULL) dtt::FftwApi<T>::deallocate(work);
+    return success;
+
+}
+
+//create the output for a velocity component, starting from rest if the
+//input is empty or zero, otherwise checking the size matches the grid
+static mxArray *createVelocity(const mxArray *u, mxClassID class_id, ptrdiff_t M, ptrdiff_t N, const char *error_msg){
+    if (mxIsEmpty(u) || (mxGetNumberOfElements(u) == 1 && mxIsNumeric(u) && mxGetScalar(u) == 0)){
+        return mxCreateNumericMatrix((mwSize) M, (mwSize) N, class_id, mxREAL);
+    }
+    if (mxGetClassID(u) != class_id || mxIsComplex(u) || mxGetNumberOfDimensions(u) != 2
+            || (ptrdiff_t) mxGetM(u) != M || (ptrdiff_t) mxGetN(u) != N){
+        mexErrMsgTxt(error_msg);
+    }
+    return mxDuplicateArray(u);
+}
+
+DTT_MEX_FUNCTION(pstd2D)
+{
+
+    //--------------------------------------------
+    // DECLARE VARIABLES
+    //--------------------------------------------
+
+    Simulation sim;
+    mxClassID class_id;
+    const mwSize *dims;
+    double *dtt_type_pointer, *dx_pointer;
+    int dtt_type_x, dtt_type_y;
+    double dx, dy, dt, c0, rho0, value;
+    int Nt;
+    int snapshot_freq = 0;  // no snapshots by default
+    int num_snapshots;
+    int first_option = 9;   // index of the first optional name/value input
+
+    //start timing the call (see dttStats.h)
+    dtt::CallStats stats("pstd2D");
+
+    //release cached FFTW plans when the mex file is cleared
+    dtt::atExit(dtt::clearPlanCache);
+
+    //--------------------------------------------
+    // CHECK NUMBER OF INPUTS AND OUTPUTS
+    //--------------------------------------------
+
+    //check for proper number of input and output arguments
+    if(nrhs < 9) {
+        mexErrMsgTxt("At least nine inputs are required.");
+	} else if(nlhs > 4) {
+        mexErrMsgTxt("Too many output arguments.");
+	}
+
+    //--------------------------------------------
+    // CHECK PRESSURE INPUT
+    //--------------------------------------------
+
+    //check the pressure is real, 2D, and double or single precision
+    if( !((mxIsDouble(prhs[0]) || mxIsSingle(prhs[0])) && !mxIsComplex(prhs[0])) ) {
+        mexErrMsgTxt("Input for P must be double or single precision and real.");
+    }
+    if (mxGetNumberOfDimensions(prhs[0]) != 2){
+        mexErrMsgTxt("Input for P must be 2D.");
+    }
+    class_id = mxGetClassID(prhs[0]);
+    dims = mxGetDimensions(prhs[0]);
+    sim.Nx = (ptrdiff_t) dims[0];
+    sim.Ny = (ptrdiff_t) dims[1];
+
+    //--------------------------------------------
+    // CHECK DTT TYPE AND GRID SPACING INPUTS
+    //--------------------------------------------
+
+    //DTT type of the pressure in each direction, given as a scalar or
+    //length 2 vector
+    if( !(mxIsDouble(prhs[3]) && !mxIsComplex(prhs[3]) && (mxGetNumberOfElements(prhs[3]) == 1 || mxGetNumberOfElements(prhs[3]) == 2)) ) {
+        mexErrMsgTxt("Input for DTT_TYPE must be real, double precision, and scalar or length 2.");
+    }
+    dtt_type_pointer = mxGetPr(prhs[3]);
+    dtt_type_x = (int) dtt_type_pointer[0];
+    dtt_type_y = (int) dtt_type_pointer[mxGetNumberOfElements(prhs[3]) - 1];
+    if (dtt_type_x != dtt_type_pointer[0] || dtt_type_y != dtt_type_pointer[mxGetNumberOfElements(prhs[3]) - 1]
+            || dtt_type_x < 1 || dtt_type_x > 8 || dtt_type_y < 1 || dtt_type_y > 8){
+        mexErrMsgTxt("Input for DTT_TYPE must contain integers between 1 and 8.");
+    }
+
+    //grid spacing in each direction, given as a scalar or length 2 vector
+    if( !(mxIsDouble(prhs[4]) && !mxIsComplex(prhs[4]) && (mxGetNumberOfElements(prhs[4]) == 1 || mxGetNumberOfElements(prhs[4]) == 2)) ) {
+        mexErrMsgTxt("Input for DX must be real, double precision, and scalar or length 2.");
+    }
+    dx_pointer = mxGetPr(prhs[4]);
+    dx = dx_pointer[0];
+    dy = dx_pointer[mxGetNumberOfElements(prhs[4]) - 1];
+    if (!(dx > 0 && dy > 0)){
+        mexErrMsgTxt("Input for DX must be positive.");
+    }
+
+    //--------------------------------------------
+    // CHECK SCALAR INPUTS
+    //--------------------------------------------
+
+    if (!dtt::getScalar(prhs[5], dt) || !(dt > 0)){
+        mexErrMsgTxt("Input for DT must be a positive real scalar.");
+    }
+    if (!dtt::getScalar(prhs[6], c0) || !(c0 > 0)){
+        mexErrMsgTxt("Input for C0 must be a positive real scalar.");
+    }
+    if (!dtt::getScalar(prhs[7], rho0) || !(rho0 > 0)){
+        mexErrMsgTxt("Input for RHO0 must be a positive real scalar.");
+    }
+    if (!dtt::getScalar(prhs[8], value) || !(value >= 0) || value != (int) value){
+        mexErrMsgTxt("Input for NT must be a non-negative integer.");
+    }
+    Nt = (int) value;
+
+    //snapshot frequency (optional, followed by the name/value pairs)
+    if (nrhs >= 10 && !mxIsChar(prhs[9])){
+        first_option = 10;
+        if (!mxIsEmpty(prhs[9])){
+            if (!dtt::getScalar(prhs[9], value) || !(value >= 0) || value != (int) value){
+                mexErrMsgTxt("Input for SNAPSHOT_FREQ must be a non-negative integer.");
+            }
+            snapshot_freq = (int) value;
+        }
+    }
+
+    //get planner options from name/value pairs and global defaults
+    dtt::Options options = dtt::getOptions(nrhs, prhs, first_option);
+    stats.enable(options.stats);
+    if (options.in_place || options.inverse || dtt::hasOption(nrhs, prhs, first_option, "Strategy")){
+        mexErrMsgTxt("The InPlace, Inverse, and Strategy options are not supported by pstd2D.");
+    }
+
+    //--------------------------------------------
+    // DESCRIBE GRADIENT CALCULATIONS
+    //--------------------------------------------
+
+    //pressure gradients are computed on the staggered grid (shift = 1),
+    //without aligning the output, so the velocity grid has the length
+    //given by the symmetry of the staggered grid (e.g., Nx - 1 for WSWS)
+    sim.dpdx = dtt::describeGradient(dtt_type_x, 1, false, sim.Nx);
+    sim.dpdy = dtt::describeGradient(dtt_type_y, 1, false, sim.Ny);
+    sim.Lx = sim.dpdx.num_out;
+    sim.Ly = sim.dpdy.num_out;
+    if (sim.Nx < 2 || sim.Ny < 2 || sim.Lx < 2 || sim.Ly < 2){
+        mexErrMsgTxt("Input for P must have at least 2 elements in each dimension (3 for DCT-I).");
+    }
+
+    //velocity gradients are computed back on the regular grid
+    sim.duxdx = dtt::describeGradient(velocityType(dtt_type_x), 1, false, sim.Lx);
+    sim.duydy = dtt::describeGradient(velocityType(dtt_type_y), 1, false, sim.Ly);
+
+    //combine the wavenumbers with the constants in the update equations
+    dtt::gradientScale(dtt_type_x, sim.Nx, dx, -dt / rho0, sim.scale_dpdx);
+    dtt::gradientScale(dtt_type_y, sim.Ny, dy, -dt / rho0, sim.scale_dpdy);
+    dtt::gradientScale(velocityType(dtt_type_x), sim.Lx, dx, -dt * rho0 * c0 * c0, sim.scale_duxdx);
+    dtt::gradientScale(velocityType(dtt_type_y), sim.Ly, dy, -dt * rho0 * c0 * c0, sim.scale_duydy);
+
+    stats.mark(DTT_PHASE_VALIDATE);
+
+    //--------------------------------------------
+    // CREATE OUTPUTS
+    //--------------------------------------------
+
+    //copy the input fields to the outputs, which are updated in place
+    plhs[0] = mxDuplicateArray(prhs[0]);
+    mxArray *ux_mat = createVelocity(prhs[1], class_id, sim.Lx, sim.Ny, "Input for UX must be zero, or the same precision as P with size [Nx - 1, Ny] (WSWS), [Nx + 1, Ny] (WAWA), or [Nx, Ny] (other types).");
+    mxArray *uy_mat = createVelocity(prhs[2], class_id, sim.Nx, sim.Ly, "Input for UY must be zero, or the same precision as P with size [Nx, Ny - 1] (WSWS), [Nx, Ny + 1] (WAWA), or [Nx, Ny] (other types).");
+
+    //create snapshots of the pressure (not zero-filled as each snapshot
+    //is copied from the pressure field)
+    num_snapshots = (snapshot_freq > 0) ? Nt / snapshot_freq : 0;
+    mwSize snapshot_dims[3] = {(mwSize) sim.Nx, (mwSize) sim.Ny, (mwSize) num_snapshots};
+    mxArray *snapshot_mat = mxCreateUninitNumericArray(3, snapshot_dims, class_id, mxREAL);
+    stats.mark(DTT_PHASE_ALLOCATE);
+
+    //--------------------------------------------
+    // RUN SIMULATION
+    //--------------------------------------------
+
+    int threads = dtt::getThreads(options, (size_t) (sim.Nx * sim.Ny));
+    bool success;
+    if (class_id == mxSINGLE_CLASS){
+        success = runSimulation(sim, (float *) mxGetData(plhs[0]), (float *) mxGetData(ux_mat), (float *) mxGetData(uy_mat),
+                (float *) mxGetData(snapshot_mat), Nt, snapshot_freq, options, threads);
+    } else {
+        success = runSimulation(sim, (double *) mxGetData(plhs[0]), (double *) mxGetData(ux_mat), (double *) mxGetData(uy_mat),
+                (double *) mxGetData(snapshot_mat), Nt, snapshot_freq, options, threads);
+    }
+    if (!success){
+        mexErrMsgTxt("FFTW plan could not be created.");
+    }
+    stats.mark(DTT_PHASE_EXECUTE);
+
+    //the fields are read from the inputs and written to the outputs
+    stats.addBytes((double) (2 * (mxGetNumberOfElements(plhs[0]) + mxGetNumberOfElements(ux_mat) + mxGetNumberOfElements(uy_mat))
+            + mxGetNumberOfElements(snapshot_mat)) * mxGetElementSize(plhs[0]));
+
+    //assign the remaining outputs
+    if (nlhs > 1) plhs[1] = ux_mat; else mxDestroyArray(ux_mat);
+    if (nlhs > 2) plhs[2] = uy_mat; else mxDestroyArray(uy_mat);
+    if (nlhs > 3) plhs[3] = snapshot_mat; else mxDestroyArray(snapshot_mat);
+
+    stats.finish();
+
+    return;
+}
@@ -0,0 +1,109 @@
+function varargout = pstd2D(varargin)
+%PSTD2D Solve the 2D wave equation using a DTT-based PSTD method.
+%
+% DESCRIPTION:
+%     pstd2D solves the 2D wave equation (written as two coupled
+%     first-order equations) using a pseudospectral time domain (PSTD)
+%     method, where the spatial gradients are calculated using discrete
+%     trigonometric transforms (DTTs). The complete time loop is run in
+%     native code, giving the same results as the loops in
+%     example_wave_eq_pstd_2D_neumann and
+%     example_wave_eq_pstd_2D_dirichlet without creating any temporary
+%     arrays in MATLAB. Time integration is performed using a first-order
+%     accurate forward difference scheme, where each time step computes
+%
+%         ux = ux - dt / rho0 * dpdx
+%         uy = uy - dt / rho0 * dpdy
+%         p  = p  - dt * rho0 * c0^2 * (duxdx + duydy)
+%
+%     The boundary conditions are set by the DTT type of the pressure in
+%     each direction, for example, DCT-I (WSWS) for Neumann boundaries, or
+%     DST-I (WAWA) for Dirichlet boundaries. The pressure gradients are
+%     computed on a staggered grid shifted by + dx/2 (see gradientDtt with
+%     shift = 1 and align_output = false), and the particle velocity is
+%     stored on this grid. The DTT type of the particle velocity is given
+%     by the symmetry of the gradient, and the size of the velocity grid
+%     depends on the DTT type (e.g., Nx - 1 points in x for WSWS, Nx + 1
+%     for WAWA, and Nx for the other types).
+%
+%     Each gradient is computed using two cached FFTW plans, with the
+%     constants in the update equations combined with the wavenumbers, so
+%     the fields are updated in place by adding the output of each inverse
+%     transform.
+%
+%     For compilation instructions, see compileDttMex.
+%
+% USAGE:
+%     [p, ux, uy] = pstd2D(p, ux, uy, dtt_type, dx, dt, c0, rho0, Nt)
+%     [p, ux, uy, p_snapshots] = pstd2D(p, ux, uy, dtt_type, dx, dt, c0, rho0, Nt, snapshot_freq)
+%     [...] = pstd2D(..., 'Planner', 'measure')
+%
+% INPUTS:
+%     p             - Initial pressure distribution, given as a 2D array
+%                     in double or single precision.
+%     ux, uy        - Initial particle velocity in the x and y directions
+%                     on the staggered grid, in the same precision as p.
+%                     Set to 0 or [] to start with the particle velocity
+%                     at zero. Returned values can be used to continue a
+%                     simulation in a later call.
+%     dtt_type      - Type of discrete trigonometric transform used for
+%                     the pressure, given as a scalar, or as [x, y] to set
+%                     the type in each direction, where:
+%
+%                         1: DCT-I    WSWS
+%                         2: DCT-II   HSHS
+%                         3: DCT-III  WSWA
+%                         4: DCT-IV   HSHA
+%                         5: DST-I    WAWA
+%                         6: DST-II   HAHA
+%                         7: DST-III  WAWS
+%                         8: DST-IV   HAHS
+%
+%     dx            - Grid point spacing, given as a scalar, or as
+%                     [dx, dy] to set the spacing in each direction [m].
+%     dt            - Time step [s].
+%     c0            - Sound speed [m/s].
+%     rho0          - Density [kg/m^3].
+%     Nt            - Number of time steps.
+%
+% OPTIONAL INPUTS:
+%     snapshot_freq - Number of time steps between each snapshot of the
+%                     pressure field (default = 0, no snapshots).
+%
+%     Options used by the DTT functions (e.g., 'Planner' and 'Threads')
+%     can also be given as name/value pairs after the other inputs. The
+%     'InPlace', 'Inverse', and 'Strategy' options are not supported.
+%
+% OUTPUTS:
+%     p             - Pressure distribution after Nt time steps.
+%     ux, uy        - Particle velocity after Nt time steps.
+%     p_snapshots   - Snapshots of the pressure distribution, returned as
+%                     a 3D array of size [Nx, Ny, floor(Nt /
+%                     snapshot_freq)].
+%
+% ABOUT:
+%     author        - Bradley Treeby
+%     date          - 16 October 2026
+%     last update   - 16 October 2026
+%
+% Copyright (C) 2026 Bradley Treeby
+%
+% See also gradientDtt, dttOptions, example_wave_eq_pstd_2D_native
+
+% This program is free software: you can redistribute it and/or modify it
+% under the terms of the GNU General Public License as published by the
+% Free Software Foundation, either version 3 of the License, or (at your
+% option) any later version.
+%
+% This program is distributed in the hope that it will be useful, but
+% WITHOUT ANY WARRANTY; without even the implied warranty of
+% MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+% Public License for more details.
+%
+% You should have received a copy of the GNU General Public License along
+% with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+% call the function in the unified dttmex binary (if pstd2D has been
+% compiled as a separate mex function, the mex function is called
+% instead of this file, see compileDttMex)
+[varargout{1:nargout}] = dttmex('pstd2D', varargin{:});
@@ -0,0 +1,497 @@
+/**************************************************************************
+ * Tests for the DTT library.
+ *
+ * Checks the transforms computed by the C API (see dtt.h) against a
+ * brute-force evaluation of the FFTW definitions of each DTT type, for
+ * transforms along each dimension of several arrays (dtt_transform_dim)
+ * and along several combinations of dimensions (dtt_transform). Each case
+ * is repeated for every execution strategy, DTT type, forward and inverse
+ * transform, in-place and out-of-place, double and single precision, and
+ * one and several threads. Out-of-place transforms also check the input
+ * is not modified.
+ *
+ * The array sizes are chosen so every strategy is used for at least some
+ * of the cases, including the kernels in dttSmall.h (every length up to
+ * 64, as contiguous columns and as strided lines), the transpose path
+ * (transforms along dimensions other than the first), and the chirp path
+ * selected automatically for badly factored lengths (length 1009, see
+ * dttChirp.h), and include arrays large enough for the inverse to be
+ * computed in chunks (see dttInverse.h).
+ *
+ * Usage:
+ *
+ *     test_dtt [--strategy auto,strided,transpose,small,chirp,gemm]
+ *              [--precision double,single] [--verbose]
+ *
+ * By default, every strategy and precision is tested. The program prints
+ * one line for each failed case (or every case with --verbose) and a
+ * summary, and returns a non-zero exit code if any case fails. The tests
+ * are run by ctest for each strategy (see CMakeLists.txt).
+ *
+ * author: Bradley Treeby
+ * date: 16 October 2026
+ * last update: 16 October 2026
+ *
+ * Copyright (C) 2026 Bradley Treeby
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "dtt.h"
+
+//--------------------------------------------
+// SETTINGS
+//--------------------------------------------
+
+static const char *strategy_names[] = {"auto", "strided", "transpose", "small", "chirp", "gemm"};
+
+struct Settings {
+    std::vector<int> strategies;        // DTT_STRATEGY_* values
+    std::vector<bool> single;           // true for single precision
+    bool verbose;                       // print every case
+};
+
+//split a comma separated list
+static std::vector<std::string> split(const std::string &list){
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')){
+        if (!item.empty()){
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+static void usage(){
+    std::fprintf(stderr,
+        "usage: test_dtt [--strategy auto,strided,transpose,small,chirp,gemm]\n"
+        "                [--precision double,single] [--verbose]\n");
+}
+
+//parse the command line, returns false if the arguments are not valid
+static bool getSettings(int argc, char **argv, Settings &settings){
+    settings.strategies.clear();
+    settings.single.clear();
+    settings.verbose = false;
+    std::string strategies = "auto,strided,transpose,small,chirp,gemm";
+    std::string precisions = "double,single";
+    for (int i = 1; i < argc; i++){
+        std::string name = argv[i];
+        if (name == "--verbose"){
+            settings.verbose = true;
+        } else if (name == "--strategy" && i + 1 < argc){
+            strategies = argv[++i];
+        } else if (name == "--precision" && i + 1 < argc){
+            precisions = argv[++i];
+        } else {
+            return false;
+        }
+    }
+    std::vector<std::string> items = split(strategies);
+    for (size_t i = 0; i < items.size(); i++){
+        int strategy = -1;
+        for (int s = DTT_STRATEGY_AUTO; s <= DTT_STRATEGY_GEMM; s++){
+            if (items[i] == strategy_names[s]){
+                strategy = s;
+            }
+        }
+        if (strategy < 0){
+            return false;
+        }
+        settings.strategies.push_back(strategy);
+    }
+    items = split(precisions);
+    for (size_t i = 0; i < items.size(); i++){
+        if (items[i] != "double" && items[i] != "single"){
+            return false;
+        }
+        settings.single.push_back(items[i] == "single");
+    }
+    return !settings.strategies.empty() && !settings.single.empty();
+}
+
+//--------------------------------------------
+// REFERENCE
+//--------------------------------------------
+
+//inverse of each DTT type (DCT-II and DCT-III, and DST-II and DST-III,
+//are inverses of each other, and the other types are their own inverse)
+static int inverseType(int dtt_type){
+    switch (dtt_type) {
+        case 2: return 3;
+        case 3: return 2;
+        case 6: return 7;
+        case 7: return 6;
+        default: return dtt_type;
+    }
+}
+
+//logical length M of the transform, where applying a DTT and then its
+//inverse multiplies the input by M
+static double logicalLength(int dtt_type, ptrdiff_t n){
+    switch (dtt_type) {
+        case 1: return 2.0 * (double) (n - 1);
+        case 5: return 2.0 * (double) (n + 1);
+        default: return 2.0 * (double) n;
+    }
+}
+
+//matrix of the DTT of length n using the definitions in the FFTW manual
+//(unnormalised), where y[k] is the sum over j of a[k * n + j] * x[j]
+static std::vector<double> referenceMatrix(int dtt_type, ptrdiff_t n){
+    const double pi = 3.14159265358979323846;
+    std::vector<double> a(n * n);
+    for (ptrdiff_t k = 0; k < n; k++){
+        double sign = (k % 2 == 0) ? 1.0 : -1.0;
+        for (ptrdiff_t j = 0; j < n; j++){
+            double value = 0.0;
+            switch (dtt_type) {
+                case 1:
+                    value = (j == 0) ? 1.0 : (j == n - 1) ? sign : 2.0 * std::cos(pi * (double) (j * k) / (double) (n - 1));
+                    break;
+                case 2:
+                    value = 2.0 * std::cos(pi * (j + 0.5) * (double) k / (double) n);
+                    break;
+                case 3:
+                    value = (j == 0) ? 1.0 : 2.0 * std::cos(pi * (double) j * (k + 0.5) / (double) n);
+                    break;
+                case 4:
+                    value = 2.0 * std::cos(pi * (j + 0.5) * (k + 0.5) / (double) n);
+                    break;
+                case 5:
+                    value = 2.0 * std::sin(pi * (double) ((j + 1) * (k + 1)) / (double) (n + 1));
+                    break;
+                case 6:
+                    value = 2.0 * std::sin(pi * (j + 0.5) * (double) (k + 1) / (double) n);
+                    break;
+                case 7:
+                    value = (j == n - 1) ? sign : 2.0 * std::sin(pi * (double) (j + 1) * (k + 0.5) / (double) n);
+                    break;
+                case 8:
+                    value = 2.0 * std::sin(pi * (j + 0.5) * (k + 0.5) / (double) n);
+                    break;
+            }
+            a[k * n + j] = value;
+        }
+    }
+    return a;
+}
+
+//transform the array x of size sz along dimension dim in place, where
+//the inverse is the inverse type scaled by 1/M
+static void referenceAxis(std::vector<double> &x, const std::vector<ptrdiff_t> &sz, int dim, int dtt_type, bool inverse){
+    ptrdiff_t pre = 1, post = 1, n = sz[dim];
+    for (int i = 0; i < (int) sz.size(); i++){
+        if (i < dim){
+            pre *= sz[i];
+        } else if (i > dim){
+            post *= sz[i];
+        }
+    }
+    std::vector<double> a = referenceMatrix(inverse ? inverseType(dtt_type) : dtt_type, n);
+    double scale = inverse ? 1.0 / logicalLength(dtt_type, n) : 1.0;
+    std::vector<double> line(n);
+    for (ptrdiff_t o = 0; o < post; o++){
+        for (ptrdiff_t p = 0; p < pre; p++){
+            double *data = &x[p + o * pre * n];
+            for (ptrdiff_t j = 0; j < n; j++){
+                line[j] = data[j * pre];
+            }
+            for (ptrdiff_t k = 0; k < n; k++){
+                double sum = 0.0;
+                for (ptrdiff_t j = 0; j < n; j++){
+                    sum += a[k * n + j] * line[j];
+                }
+                data[k * pre] = scale * sum;
+            }
+        }
+    }
+}
+
+//--------------------------------------------
+// CASES
+//--------------------------------------------
+
+//transform computed by one case, where dim >= 0 is a transform along a
+//single dimension (dtt_transform_dim), and otherwise types gives the DTT
+//type for each dimension (dtt_transform)
+struct Case {
+    std::vector<ptrdiff_t> sz;
+    int dim;
+    std::vector<int> types;
+    bool inverse;
+};
+
+struct Counts {
+    int run;
+    int failed;
+};
+
+static ptrdiff_t numElements(const std::vector<ptrdiff_t> &sz){
+    ptrdiff_t numel = 1;
+    for (size_t i = 0; i < sz.size(); i++){
+        numel *= sz[i];
+    }
+    return numel;
+}
+
+static std::string describeCase(const Case &c){
+    std::stringstream s;
+    for (size_t i = 0; i < c.sz.size(); i++){
+        s << (i > 0 ? "x" : "") << c.sz[i];
+    }
+    if (c.dim >= 0){
+        s << " dim " << c.dim << " type " << c.types[c.dim];
+    } else {
+        s << " types ";
+        for (size_t i = 0; i < c.types.size(); i++){
+            s << c.types[i];
+        }
+    }
+    s << (c.inverse ? " inverse" : " forward");
+    return s.str();
+}
+
+//reproducible input values in [-1, 1], which are exact in single
+//precision so both precisions transform the same array
+static std::vector<double> testInput(ptrdiff_t numel){
+    std::vector<double> x(numel);
+    unsigned long long state = 12345;
+    for (ptrdiff_t i = 0; i < numel; i++){
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        x[i] = (double) (float) ((double) (state >> 11) / 9007199254740992.0 * 2.0 - 1.0);
+    }
+    return x;
+}
+
+static int callTransform(const Case &c, const double *in, double *out, const dtt_options *opts){
+    if (c.dim >= 0){
+        return dtt_transform_dim(in, out, (int) c.sz.size(), &c.sz[0], c.dim, c.types[c.dim], opts);
+    }
+    return dtt_transform(in, out, (int) c.sz.size(), &c.sz[0], &c.types[0], opts);
+}
+
+static int callTransform(const Case &c, const float *in, float *out, const dtt_options *opts){
+    if (c.dim >= 0){
+        return dtt_transform_dim_f(in, out, (int) c.sz.size(), &c.sz[0], c.dim, c.types[c.dim], opts);
+    }
+    return dtt_transform_f(in, out, (int) c.sz.size(), &c.sz[0], &c.types[0], opts);
+}
+
+//run one case in the precision T, returns the error relative to the
+//largest value of the reference, or a negative value if the call fails
+//or an out-of-place call modifies the input
+template <typename T>
+static double runCase(const Case &c, const std::vector<double> &x, const std::vector<double> &reference,
+        const dtt_options &opts, bool in_place){
+    ptrdiff_t numel = (ptrdiff_t) x.size();
+    std::vector<T> in(numel), out(numel, (T) 0);
+    for (ptrdiff_t i = 0; i < numel; i++){
+        in[i] = (T) x[i];
+    }
+    int status;
+    if (in_place){
+        out = in;
+        status = callTransform(c, &out[0], &out[0], &opts);
+    } else {
+        status = callTransform(c, &in[0], &out[0], &opts);
+        for (ptrdiff_t i = 0; i < numel && status == DTT_SUCCESS; i++){
+            if (in[i] != (T) x[i]){
+                return -2.0;
+            }
+        }
+    }
+    if (status != DTT_SUCCESS){
+        return -1.0;
+    }
+    double max_error = 0.0, max_value = 0.0;
+    for (ptrdiff_t i = 0; i < numel; i++){
+        double error = std::fabs((double) out[i] - reference[i]);
+        if (!(error <= max_error)){
+            max_error = error;
+        }
+        max_value = std::max(max_value, std::fabs(reference[i]));
+    }
+    return max_error / (max_value > 0.0 ? max_value : 1.0);
+}
+
+//run a case for each strategy, precision, number of threads, and
+//in-place setting
+static void runCases(const Case &c, const Settings &settings, Counts &counts){
+
+    //the reference is computed one dimension at a time
+    std::vector<double> x = testInput(numElements(c.sz));
+    std::vector<double> reference(x);
+    for (int i = 0; i < (int) c.sz.size(); i++){
+        if ((c.dim < 0 || c.dim == i) && c.types[i] != 0){
+            referenceAxis(reference, c.sz, i, c.types[i], c.inverse);
+        }
+    }
+
+    static const int threads[] = {1, 3};
+    for (size_t s = 0; s < settings.strategies.size(); s++){
+        for (size_t p = 0; p < settings.single.size(); p++){
+            for (int th = 0; th < 2; th++){
+                for (int in_place = 0; in_place < 2; in_place++){
+                    dtt_options opts;
+                    dtt_default_options(&opts);
+                    opts.strategy = settings.strategies[s];
+                    opts.threads = threads[th];
+                    opts.inverse = c.inverse ? 1 : 0;
+                    bool single = settings.single[p];
+                    double error = single ? runCase<float>(c, x, reference, opts, in_place != 0)
+                            : runCase<double>(c, x, reference, opts, in_place != 0);
+                    double tolerance = single ? 1e-5 : 1e-11;
+                    bool failed = !(error >= 0.0 && error <= tolerance);
+                    counts.run++;
+                    counts.failed += failed ? 1 : 0;
+                    if (failed || settings.verbose){
+                        char result[64];
+                        if (error == -1.0){
+                            std::snprintf(result, sizeof(result), "call failed");
+                        } else if (error == -2.0){
+                            std::snprintf(result, sizeof(result), "input modified");
+                        } else {
+                            std::snprintf(result, sizeof(result), "error %.3g", error);
+                        }
+                        std::printf("%s %s: %s %s %s threads %d %s (%s)\n", failed ? "FAIL" : "ok",
+                                c.dim >= 0 ? "dtt_transform_dim" : "dtt_transform", describeCase(c).c_str(),
+                                strategy_names[opts.strategy], single ? "single" : "double", opts.threads,
+                                in_place ? "in place" : "out of place", result);
+                    }
+                }
+            }
+        }
+    }
+}
+
+//--------------------------------------------
+// MAIN
+//--------------------------------------------
+
+int main(int argc, char **argv){
+
+    Settings settings;
+    if (!getSettings(argc, argv, settings)){
+        usage();
+        return 1;
+    }
+    Counts counts = {0, 0};
+
+    //transforms along each dimension, where the short lengths use the
+    //small kernels and GEMM path, length 1009 uses the chirp path (except
+    //for DCT-I and DST-I, where the logical length is smooth), and length
+    //1100 is too long for the GEMM path when it is selected
+    static const ptrdiff_t dim_shapes[][3] = {
+        {37, 1, 1}, {64, 9, 1}, {9, 64, 1}, {6, 7, 5}, {16, 33, 24}, {1009, 3, 1}, {3, 1009, 1}, {1100, 2, 1}};
+    for (size_t s = 0; s < sizeof(dim_shapes) / sizeof(dim_shapes[0]); s++){
+        Case c;
+        for (int i = 0; i < 3 && dim_shapes[s][i] > 1; i++){
+            c.sz.push_back(dim_shapes[s][i]);
+        }
+        for (c.dim = 0; c.dim < (int) c.sz.size(); c.dim++){
+            for (int type = 1; type <= 8; type++){
+                c.types.assign(c.sz.size(), 0);
+                c.types[c.dim] = type;
+                for (int inverse = 0; inverse < 2; inverse++){
+                    c.inverse = (inverse != 0);
+                    runCases(c, settings, counts);
+                }
+            }
+        }
+    }
+
+    //every length with a kernel in dttSmall.h, as contiguous columns and
+    //as strided lines
+    for (ptrdiff_t n = 2; n <= 64; n++){
+        for (int layout = 0; layout < 2; layout++){
+            Case c;
+            c.sz.push_back(layout == 0 ? n : 3);
+            c.sz.push_back(layout == 0 ? 5 : n);
+            c.dim = layout;
+            for (int type = 1; type <= 8; type++){
+                c.types.assign(2, 0);
+                c.types[c.dim] = type;
+                for (int inverse = 0; inverse < 2; inverse++){
+                    c.inverse = (inverse != 0);
+                    runCases(c, settings, counts);
+                }
+            }
+        }
+    }
+
+    //batches of 4096 short transforms, which the auto strategy computes
+    //using the GEMM path
+    static const ptrdiff_t batch_shapes[][3] = {{40, 4096, 1}, {64, 40, 64}};
+    for (size_t s = 0; s < sizeof(batch_shapes) / sizeof(batch_shapes[0]); s++){
+        Case c;
+        for (int i = 0; i < 3 && batch_shapes[s][i] > 1; i++){
+            c.sz.push_back(batch_shapes[s][i]);
+        }
+        c.dim = (int) s;
+        for (int type = 1; type <= 8; type++){
+            c.types.assign(c.sz.size(), 0);
+            c.types[c.dim] = type;
+            for (int inverse = 0; inverse < 2; inverse++){
+                c.inverse = (inverse != 0);
+                runCases(c, settings, counts);
+            }
+        }
+    }
+
+    //transforms along several dimensions, where each transformed
+    //dimension uses a different DTT type, and the dimensions given by
+    //each mask are transformed (the largest array is inverted in chunks)
+    static const ptrdiff_t all_shapes[][4] = {
+        {6, 5, 4, 1}, {64, 40, 30, 1}, {3, 4, 5, 6}, {1009, 3, 1, 1}};
+    static const int masks[] = {1, 2, 4, 8, 3, 5, 6, 9, 7, 15};
+    for (size_t s = 0; s < sizeof(all_shapes) / sizeof(all_shapes[0]); s++){
+        Case c;
+        c.dim = -1;
+        for (int i = 0; i < 4 && all_shapes[s][i] > 1; i++){
+            c.sz.push_back(all_shapes[s][i]);
+        }
+        int numdims = (int) c.sz.size();
+        for (size_t m = 0; m < sizeof(masks) / sizeof(masks[0]); m++){
+            if (masks[m] >= (1 << numdims)){
+                continue;
+            }
+            for (int type = 1; type <= 8; type++){
+                c.types.assign(numdims, 0);
+                for (int i = 0; i < numdims; i++){
+                    if (masks[m] & (1 << i)){
+                        c.types[i] = (type - 1 + i) % 8 + 1;
+                    }
+                }
+                for (int inverse = 0; inverse < 2; inverse++){
+                    c.inverse = (inverse != 0);
+                    runCases(c, settings, counts);
+                }
+            }
+        }
+    }
+
+    dtt_cleanup();
+    std::printf("%d of %d cases failed\n", counts.failed, counts.run);
+    return counts.failed > 0 ? 1 : 0;
+}